@@ -0,0 +1,57 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Data sets shared by the benchmarks.
+//
+#ifndef ___BENCH_BLOBS___
+#define ___BENCH_BLOBS___
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Gaussian blobs around one random center per class, written as a .dat file. The centers
+// only depend on the number of inputs and classes, so data sets with different seeds share
+// them and can be used for training and validation.
+inline string blobs(const string &path, const unsigned int &inputs, const unsigned int &classes,
+                    const unsigned int &samples, const unsigned int &seed,
+                    const double &noise) {
+  FILE *file = fopen( path.c_str(), "w" );
+  mt19937 generator( seed );
+  mt19937 centers_generator( 1 );
+  normal_distribution<double> spread( 0.0, noise );
+  uniform_real_distribution<double> place( -1.0, 1.0 );
+
+  vector<vector<double>> centers( classes, vector<double>( inputs ) );
+  for( auto &center : centers ) {
+    for( auto &value : center ) value = place( centers_generator );
+  }
+
+  fprintf( file, "%u %u %u\n", inputs, classes, samples );
+  for(unsigned int s = 0; s < samples; s++) {
+    unsigned int c = s % classes;
+    for(unsigned int i = 0; i < inputs; i++) fprintf( file, "%f ", centers[c][i] + spread( generator ) );
+    for(unsigned int k = 0; k < classes; k++) fprintf( file, "%d%c", k == c, k + 1 < classes ? ' ' : '\n' );
+  }
+
+  fclose( file );
+  return path;
+}
+#endif
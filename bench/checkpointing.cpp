@@ -0,0 +1,85 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Arena size and training time of a deep and wide network for several checkpoint distances.
+// The gradients are the same for all of them.
+//
+//    bin/checkpointing_bench [hidden layers] [layer size] [batch size]
+//
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "network.h"
+#include "initializer.h"
+
+using namespace mp;
+using namespace std;
+
+static const unsigned int inputs = 64;
+static const unsigned int outputs = 8;
+static const unsigned int batches = 20;
+
+int main(int argc, char **argv) {
+  unsigned int hidden = argc > 1 ? atoi( argv[1] ) : 32;
+  unsigned int width = argc > 2 ? atoi( argv[2] ) : 256;
+  unsigned int batch = argc > 3 ? atoi( argv[3] ) : 256;
+
+  mt19937 generator( 1 );
+  normal_distribution<double> noise( 0.0, 1.0 );
+  vector<vector<double>> samples( batch, vector<double>( inputs ) );
+  vector<vector<double>> targets( batch, vector<double>( outputs, 0.0 ) );
+  vector<const vector<double> *> batch_inputs, batch_expected;
+
+  for(unsigned int s = 0; s < batch; s++) {
+    for( auto &value : samples[s] ) value = noise( generator );
+    targets[s][s % outputs] = 1.0;
+    batch_inputs.push_back( &samples[s] );
+    batch_expected.push_back( &targets[s] );
+  }
+
+  printf( "%u hidden layers of %u neurons, batches of %u samples\n\n", hidden, width, batch );
+  printf( "%10s %12s %12s %12s\n", "checkpoint", "arena MiB", "batch ms", "slowdown" );
+
+  double reference = 0.0;
+  for( unsigned int every : { 1, 2, 4, 8, 16 } ) {
+    network net(hidden, width, outputs);
+    net.feed( vector<double>( inputs, 0.0 ) );
+    for(unsigned int i = 0; i + 1 < net.layers(); i++) net.activation( i, activation_kind::relu );
+    net.output_stage( stage::softmax );
+    initializer( scheme::he, 5 ).initialize( net );
+    net.optimizer( make_shared<optimizer::sgd>( 0.01, 0.9 ) );
+
+    net.checkpoint( every );
+    net.compile( inputs, batch );
+    net.backpropagate( batch_inputs, batch_expected );
+
+    auto start = chrono::steady_clock::now();
+    for(unsigned int b = 0; b < batches; b++) net.backpropagate( batch_inputs, batch_expected );
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    double seconds = elapsed.count() / batches;
+    if( every == 1 ) reference = seconds;
+
+    printf( "%10u %12.2f %12.2f %11.2fx\n", every, net.memory() / 1048576.0, seconds * 1e3,
+            seconds / reference );
+  }
+
+  return 0;
+}
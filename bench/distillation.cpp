@@ -0,0 +1,104 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Accuracy and latency of a big teacher network and of a small student distilled from it,
+// next to the same small network trained on the hard targets only.
+//
+//    bin/distillation_bench [student hidden size] [hard weight] [temperature]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "distillation.h"
+#include "initializer.h"
+#include "blobs.h"
+
+using namespace mp;
+using namespace std;
+
+static const unsigned int inputs = 64;
+static const unsigned int classes = 4;
+static const unsigned int samples = 2000;
+
+static void prepare(network &net, const unsigned int &seed) {
+  net.feed( vector<double>( inputs, 0.0 ) );
+  for(unsigned int i = 0; i + 1 < net.layers(); i++) net.activation( i, activation_kind::relu );
+  net.output_stage( stage::softmax );
+
+  initializer init( scheme::he, seed );
+  init.biases( true );
+  init.initialize( net );
+  net.optimizer( make_shared<optimizer::sgd>( 0.01, 0.9 ) );
+}
+
+static void row(const char *name, const network &net, const metrics &m,
+                const unsigned long long &parameters, const double &latency) {
+  string sizes = to_string( net.layer_inputs( 0 ) );
+  for(unsigned int i = 0; i < net.layers(); i++) sizes += "-" + to_string( net.layer_size( i ) );
+
+  printf( "%-8s %16s %10llu %9.4f %9.4f %12.2f\n", name, sizes.c_str(), parameters, m.accuracy,
+          m.cross_entropy, latency * 1e6 );
+}
+
+int main(int argc, char **argv) {
+  unsigned int hidden = argc > 1 ? atoi( argv[1] ) : 16;
+  double hard_weight = argc > 2 ? atof( argv[2] ) : 0.5;
+  double temperature = argc > 3 ? atof( argv[3] ) : 2.0;
+
+  string base = "/tmp/distillation_bench_" + to_string( getpid() );
+  string training_path = blobs( base + "_2.dat", inputs, classes, samples, 2, 2.0 );
+  string validation_path = blobs( base + "_3.dat", inputs, classes, samples, 3, 2.0 );
+  data training, validation;
+  training.reload( training_path );
+  validation.reload( validation_path );
+  remove( training_path.c_str() );
+  remove( validation_path.c_str() );
+
+  network teacher(2, 256, classes);
+  prepare( teacher, 5 );
+
+  trainer t;
+  t.epochs( 10 );
+  t.train( teacher, training, validation );
+
+  // The same small network trained on the hard targets only, for reference
+  network alone(1, hidden, classes);
+  prepare( alone, 6 );
+  t.train( alone, training, validation );
+
+  network student(1, hidden, classes);
+  prepare( student, 6 );
+
+  distiller d( hard_weight, temperature );
+  auto report = d.distill( teacher, student, t, training, validation );
+
+  printf( "hard weight %.2f, temperature %.2f\n\n", hard_weight, temperature );
+  printf( "%-8s %16s %10s %9s %9s %12s\n", "network", "topology", "parameters", "accuracy",
+          "entropy", "latency us" );
+  row( "teacher", teacher, report.teacher, report.teacher_parameters, report.teacher_latency );
+  row( "student", student, report.student, report.student_parameters, report.student_latency );
+  // Same topology as the student, so the same latency
+  row( "alone", alone, evaluator().evaluate( alone, validation ), alone.weights().size(),
+       report.student_latency );
+  printf( "\nstudent speedup %.2fx\n", report.speedup );
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Accuracy and evaluation time of a trained network whose layers are replaced with their
+// low-rank factors, for several energy thresholds. A rank of 0 means the layer was kept.
+//
+//    bin/factorization_bench [fine tuning epochs] [hidden size]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "factorization.h"
+#include "initializer.h"
+#include "blobs.h"
+
+using namespace mp;
+using namespace std;
+
+static const unsigned int inputs = 64;
+static const unsigned int classes = 4;
+static const unsigned int samples = 2000;
+
+int main(int argc, char **argv) {
+  unsigned int epochs = argc > 1 ? atoi( argv[1] ) : 2;
+  unsigned int hidden = argc > 2 ? atoi( argv[2] ) : 256;
+
+  string base = "/tmp/factorization_bench_" + to_string( getpid() );
+  string training_path = blobs( base + "_2.dat", inputs, classes, samples, 2, 2.0 );
+  string validation_path = blobs( base + "_3.dat", inputs, classes, samples, 3, 2.0 );
+  data training, validation;
+  training.reload( training_path );
+  validation.reload( validation_path );
+  remove( training_path.c_str() );
+  remove( validation_path.c_str() );
+
+  network net(2, hidden, classes);
+  net.feed( vector<double>( inputs, 0.0 ) );
+  net.activation( 0, activation_kind::relu );
+  net.activation( 1, activation_kind::relu );
+  net.output_stage( stage::softmax );
+  initializer init( scheme::he, 5 );
+  init.biases( true );
+  init.initialize( net );
+  net.optimizer( make_shared<optimizer::sgd>( 0.01, 0.9 ) );
+
+  trainer t;
+  t.epochs( 10 );
+  t.train( net, training, validation );
+
+  factorizer f;
+  f.fine_tuning( epochs, t );
+  auto report = f.compare( net, { 0.5, 0.7, 0.8, 0.9, 0.95, 0.99 }, training, validation );
+
+  printf( "%u-%u-%u-%u network, %llu multiply-adds, accuracy %.4f, %u fine tuning epochs\n\n",
+          inputs, hidden, hidden, classes, report.operations, report.accuracy, epochs );
+  printf( "%7s %16s %10s %10s %9s %8s %10s %8s\n", "energy", "ranks", "operations",
+          "parameters", "accuracy", "change", "seconds", "speedup" );
+
+  for( auto &level : report.levels ) {
+    string ranks = to_string( level.ranks[0] );
+    for(unsigned int i = 1; i < level.ranks.size(); i++) ranks += "/" + to_string( level.ranks[i] );
+
+    printf( "%7.2f %16s %10llu %10llu %9.4f %+8.4f %10.4f %7.2fx\n", level.energy,
+            ranks.c_str(), level.operations, level.parameters, level.accuracy,
+            level.accuracy_change, level.seconds, level.speedup );
+  }
+
+  return 0;
+}
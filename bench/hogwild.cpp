@@ -0,0 +1,144 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Time to accuracy of the asynchronous (hogwild) training against the synchronous
+// data-parallel training, both with the same number of threads.
+//
+//    bin/hogwild_bench [threads] [samples]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <unistd.h>
+#include "hogwild.h"
+#include "distributed.h"
+#include "evaluation.h"
+#include "initializer.h"
+#include "blobs.h"
+
+using namespace mp;
+using namespace std;
+
+static const unsigned int inputs = 16;
+static const unsigned int classes = 4;
+static const unsigned int max_epochs = 40;
+static const double target = 0.85;
+
+static void prepare(network &net) {
+  net.feed( vector<double>( inputs, 0.0 ) );
+  net.activation( 0, activation_kind::relu );
+
+  initializer init( scheme::he, 5 );
+  init.biases( true );
+  init.initialize( net );
+}
+
+// It trains epoch by epoch until the accuracy reaches the target, and prints the result
+static void report(const char *name, const function<void(network &)> &epoch, const data &dat) {
+  network net(1, 32, classes);
+  prepare( net );
+
+  evaluator check;
+  double seconds = 0.0, accuracy = 0.0;
+  unsigned int epochs = 0;
+
+  while(( accuracy < target ) && ( epochs < max_epochs )) {
+    auto start = chrono::steady_clock::now();
+    epoch( net );
+    seconds += chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+
+    epochs++;
+    accuracy = check.evaluate( net, dat ).accuracy;
+  }
+
+  printf( "%-14s %8u %10.4f %12.3f\n", name, epochs, accuracy, seconds );
+}
+
+int main(int argc, char **argv) {
+  unsigned int threads = argc > 1 ? atoi( argv[1] ) : thread::hardware_concurrency();
+  unsigned int samples = argc > 2 ? atoi( argv[2] ) : 20000;
+  threads = threads > 0 ? threads : 1;
+
+  auto path = blobs( "/tmp/hogwild_bench_" + to_string( getpid() ) + ".dat", inputs, classes,
+                     samples, 1, 1.0 );
+  data dat( path );
+  unlink( path.c_str() );
+
+  printf( "%u samples, %u inputs, %u classes, %u threads, target accuracy %.2f\n",
+          samples, inputs, classes, threads, target );
+  printf( "%-14s %8s %10s %12s\n", "mode", "epochs", "accuracy", "seconds" );
+
+  hogwild asynchronous( threads, 0.01 );
+  report( "hogwild", [&](network &net) { asynchronous.train( net, dat, 1 ); }, dat );
+
+  asynchronous.sparse( false );
+  report( "hogwild dense", [&](network &net) { asynchronous.train( net, dat, 1 ); }, dat );
+
+  // The synchronous path: one data-parallel worker per thread, over TCP on localhost. Each
+  // worker averages batches of 8 samples, so the learning rate is 8 times bigger.
+  unsigned short port = 30000 + getpid() % 1000 * 32;
+  network net(1, 32, classes);
+  prepare( net );
+
+  vector<network> replicas;
+  replicas.reserve( threads );
+  for(unsigned int r = 0; r < threads; r++) {
+    replicas.push_back( net.replica() );
+    replicas[r].optimizer( make_shared<optimizer::sgd>( 0.08, 0.0 ) );
+  }
+
+  double seconds = 0.0, accuracy = 0.0;
+  unsigned int epochs = 0;
+
+  vector<thread> workers;
+  for(unsigned int r = 0; r < threads; r++) {
+    workers.emplace_back( [&, r] {
+      transport::tcp link( r, threads, port );
+      data_parallel worker( link );
+      worker.batch_size( 8 );
+
+      // Rank 0 decides when to stop, and the decision is shared with an allreduce
+      vector<double> running( 1, 1.0 );
+      while( running[0] > 0.0 ) {
+        auto start = chrono::steady_clock::now();
+        worker.train( replicas[r], dat, 1 );
+
+        if( r == 0 ) {
+          seconds += chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+          epochs++;
+          accuracy = evaluator().evaluate( replicas[0], dat ).accuracy;
+          running[0] = ( accuracy < target ) && ( epochs < max_epochs );
+        }
+        else running[0] = 0.0;
+
+        data_parallel::allreduce( link, running );
+      }
+    } );
+  }
+
+  for( auto &w : workers ) w.join();
+  printf( "%-14s %8u %10.4f %12.3f\n", "synchronous", epochs, accuracy, seconds );
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Mini-batch training time of a deep network split in pipeline stages, next to the plain
+// backpropagation. All of them reach the same weights.
+//
+//    bin/pipeline_bench [hidden layers] [layer size] [micro-batch size]
+//
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "network.h"
+#include "initializer.h"
+
+using namespace mp;
+using namespace std;
+
+static const unsigned int inputs = 64;
+static const unsigned int outputs = 8;
+static const unsigned int batch = 256;
+static const unsigned int batches = 10;
+
+static void prepare(network &net) {
+  net.feed( vector<double>( inputs, 0.0 ) );
+  for(unsigned int i = 0; i + 1 < net.layers(); i++) net.activation( i, activation_kind::relu );
+  net.output_stage( stage::softmax );
+  initializer( scheme::he, 5 ).initialize( net );
+  net.optimizer( make_shared<optimizer::sgd>( 0.01, 0.9 ) );
+  net.compile( inputs, batch );
+}
+
+int main(int argc, char **argv) {
+  unsigned int hidden = argc > 1 ? atoi( argv[1] ) : 16;
+  unsigned int width = argc > 2 ? atoi( argv[2] ) : 512;
+  unsigned int micro_batch = argc > 3 ? atoi( argv[3] ) : 16;
+
+  mt19937 generator( 1 );
+  normal_distribution<double> noise( 0.0, 1.0 );
+  vector<vector<double>> samples( batch, vector<double>( inputs ) );
+  vector<vector<double>> targets( batch, vector<double>( outputs, 0.0 ) );
+  vector<const vector<double> *> batch_inputs, batch_expected;
+
+  for(unsigned int s = 0; s < batch; s++) {
+    for( auto &value : samples[s] ) value = noise( generator );
+    targets[s][s % outputs] = 1.0;
+    batch_inputs.push_back( &samples[s] );
+    batch_expected.push_back( &targets[s] );
+  }
+
+  network reference(hidden, width, outputs);
+  prepare( reference );
+
+  auto start = chrono::steady_clock::now();
+  for(unsigned int b = 0; b < batches; b++) reference.backpropagate( batch_inputs, batch_expected );
+  chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+  double sequential = elapsed.count() / batches;
+
+  printf( "%u hidden layers of %u neurons, batches of %u, micro-batches of %u\n\n", hidden, width,
+          batch, micro_batch );
+  printf( "%8s %12s %10s %10s\n", "stages", "batch ms", "speedup", "same" );
+  printf( "%8s %12.2f %9.2fx %10s\n", "plain", sequential * 1e3, 1.0, "-" );
+
+  for( unsigned int stages : { 1, 2, 4, 8 } ) {
+    if( stages > thread::hardware_concurrency() ) break;
+
+    network net(hidden, width, outputs);
+    prepare( net );
+
+    start = chrono::steady_clock::now();
+    for(unsigned int b = 0; b < batches; b++) {
+      net.backpropagate_pipelined( batch_inputs, batch_expected, stages, micro_batch );
+    }
+    elapsed = chrono::steady_clock::now() - start;
+
+    double seconds = elapsed.count() / batches;
+    printf( "%8u %12.2f %9.2fx %10s\n", stages, seconds * 1e3, sequential / seconds,
+            net.weights() == reference.weights() ? "yes" : "no" );
+  }
+
+  return 0;
+}
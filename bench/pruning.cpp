@@ -0,0 +1,101 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Accuracy and prediction time of a trained network pruned to several sparsity levels,
+// running on the compressed sparse rows of mp::sparse_network, and compacted removing
+// several fractions of its hidden neurons.
+//
+//    bin/pruning_bench [fine tuning epochs] [hidden size]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "pruning.h"
+#include "initializer.h"
+#include "blobs.h"
+
+using namespace mp;
+using namespace std;
+
+static const unsigned int inputs = 64;
+static const unsigned int classes = 4;
+static const unsigned int samples = 2000;
+
+int main(int argc, char **argv) {
+  unsigned int epochs = argc > 1 ? atoi( argv[1] ) : 0;
+  unsigned int hidden = argc > 2 ? atoi( argv[2] ) : 256;
+
+  string base = "/tmp/pruning_bench_" + to_string( getpid() );
+  string training_path = blobs( base + "_2.dat", inputs, classes, samples, 2, 2.0 );
+  string validation_path = blobs( base + "_3.dat", inputs, classes, samples, 3, 2.0 );
+  data training, validation;
+  training.reload( training_path );
+  validation.reload( validation_path );
+  remove( training_path.c_str() );
+  remove( validation_path.c_str() );
+
+  network net(2, hidden, classes);
+  net.feed( vector<double>( inputs, 0.0 ) );
+  net.activation( 0, activation_kind::relu );
+  net.activation( 1, activation_kind::relu );
+  net.output_stage( stage::softmax );
+  initializer init( scheme::he, 5 );
+  init.biases( true );
+  init.initialize( net );
+  net.optimizer( make_shared<optimizer::sgd>( 0.01, 0.9 ) );
+
+  trainer t;
+  t.epochs( 10 );
+  t.train( net, training, validation );
+
+  pruner p;
+  p.fine_tuning( epochs, t );
+  auto report = ( epochs > 0 ) ? p.sweep( net, { 0.0, 0.5, 0.75, 0.9, 0.95, 0.98 }, training,
+                                          validation )
+                               : p.sweep( net, { 0.0, 0.5, 0.75, 0.9, 0.95, 0.98 }, validation );
+
+  printf( "%u-%u-%u-%u network, %llu factors, accuracy %.4f, %u fine tuning epochs\n\n", inputs,
+          hidden, hidden, classes, report.factors, report.accuracy, epochs );
+  printf( "%9s %10s %9s %8s %10s %10s %8s\n", "sparsity", "nonzeros", "accuracy", "change",
+          "dense s", "sparse s", "speedup" );
+
+  for( auto &level : report.levels ) {
+    printf( "%9.3f %10llu %9.4f %+8.4f %10.4f %10.4f %7.2fx\n", level.sparsity, level.nonzeros,
+            level.accuracy, level.accuracy_change, level.dense_seconds, level.sparse_seconds,
+            level.speedup );
+  }
+
+  auto compaction = p.compact( net, { 0.0, 0.25, 0.5, 0.75, 0.9 }, training, validation );
+
+  printf( "\n%9s %12s %10s %9s %8s %10s %8s\n", "removed", "sizes", "parameters", "accuracy",
+          "change", "seconds", "speedup" );
+
+  for( auto &level : compaction.levels ) {
+    string sizes = to_string( level.sizes[0] );
+    for(unsigned int i = 1; i < level.sizes.size(); i++) sizes += "-" + to_string( level.sizes[i] );
+
+    printf( "%9.2f %12s %10llu %9.4f %+8.4f %10.4f %7.2fx\n", level.fraction, sizes.c_str(),
+            level.parameters, level.accuracy, level.accuracy_change, level.seconds,
+            level.speedup );
+  }
+
+  return 0;
+}
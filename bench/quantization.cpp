@@ -0,0 +1,98 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Accuracy, output error and evaluation time of a wide network with its factors stored in
+// double, bfloat16 and IEEE half, trained in double and trained with each storage.
+//
+//    bin/quantization_bench [hidden size] [epochs]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "quantization.h"
+#include "initializer.h"
+#include "blobs.h"
+
+using namespace mp;
+using namespace std;
+
+static const unsigned int inputs = 256;
+static const unsigned int classes = 4;
+static const unsigned int samples = 1000;
+
+static const char* name(const storage &format) {
+  switch( format ) {
+    case storage::bfloat16: return "bfloat16";
+    case storage::half: return "half";
+    default: return "double";
+  }
+}
+
+static void print(const char *title, const quantization_report &report) {
+  printf( "%s\n", title );
+  printf( "%-9s %10s %9s %9s %11s %11s %10s %8s\n", "storage", "KiB", "accuracy", "change",
+          "max error", "mean error", "seconds", "speedup" );
+  printf( "%-9s %10.1f %9.4f %9s %11s %11s %10.4f %8s\n", "double", report.bytes / 1024.0,
+          report.accuracy, "-", "-", "-", report.seconds, "-" );
+
+  for( auto &level : report.levels ) {
+    printf( "%-9s %10.1f %9.4f %+9.4f %11.2e %11.2e %10.4f %7.2fx\n", name( level.format ),
+            level.bytes / 1024.0, level.accuracy, level.accuracy_change, level.max_error,
+            level.mean_error, level.seconds, level.speedup );
+  }
+
+  printf( "\n" );
+}
+
+int main(int argc, char **argv) {
+  unsigned int hidden = argc > 1 ? atoi( argv[1] ) : 1024;
+  unsigned int epochs = argc > 2 ? atoi( argv[2] ) : 2;
+
+  string base = "/tmp/quantization_bench_" + to_string( getpid() );
+  string training_path = blobs( base + "_2.dat", inputs, classes, samples, 2, 4.0 );
+  string validation_path = blobs( base + "_3.dat", inputs, classes, samples, 3, 4.0 );
+  data training, validation;
+  training.reload( training_path );
+  validation.reload( validation_path );
+  remove( training_path.c_str() );
+  remove( validation_path.c_str() );
+
+  network net(2, hidden, classes);
+  net.feed( vector<double>( inputs, 0.0 ) );
+  for(unsigned int i = 0; i + 1 < net.layers(); i++) net.activation( i, activation_kind::relu );
+  net.output_stage( stage::softmax );
+
+  initializer init( scheme::he, 5 );
+  init.biases( true );
+  init.initialize( net );
+  net.optimizer( make_shared<optimizer::sgd>( 0.001, 0.9 ) );
+
+  trainer t;
+  t.epochs( epochs );
+  vector<storage> formats = { storage::bfloat16, storage::half };
+  quantizer q;
+
+  print( "trained with each storage", q.compare( net, formats, t, training, validation ) );
+  t.train( net, training, validation );
+  print( "trained in double, then rounded", q.compare( net, formats, validation ) );
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//
+// Latency of one inference with mp::network and with the equivalent mp::static_network.
+//
+//    bin/static_network_bench [iterations]
+//
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include "static_network.h"
+
+using namespace mp;
+using namespace std;
+
+static void prepare(network &net, const unsigned int &inputs) {
+  net.feed( vector<double>( inputs, 0.0 ) );
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.05 * j );
+      for(unsigned int f = 0; f < n->factors_size(); f++) n->set_factor(f, sin( 1.0 + i + j + f ));
+    }
+  }
+}
+
+// It runs both networks over the same inputs and prints the nanoseconds per inference
+template <unsigned int Inputs, unsigned int... Layers>
+static void compare(const char *name, network &net, const unsigned int &iterations) {
+  static_network<Inputs, Layers...> fixed( net );
+  vector<vector<double>> samples( 64, vector<double>( Inputs ) );
+  for(unsigned int s = 0; s < samples.size(); s++) {
+    for(unsigned int i = 0; i < Inputs; i++) samples[s][i] = cos( 0.3 * s + i );
+  }
+
+  double dynamic_sum = 0.0, static_sum = 0.0;
+  bool same = true;
+
+  auto start = chrono::steady_clock::now();
+  for(unsigned int k = 0; k < iterations; k++) {
+    dynamic_sum += net.output( samples[k % samples.size()] )[0];
+  }
+  double dynamic_time = chrono::duration<double, nano>( chrono::steady_clock::now() - start ).count();
+
+  double result[fixed.outputs()];
+  start = chrono::steady_clock::now();
+  for(unsigned int k = 0; k < iterations; k++) {
+    fixed.output( samples[k % samples.size()].data(), result );
+    static_sum += result[0];
+  }
+  double static_time = chrono::duration<double, nano>( chrono::steady_clock::now() - start ).count();
+
+  for( auto &sample : samples ) {
+    fixed.output( sample.data(), result );
+    auto expected = net.output( sample );
+    for(unsigned int o = 0; o < expected.size(); o++) same = same && ( expected[o] == result[o] );
+  }
+
+  printf( "%-16s %12.1f %12.1f %9.1fx %s\n", name, dynamic_time / iterations,
+          static_time / iterations, dynamic_time / static_time,
+          same && ( dynamic_sum == static_sum ) ? "identical" : "DIFFERENT" );
+}
+
+int main(int argc, char **argv) {
+  unsigned int iterations = argc > 1 ? atoi( argv[1] ) : 1000000;
+
+  printf( "%-16s %12s %12s %10s %s\n", "topology", "network ns", "static ns", "speedup",
+          "outputs" );
+
+  network xor_sized(1, 4, 1);
+  prepare( xor_sized, 2 );
+  compare<2, 4, 1>( "2-4-1", xor_sized, iterations );
+
+  network small(1, 16, 4);
+  prepare( small, 8 );
+  small.activation( 0, activation_kind::relu );
+  compare<8, 16, 4>( "8-16-4", small, iterations );
+
+  network deeper(2, 32, 10);
+  prepare( deeper, 16 );
+  deeper.activation( 0, activation_kind::relu );
+  deeper.activation( 1, activation_kind::relu );
+  deeper.output_stage( stage::softmax );
+  compare<16, 32, 32, 10>( "16-32-32-10", deeper, iterations / 10 );
+
+  return 0;
+}
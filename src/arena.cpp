@@ -0,0 +1,101 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "arena.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace mp {
+  // A cache line holds eight doubles
+  const std::size_t arena_alignment = 8;
+
+  arena::arena() {
+    _block = nullptr;
+    _capacity = 0;
+    _used = 0;
+  }
+
+  arena::arena(arena &&a) {
+    _block = a._block;
+    _capacity = a._capacity;
+    _used = a._used;
+
+    a._block = nullptr;
+    a._capacity = 0;
+    a._used = 0;
+  }
+
+  arena& arena::operator=(arena &&a) {
+    if( this != &a ) {
+      std::free( _block );
+
+      _block = a._block;
+      _capacity = a._capacity;
+      _used = a._used;
+
+      a._block = nullptr;
+      a._capacity = 0;
+      a._used = 0;
+    }
+
+    return *this;
+  }
+
+  arena::~arena() {
+    std::free( _block );
+  }
+
+  std::size_t arena::footprint(const std::size_t &count) {
+    return (count + arena_alignment - 1) / arena_alignment * arena_alignment;
+  }
+
+  void arena::reserve(const std::size_t &count) {
+    std::free( _block );
+    _block = nullptr;
+    _capacity = 0;
+    _used = 0;
+
+    if( count > 0 ) {
+      std::size_t bytes = footprint( count ) * sizeof(double);
+      _block = static_cast<double *>( aligned_alloc( arena_alignment * sizeof(double), bytes ) );
+      if( not _block ) throw std::bad_alloc();
+
+      std::memset( _block, 0, bytes );
+      _capacity = footprint( count );
+    }
+  }
+
+  double* arena::allocate(const std::size_t &count) {
+    if( _used + footprint( count ) > _capacity ) {
+      throw std::length_error("arena::allocate: the arena has no space left");
+    }
+
+    double *piece = _block + _used;
+    _used += footprint( count );
+    return piece;
+  }
+
+  std::size_t arena::capacity() const {
+    return _capacity;
+  }
+
+  std::size_t arena::used() const {
+    return _used;
+  }
+}
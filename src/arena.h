@@ -0,0 +1,85 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___ARENA___
+#define ___ARENA___
+#include <cstddef>
+
+namespace mp {
+  /**
+   * \class arena arena.h
+   * \brief A single block of memory where the network places all of its arrays.
+   *
+   * The block is reserved once with the total size, and then handed out in consecutive
+   * pieces aligned to a cache line. The pieces live until the arena is reserved again or
+   * destroyed, and moving the arena keeps them valid.
+   * */
+  class arena {
+    public:
+      /**
+       * It builds an empty arena
+       * */
+      arena();
+
+      arena(const arena &) = delete;
+      arena& operator=(const arena &) = delete;
+      arena(arena &&a);
+      arena& operator=(arena &&a);
+
+      ~arena();
+
+      /**
+       * It returns the number of doubles needed to hold a piece of the given size, padding
+       * included
+       * \param count number of doubles of the piece
+       * \return the space taken by the piece inside the arena
+       * */
+      static std::size_t footprint(const std::size_t &count);
+
+      /**
+       * It releases the current block and reserves a new one, filled with zeros
+       * \param count number of doubles of the new block (the sum of the footprints)
+       * */
+      void reserve(const std::size_t &count);
+
+      /**
+       * It hands out the next piece of the block
+       * \param count number of doubles of the piece
+       * \return a pointer to the piece, aligned to a cache line
+       * \throw length_error if the block has no space left
+       * */
+      double* allocate(const std::size_t &count);
+
+      /**
+       * It returns the number of doubles reserved
+       * \return the size of the block
+       * */
+      std::size_t capacity() const;
+
+      /**
+       * It returns the number of doubles already handed out, padding included
+       * \return the used part of the block
+       * */
+      std::size_t used() const;
+
+    private:
+      double *_block;
+      std::size_t _capacity;
+      std::size_t _used;
+  };
+}
+#endif
@@ -0,0 +1,171 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "cross_validation.h"
+#include "thread_pool.h"
+#include <thread>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <stdexcept>
+
+namespace mp {
+  cross_validation::cross_validation() {
+    _folds = 5;
+    _seed = 0;
+    _threads = max( thread::hardware_concurrency(), 1U );
+  }
+
+  cross_validation::cross_validation(const unsigned int &folds, const unsigned int &seed) {
+    this->folds( folds );
+    _seed = seed;
+    _threads = max( thread::hardware_concurrency(), 1U );
+  }
+
+  void cross_validation::folds(const unsigned int &folds) {
+    if( folds < 2 ) throw invalid_argument( "cross_validation::folds: at least two are needed" );
+    _folds = folds;
+  }
+
+  void cross_validation::seed(const unsigned int &seed) {
+    _seed = seed;
+  }
+
+  void cross_validation::threads(const unsigned int &threads) {
+    _threads = max( threads, 1U );
+  }
+
+  unsigned int cross_validation::folds() const {
+    return _folds;
+  }
+
+  unsigned int cross_validation::seed() const {
+    return _seed;
+  }
+
+  unsigned int cross_validation::threads() const {
+    return _threads;
+  }
+
+  vector<vector<unsigned int>> cross_validation::split(const unsigned int &elements) const {
+    vector<unsigned int> order( elements );
+    iota( order.begin(), order.end(), 0 );
+
+    mt19937 generator( _seed );
+    shuffle( order.begin(), order.end(), generator );
+
+    vector<vector<unsigned int>> result( _folds );
+    for(unsigned int f = 0; f < _folds; f++) {
+      unsigned long begin = static_cast<unsigned long>( elements ) * f / _folds;
+      unsigned long end = static_cast<unsigned long>( elements ) * (f + 1) / _folds;
+
+      result[f].assign( order.begin() + begin, order.begin() + end );
+      sort( result[f].begin(), result[f].end() );
+    }
+
+    return result;
+  }
+
+  cross_validation_report cross_validation::run(const vector<network *> &models,
+                                                const trainer &config,
+                                                const data &samples) const {
+    if( models.size() != _folds ) {
+      throw invalid_argument( "cross_validation::run: one network per fold is needed" );
+    }
+
+    if( samples.elements() < _folds ) {
+      throw invalid_argument( "cross_validation::run: every fold needs at least one sample" );
+    }
+
+    cross_validation_report report;
+    report.folds.resize( _folds );
+
+    auto held_out = split( samples.elements() );
+
+    // The threads left by the folds are shared by the evaluators of each fold
+    unsigned int workers = min( _threads, _folds );
+    evaluator fold_evaluator = config.validation_evaluator();
+    fold_evaluator.threads( max( _threads / workers, 1U ) );
+
+    trainer fold_config = config;
+    fold_config.validation_evaluator( fold_evaluator );
+
+    thread_pool pool( workers );
+
+    for(unsigned int f = 0; f < _folds; f++) {
+      pool.submit( [&, f] {
+        vector<unsigned int> kept;
+        kept.reserve( samples.elements() - held_out[f].size() );
+
+        for(unsigned int i = 0, h = 0; i < samples.elements(); i++) {
+          if(( h < held_out[f].size() ) && ( held_out[f][h] == i )) h++;
+          else kept.push_back( i );
+        }
+
+        data training( samples, kept );
+        data validation( samples, held_out[f] );
+
+        auto &fold = report.folds[f];
+        fold.held_out = held_out[f];
+        fold.training = fold_config.train( *(models[f]), training, training );
+        fold.validation = fold_evaluator.evaluate( *(models[f]), validation );
+      } );
+    }
+
+    pool.wait();
+
+    auto &mean = report.mean;
+    auto &deviation = report.deviation;
+    mean.elements = 0;
+    mean.mse = mean.cross_entropy = mean.accuracy = 0.0;
+    deviation.elements = 0;
+    deviation.mse = deviation.cross_entropy = deviation.accuracy = 0.0;
+
+    for( auto &fold : report.folds ) {
+      auto &m = fold.validation;
+      mean.elements += m.elements;
+      mean.mse += m.mse / _folds;
+      mean.cross_entropy += m.cross_entropy / _folds;
+      mean.accuracy += m.accuracy / _folds;
+
+      if( mean.confusion.empty() ) mean.confusion = m.confusion;
+      else {
+        for(unsigned int i = 0; i < m.confusion.size(); i++) {
+          for(unsigned int j = 0; j < m.confusion[i].size(); j++) {
+            mean.confusion[i][j] += m.confusion[i][j];
+          }
+        }
+      }
+    }
+
+    for( auto &fold : report.folds ) {
+      auto &m = fold.validation;
+      deviation.mse += (m.mse - mean.mse) * (m.mse - mean.mse) / _folds;
+      deviation.cross_entropy += (m.cross_entropy - mean.cross_entropy) *
+                                 (m.cross_entropy - mean.cross_entropy) / _folds;
+      deviation.accuracy += (m.accuracy - mean.accuracy) * (m.accuracy - mean.accuracy) / _folds;
+    }
+
+    deviation.elements = mean.elements;
+    deviation.mse = sqrt( deviation.mse );
+    deviation.cross_entropy = sqrt( deviation.cross_entropy );
+    deviation.accuracy = sqrt( deviation.accuracy );
+
+    return report;
+  }
+}
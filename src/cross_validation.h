@@ -0,0 +1,140 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___CROSS_VALIDATION___
+#define ___CROSS_VALIDATION___
+#include <vector>
+#include "network.h"
+#include "data.h"
+#include "evaluation.h"
+#include "trainer.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Result of one fold of a cross-validation.
+   * */
+  struct fold_report {
+    vector<unsigned int> held_out;
+    training_report training;
+    metrics validation;
+  };
+
+  /**
+   * \brief Result of a whole cross-validation.
+   *
+   * mean and deviation hold the mean and the standard deviation over the folds of the mse,
+   * cross-entropy and accuracy. The confusion matrix of mean is the sum of the confusion
+   * matrices of all the folds, so every sample is counted once.
+   * */
+  struct cross_validation_report {
+    vector<fold_report> folds;
+    metrics mean;
+    metrics deviation;
+  };
+
+  /**
+   * \class cross_validation cross_validation.h
+   * \brief It estimates how a network generalizes with a k-fold cross-validation.
+   *
+   * The samples are shuffled with the seed and split in k folds of (nearly) the same size.
+   * Each network is trained over all the folds but one, which is held out to evaluate it.
+   * The folds are views of the data set (see data), so the samples are never copied. The
+   * folds are trained concurrently, and the threads of the trainer evaluators are lowered
+   * so the total number of threads is never over threads().
+   * */
+  class cross_validation {
+    public:
+      /**
+       * It builds a cross-validation of 5 folds with seed 0, using one thread per hardware
+       * thread
+       * */
+      cross_validation();
+
+      /**
+       * It builds a cross-validation of the given folds and seed
+       * \param folds number of folds
+       * \param seed  seed used to shuffle the samples
+       * \throw invalid_argument if there are less than two folds
+       * */
+      cross_validation(const unsigned int &folds, const unsigned int &seed);
+
+      /**
+       * It sets the number of folds
+       * \param folds number of folds
+       * \throw invalid_argument if there are less than two folds
+       * */
+      void folds(const unsigned int &folds);
+
+      /**
+       * It sets the seed used to shuffle the samples
+       * \param seed the seed
+       * */
+      void seed(const unsigned int &seed);
+
+      /**
+       * It sets the most threads used at once (at least one)
+       * \param threads number of threads
+       * */
+      void threads(const unsigned int &threads);
+
+      /**
+       * It returns the number of folds
+       * \return the number of folds
+       * */
+      unsigned int folds() const;
+
+      /**
+       * It returns the seed used to shuffle the samples
+       * \return the seed
+       * */
+      unsigned int seed() const;
+
+      /**
+       * It returns the most threads used at once
+       * \return the number of threads
+       * */
+      unsigned int threads() const;
+
+      /**
+       * It returns the indices of the samples held out in each fold
+       * \param elements number of samples of the data set
+       * \return the held out indices of every fold, in increasing order
+       * */
+      vector<vector<unsigned int>> split(const unsigned int &elements) const;
+
+      /**
+       * It runs the cross-validation. The training samples of each fold are also its
+       * validation set, so the held out fold is never seen before the final evaluation.
+       * \param models  one untrained network per fold, left trained over its fold
+       * \param config  trainer used in every fold
+       * \param samples the data set
+       * \return the metrics of every fold and their mean and deviation
+       * \throw invalid_argument if there is not one network per fold, or less samples than
+       * folds
+       * */
+      cross_validation_report run(const vector<network *> &models, const trainer &config,
+                                  const data &samples) const;
+
+    private:
+      unsigned int _folds;
+      unsigned int _seed;
+      unsigned int _threads;
+  };
+}
+#endif
@@ -28,6 +28,20 @@ namespace mp {
     reload(path);
   }
 
+  data::data(const data &source, const vector<unsigned int> &indices) {
+    _inputs_length = source._inputs_length;
+    _outputs_length = source._outputs_length;
+    _elements = indices.size();
+
+    _inputs.reserve( _elements );
+    _outputs.reserve( _elements );
+
+    for( auto index : indices ) {
+      _inputs.push_back( source._inputs.at( index ) );
+      _outputs.push_back( source._outputs.at( index ) );
+    }
+  }
+
   unsigned int data::inputs_length() const {
     return _inputs_length;
   }
@@ -48,6 +62,22 @@ namespace mp {
     return weak_ptr<vector<double>>(_outputs.at( index ));
   }
 
+  data data::relabeled(const vector<vector<double>> &outputs) const {
+    if( outputs.size() != _elements ) {
+      throw invalid_argument("data::relabeled: there must be one output per sample");
+    }
+
+    data result = *this;
+    result._outputs_length = outputs.empty() ? _outputs_length : outputs.front().size();
+    result._outputs.clear();
+
+    for( auto &output : outputs ) {
+      result._outputs.push_back( make_shared<vector<double>>( output ) );
+    }
+
+    return result;
+  }
+
   void data::reload(const string &path) {
     ifstream file;
     file.open( path );
@@ -23,6 +23,7 @@
 #include <fstream>
 #include <sstream>
 #include <cstdio>
+#include <stdexcept>
 
 using namespace std;
 
@@ -32,12 +33,18 @@ namespace mp {
       data();
       data(const string &path);
 
+      // A view of the given samples of source. The samples are shared, not copied.
+      data(const data &source, const vector<unsigned int> &indices);
+
       unsigned int inputs_length() const;
       unsigned int outputs_length() const;
       unsigned int elements() const;
       weak_ptr<vector<double>> input(const unsigned int &index) const;
       weak_ptr<vector<double>> output(const unsigned int &index) const;
 
+      // The same inputs with other outputs, one per sample. The inputs are shared, not copied.
+      data relabeled(const vector<vector<double>> &outputs) const;
+
       void reload(const string &path);
 
     private:
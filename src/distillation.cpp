@@ -0,0 +1,194 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "distillation.h"
+#include "thread_pool.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+
+namespace mp {
+  /*
+   * Mean seconds of one inference, predicting the samples one by one repeats times.
+   * */
+  static double latency(const network &net, const data &dat, const unsigned int &repeats) {
+    if( dat.elements() == 0 ) return 0.0;
+
+    vector<vector<double>> results;
+    auto start = chrono::steady_clock::now();
+
+    for(unsigned int k = 0; k < repeats; k++) {
+      for(unsigned int i = 0; i < dat.elements(); i++) {
+        net.predict( { dat.input( i ).lock().get() }, results );
+      }
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / (static_cast<double>( repeats ) * dat.elements());
+  }
+
+  distiller::distiller() {
+    _hard_weight = 0.5;
+    _temperature = 2.0;
+    threads( thread::hardware_concurrency() );
+    _batch_size = 32;
+    _repeats = 5;
+  }
+
+  distiller::distiller(const double &hard_weight, const double &temperature) {
+    this->hard_weight( hard_weight );
+    this->temperature( temperature );
+    threads( thread::hardware_concurrency() );
+    _batch_size = 32;
+    _repeats = 5;
+  }
+
+  void distiller::hard_weight(const double &weight) {
+    if(( weight < 0.0 ) || ( weight > 1.0 )) {
+      throw invalid_argument("distiller::hard_weight: the weight must be between 0 and 1");
+    }
+
+    _hard_weight = weight;
+  }
+
+  void distiller::temperature(const double &temperature) {
+    if( temperature <= 0.0 ) {
+      throw invalid_argument("distiller::temperature: the temperature must be positive");
+    }
+
+    _temperature = temperature;
+  }
+
+  void distiller::threads(const unsigned int &threads) {
+    _threads = max( threads, 1U );
+  }
+
+  void distiller::batch_size(const unsigned int &batch_size) {
+    _batch_size = max( batch_size, 1U );
+  }
+
+  void distiller::repeats(const unsigned int &repeats) {
+    _repeats = max( repeats, 1U );
+  }
+
+  double distiller::hard_weight() const {
+    return _hard_weight;
+  }
+
+  double distiller::temperature() const {
+    return _temperature;
+  }
+
+  unsigned int distiller::threads() const {
+    return _threads;
+  }
+
+  unsigned int distiller::batch_size() const {
+    return _batch_size;
+  }
+
+  unsigned int distiller::repeats() const {
+    return _repeats;
+  }
+
+  data distiller::targets(const network &teacher, const data &dat) const {
+    unsigned int elements = dat.elements();
+    unsigned int outputs = teacher.layer_size( teacher.layers() - 1 );
+    bool softmax = ( teacher.output_stage() == stage::softmax );
+
+    if(( elements > 0 ) && ( dat.outputs_length() != outputs )) {
+      throw invalid_argument("distiller::targets: data outputs do not fit the teacher outputs");
+    }
+
+    if(( not softmax ) && ( _temperature != 1.0 )) {
+      throw invalid_argument("distiller::targets: only a softmax teacher can be softened");
+    }
+
+    // A compiled copy, so the blocks do not pack the teacher layers again and again
+    network runner = teacher.replica();
+    if( not runner.compiled() ) runner.compile( runner.layer_inputs( 0 ), _batch_size );
+
+    vector<vector<double>> blended( elements );
+    unsigned int workers = min( _threads, max( (elements + _batch_size - 1) / _batch_size, 1U ) );
+    thread_pool pool( workers );
+
+    for(unsigned int first = 0; first < elements; first += _batch_size) {
+      pool.submit( [&, first]() {
+        unsigned int last = min( first + _batch_size, elements );
+        vector<const vector<double> *> block;
+        vector<vector<double>> results;
+
+        for(unsigned int i = first; i < last; i++) block.push_back( dat.input( i ).lock().get() );
+        runner.predict( block, results );
+
+        for(unsigned int i = first; i < last; i++) {
+          auto &soft = results[i - first];
+          auto &hard = *(dat.output( i ).lock());
+
+          if( softmax && ( _temperature != 1.0 ) ) {
+            double sum = 0.0;
+            for( auto &p : soft ) {
+              p = pow( p, 1 / _temperature );
+              sum += p;
+            }
+
+            for( auto &p : soft ) p /= sum;
+          }
+
+          blended[i].resize( outputs );
+          for(unsigned int k = 0; k < outputs; k++) {
+            blended[i][k] = _hard_weight * hard[k] + (1 - _hard_weight) * soft[k];
+          }
+        }
+      });
+    }
+
+    pool.wait();
+    return dat.relabeled( blended );
+  }
+
+  distillation_report distiller::distill(const network &teacher, network &student,
+                                         const trainer &config, const data &training,
+                                         const data &validation) const {
+    unsigned int outputs = teacher.layer_size( teacher.layers() - 1 );
+    if( student.layer_size( student.layers() - 1 ) != outputs ) {
+      throw invalid_argument("distiller::distill: the student outputs are not the teacher ones");
+    }
+
+    distillation_report report;
+    data blended = targets( teacher, training );
+    report.training = config.train( student, blended, validation );
+
+    evaluator e( _threads, _batch_size );
+    report.teacher = e.evaluate( teacher, validation );
+    report.student = e.evaluate( student, validation );
+    report.teacher_parameters = teacher.weights().size();
+    report.student_parameters = student.weights().size();
+
+    network runner = teacher.replica();
+    if( not runner.compiled() ) runner.compile( runner.layer_inputs( 0 ) );
+    if( not student.compiled() ) student.compile( student.layer_inputs( 0 ) );
+
+    report.teacher_latency = latency( runner, validation, _repeats );
+    report.student_latency = latency( student, validation, _repeats );
+    report.speedup = ( report.student_latency > 0.0 ) ? report.teacher_latency /
+                                                        report.student_latency : 0.0;
+    return report;
+  }
+}
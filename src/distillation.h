@@ -0,0 +1,177 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___DISTILLATION___
+#define ___DISTILLATION___
+#include <vector>
+#include "network.h"
+#include "data.h"
+#include "trainer.h"
+#include "evaluation.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Teacher and student side by side after a distillation.
+   *
+   * The metrics are measured over the validation set. The latencies are the mean seconds of
+   * one inference, predicting the validation samples one by one.
+   * */
+  struct distillation_report {
+    metrics teacher;
+    metrics student;
+    unsigned long long teacher_parameters;
+    unsigned long long student_parameters;
+    double teacher_latency;
+    double student_latency;
+    double speedup;
+    training_report training;
+  };
+
+  /**
+   * \class distiller distillation.h
+   * \brief It trains a small student network to imitate a big teacher network.
+   *
+   * The teacher outputs of every training sample are computed once, in blocks that several
+   * threads send through the teacher at the same time, and cached as the targets of a data
+   * set that shares the training inputs. Each target blends the hard target of the sample with
+   * the soft target of the teacher:
+   *
+   * target = hard_weight * hard + (1 - hard_weight) * soft
+   *
+   * With the softmax output stage the loss is the cross-entropy, which is linear in the
+   * target, so training on the blend is training on the blend of both losses. The soft
+   * targets of a softmax teacher are softened with the temperature, softmax(z / T), computed
+   * from its probabilities as p^(1/T) normalized. Teachers without softmax give their outputs
+   * as they are, so they need a temperature of 1.
+   * */
+  class distiller {
+    public:
+      /**
+       * It builds a distiller with hard weight 0.5, temperature 2, as many threads as cores,
+       * blocks of 32 samples and 5 latency measures
+       * */
+      distiller();
+
+      /**
+       * It builds a distiller with the given blend
+       * \param hard_weight weight of the hard targets
+       * \param temperature temperature of the soft targets
+       * \throw invalid_argument if hard_weight is not between 0 and 1 or temperature is not
+       * positive
+       * */
+      distiller(const double &hard_weight, const double &temperature);
+
+      /**
+       * It sets the weight of the hard targets in the blend
+       * \param weight weight of the hard targets, between 0 and 1
+       * \throw invalid_argument if weight is not between 0 and 1
+       * */
+      void hard_weight(const double &weight);
+
+      /**
+       * It sets the temperature of the soft targets
+       * \param temperature temperature, 1 keeps the teacher probabilities
+       * \throw invalid_argument if temperature is not positive
+       * */
+      void temperature(const double &temperature);
+
+      /**
+       * It sets the number of threads that run the teacher (at least one)
+       * \param threads number of threads
+       * */
+      void threads(const unsigned int &threads);
+
+      /**
+       * It sets the number of samples sent through the teacher at once (at least one)
+       * \param batch_size number of samples of each block
+       * */
+      void batch_size(const unsigned int &batch_size);
+
+      /**
+       * It sets how many times the validation set is predicted to measure the latencies
+       * \param repeats number of predictions (at least one)
+       * */
+      void repeats(const unsigned int &repeats);
+
+      /**
+       * It returns the weight of the hard targets
+       * \return the hard weight
+       * */
+      double hard_weight() const;
+
+      /**
+       * It returns the temperature of the soft targets
+       * \return the temperature
+       * */
+      double temperature() const;
+
+      /**
+       * It returns the number of threads that run the teacher
+       * \return the number of threads
+       * */
+      unsigned int threads() const;
+
+      /**
+       * It returns the number of samples sent through the teacher at once
+       * \return the block size
+       * */
+      unsigned int batch_size() const;
+
+      /**
+       * It returns how many times the validation set is predicted to measure the latencies
+       * \return the number of predictions
+       * */
+      unsigned int repeats() const;
+
+      /**
+       * It computes the blended targets of every sample
+       * \param teacher the teacher network, it is not modified
+       * \param dat     samples with their hard targets
+       * \return a data set with the inputs of dat and the blended targets
+       * \throw invalid_argument if the samples do not fit the teacher, or the temperature is not
+       * 1 and the teacher does not use the softmax stage
+       * */
+      data targets(const network &teacher, const data &dat) const;
+
+      /**
+       * It trains the student over the blended targets of the training set, and measures
+       * both networks over the validation set
+       * \param teacher    the teacher network, it is not modified
+       * \param student    the network to train
+       * \param config     trainer used for the student; it watches the validation set
+       * \param training   samples with their hard targets
+       * \param validation samples used to compare both networks
+       * \return teacher and student accuracy and latency, and the training of the student
+       * \throw invalid_argument if the student outputs are not the teacher ones, the samples do
+       * not fit the networks, or the temperature is not 1 and the teacher does not use the
+       * softmax stage
+       * */
+      distillation_report distill(const network &teacher, network &student,
+                                  const trainer &config, const data &training,
+                                  const data &validation) const;
+
+    private:
+      double _hard_weight;
+      double _temperature;
+      unsigned int _threads;
+      unsigned int _batch_size;
+      unsigned int _repeats;
+  };
+}
+#endif
@@ -0,0 +1,132 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "distributed.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace mp {
+  data_parallel::data_parallel(transport::base &link) : _link(link) {
+    _batch_size = 32;
+  }
+
+  void data_parallel::batch_size(const unsigned int &batch_size) {
+    _batch_size = max( batch_size, 1U );
+  }
+
+  unsigned int data_parallel::batch_size() const {
+    return _batch_size;
+  }
+
+  vector<unsigned int> data_parallel::shard(const unsigned int &elements) const {
+    unsigned long begin = static_cast<unsigned long>( elements ) * _link.rank() / _link.size();
+    unsigned long end = static_cast<unsigned long>( elements ) * (_link.rank() + 1) /
+                        _link.size();
+
+    vector<unsigned int> result;
+    for(unsigned long i = begin; i < end; i++) result.push_back( i );
+    return result;
+  }
+
+  void data_parallel::allreduce(transport::base &link, vector<double> &values) {
+    unsigned int workers = link.size();
+    if( workers == 1 ) return;
+
+    double own = values.size(), previous = 0.0;
+    link.exchange( &own, 1, &previous, 1 );
+    if( own != previous ) {
+      throw invalid_argument( "data_parallel::allreduce: the workers have different sizes" );
+    }
+
+    unsigned long total = values.size();
+    auto begin = [&](unsigned int chunk) { return total * chunk / workers; };
+    auto length = [&](unsigned int chunk) { return begin( chunk + 1 ) - begin( chunk ); };
+
+    vector<double> incoming( total / workers + 1 );
+    unsigned int rank = link.rank();
+
+    // Reduce-scatter: after it, this worker holds the whole sum of the chunk rank + 1
+    for(unsigned int s = 0; s + 1 < workers; s++) {
+      unsigned int sent = (rank + workers - s) % workers;
+      unsigned int received = (rank + 2 * workers - s - 1) % workers;
+
+      link.exchange( values.data() + begin( sent ), length( sent ),
+                     incoming.data(), length( received ) );
+
+      double *target = values.data() + begin( received );
+      for(unsigned long i = 0; i < length( received ); i++) target[i] += incoming[i];
+    }
+
+    // Allgather: every sum is copied as is, so all the workers end with the same bits
+    for(unsigned int s = 0; s + 1 < workers; s++) {
+      unsigned int sent = (rank + 1 + workers - s) % workers;
+      unsigned int received = (rank + workers - s) % workers;
+
+      link.exchange( values.data() + begin( sent ), length( sent ),
+                     values.data() + begin( received ), length( received ) );
+    }
+  }
+
+  void data_parallel::broadcast(network &net) const {
+    auto values = net.weights();
+    if( _link.rank() != 0 ) fill( values.begin(), values.end(), 0.0 );
+
+    allreduce( _link, values );
+    net.weights( values );
+  }
+
+  unsigned long data_parallel::train(network &net, const data &training,
+                                     const unsigned int &epochs) const {
+    broadcast( net );
+
+    auto mine = shard( training.elements() );
+    unsigned int largest = (training.elements() + _link.size() - 1) / _link.size();
+    unsigned long steps = 0;
+
+    vector<const vector<double> *> inputs, expected;
+
+    for(unsigned int epoch = 0; epoch < epochs; epoch++) {
+      // Every worker takes the same number of steps, even with a shorter shard
+      for(unsigned int start = 0; start < largest; start += _batch_size) {
+        inputs.clear();
+        expected.clear();
+
+        unsigned int end = min<unsigned int>( start + _batch_size, mine.size() );
+        for(unsigned int i = start; i < end; i++) {
+          inputs.push_back( training.input( mine[i] ).lock().get() );
+          expected.push_back( training.output( mine[i] ).lock().get() );
+        }
+
+        double count = inputs.size();
+        auto values = net.gradients( inputs, expected );
+        for( auto &v : values ) v *= count;
+        values.push_back( count );
+
+        allreduce( _link, values );
+
+        double samples = values.back();
+        values.pop_back();
+        for( auto &v : values ) v /= samples;
+
+        net.apply_gradients( values );
+        steps++;
+      }
+    }
+
+    return steps;
+  }
+}
@@ -0,0 +1,99 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___DISTRIBUTED___
+#define ___DISTRIBUTED___
+#include <vector>
+#include "network.h"
+#include "data.h"
+#include "transport.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \class data_parallel distributed.h
+   * \brief It trains one network with several workers, each one over its shard of the data.
+   *
+   * Every worker (usually a process) runs its own data_parallel over the same network
+   * topology and the same data set. In each step, every worker computes the mean gradient of
+   * the next batch_size samples of its shard. The gradients are weighted by their samples
+   * and added with a ring allreduce, and every worker applies the same global gradient with
+   * its optimizer. The allreduce hands out the very same sums to every worker, so the
+   * networks (weights and optimizer state) stay bit-identical after every step.
+   * */
+  class data_parallel {
+    public:
+      /**
+       * It builds a data-parallel trainer over the given link, with batches of 32 samples per
+       * worker
+       * \param link link of this worker with the others. It must live as long as the trainer.
+       * */
+      data_parallel(transport::base &link);
+
+      /**
+       * It sets the number of samples of each worker per step (at least one)
+       * \param batch_size samples per worker and step
+       * */
+      void batch_size(const unsigned int &batch_size);
+
+      /**
+       * It returns the number of samples of each worker per step
+       * \return the samples per worker and step
+       * */
+      unsigned int batch_size() const;
+
+      /**
+       * It returns the indices of the samples of this worker: a contiguous part of the data
+       * set, of (nearly) the same size for every worker
+       * \param elements number of samples of the data set
+       * \return the indices of the shard
+       * */
+      vector<unsigned int> shard(const unsigned int &elements) const;
+
+      /**
+       * It adds the values of every worker, with a ring allreduce. Every worker gets the same
+       * result, bit by bit.
+       * \param link   link of this worker
+       * \param values values of this worker, replaced by the sums
+       * \throw invalid_argument if the workers do not have the same number of values
+       * */
+      static void allreduce(transport::base &link, vector<double> &values);
+
+      /**
+       * It copies the weights of the worker of rank 0 into the network of every worker
+       * \param net the network of this worker
+       * */
+      void broadcast(network &net) const;
+
+      /**
+       * It trains the network during the given epochs. The weights of rank 0 are broadcast
+       * first, so the workers start from the same point.
+       * \param net      the network of this worker
+       * \param training the whole data set. Each worker only reads its shard.
+       * \param epochs   number of passes over the data set
+       * \return the number of synchronization steps
+       * \throw runtime_error if the link fails
+       * */
+      unsigned long train(network &net, const data &training, const unsigned int &epochs) const;
+
+    private:
+      transport::base &_link;
+      unsigned int _batch_size;
+  };
+}
+#endif
@@ -0,0 +1,103 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "engine.h"
+#include "thread_pool.h"
+#include <thread>
+#include <algorithm>
+
+namespace mp {
+  engine::engine() {
+    threads( thread::hardware_concurrency() );
+    _stack = 8;
+  }
+
+  engine::engine(const unsigned int &threads) {
+    this->threads( threads );
+    _stack = 8;
+  }
+
+  void engine::threads(const unsigned int &threads) {
+    _threads = max( threads, 1U );
+  }
+
+  void engine::stack(const unsigned int &width) {
+    _stack = max( width, 1U );
+  }
+
+  unsigned int engine::threads() const {
+    return _threads;
+  }
+
+  unsigned int engine::stack() const {
+    return _stack;
+  }
+
+  unsigned int engine::add(network &net, const trainer &config) {
+    _models.push_back( &net );
+    _trainers.push_back( config );
+    return _models.size() - 1;
+  }
+
+  unsigned int engine::models() const {
+    return _models.size();
+  }
+
+  vector<vector<unsigned int>> engine::groups() const {
+    vector<vector<unsigned int>> result;
+
+    for(unsigned int m = 0; m < _models.size(); m++) {
+      unsigned int g = 0;
+
+      for(; g < result.size(); g++) {
+        unsigned int leader = result[g].front();
+
+        if(( result[g].size() < _stack ) && ( _models[leader]->stackable( *(_models[m]) ) ) &&
+           ( _trainers[leader].compatible( _trainers[m] ) )) break;
+      }
+
+      if( g == result.size() ) result.push_back( vector<unsigned int>() );
+      result[g].push_back( m );
+    }
+
+    return result;
+  }
+
+  vector<training_report> engine::run(const data &training, const data &validation) const {
+    vector<training_report> reports( _models.size() );
+    auto plan = groups();
+
+    thread_pool workers( min<unsigned int>( _threads, max<unsigned int>( plan.size(), 1 ) ) );
+
+    for( auto &group : plan ) {
+      workers.submit( [&, group] {
+        vector<network *> members;
+        for( auto m : group ) members.push_back( _models[m] );
+
+        auto results = _trainers[group.front()].train( members, training, validation );
+        for(unsigned int k = 0; k < group.size(); k++) reports[group[k]] = results[k];
+      } );
+    }
+
+    workers.wait();
+    return reports;
+  }
+
+  vector<training_report> engine::run(const data &training) const {
+    return run( training, training );
+  }
+}
@@ -0,0 +1,119 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___ENGINE___
+#define ___ENGINE___
+#include <vector>
+#include "network.h"
+#include "data.h"
+#include "trainer.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \class engine engine.h
+   * \brief It trains many networks concurrently over one shared, read-only data set.
+   *
+   * The networks are split in groups, and every group is one task of a work-stealing thread
+   * pool. Networks that are stackable (see network::stackable) and use compatible trainers
+   * (see trainer::compatible) share a group of up to stack() networks, which is trained in
+   * lockstep so each layer of all of them runs as one stacked kernel call. The data set is
+   * only read, so it is loaded once for all of the networks.
+   * */
+  class engine {
+    public:
+      /**
+       * It builds an engine with one thread per hardware thread and stacks of eight networks
+       * */
+      engine();
+
+      /**
+       * It builds an engine with the given number of threads and stacks of eight networks
+       * \param threads number of worker threads
+       * */
+      engine(const unsigned int &threads);
+
+      /**
+       * It sets the number of worker threads (at least one)
+       * \param threads number of worker threads
+       * */
+      void threads(const unsigned int &threads);
+
+      /**
+       * It sets the maximum number of networks trained together in one group (at least one).
+       * One disables the stacking.
+       * \param width maximum size of a group
+       * */
+      void stack(const unsigned int &width);
+
+      /**
+       * It returns the number of worker threads
+       * \return the number of threads
+       * */
+      unsigned int threads() const;
+
+      /**
+       * It returns the maximum number of networks trained together in one group
+       * \return the maximum size of a group
+       * */
+      unsigned int stack() const;
+
+      /**
+       * It adds a network to train. The network must live until run returns.
+       * \param net    network to train
+       * \param config trainer used for that network
+       * \return the index of the network in the results of run
+       * */
+      unsigned int add(network &net, const trainer &config);
+
+      /**
+       * It returns the number of networks added
+       * \return the number of networks
+       * */
+      unsigned int models() const;
+
+      /**
+       * It returns the groups in which the networks are trained
+       * \return the indices of the networks of each group
+       * */
+      vector<vector<unsigned int>> groups() const;
+
+      /**
+       * It trains every network added
+       * \param training   samples used to train, shared by all the networks
+       * \param validation samples used to decide when to stop
+       * \return the training summary of each network, in the order they were added
+       * \throw the first exception thrown while training a group
+       * */
+      vector<training_report> run(const data &training, const data &validation) const;
+
+      /**
+       * It trains every network added, using the training samples as validation set
+       * \param training samples used to train, shared by all the networks
+       * \return the training summary of each network, in the order they were added
+       * */
+      vector<training_report> run(const data &training) const;
+
+    private:
+      unsigned int _threads;
+      unsigned int _stack;
+      vector<network *> _models;
+      vector<trainer> _trainers;
+  };
+}
+#endif
@@ -0,0 +1,151 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "evaluation.h"
+#include <thread>
+#include <exception>
+#include <cmath>
+#include <algorithm>
+
+namespace mp {
+  const double probability_epsilon = 1e-12;
+
+  evaluator::evaluator() {
+    _threads = 1;
+    _batch_size = 32;
+  }
+
+  evaluator::evaluator(const unsigned int &threads, const unsigned int &batch_size) {
+    this->threads( threads );
+    this->batch_size( batch_size );
+  }
+
+  void evaluator::threads(const unsigned int &threads) {
+    _threads = max( threads, 1U );
+  }
+
+  void evaluator::batch_size(const unsigned int &batch_size) {
+    _batch_size = max( batch_size, 1U );
+  }
+
+  unsigned int evaluator::threads() const {
+    return _threads;
+  }
+
+  unsigned int evaluator::batch_size() const {
+    return _batch_size;
+  }
+
+  metrics evaluator::evaluate(const network &net, const data &dat) const {
+    unsigned int elements = dat.elements();
+    unsigned int outputs = net.layer_size( net.layers() - 1 );
+    unsigned int classes = ( outputs == 1 ) ? 2 : outputs;
+
+    if(( elements > 0 ) && ( dat.outputs_length() != outputs )) {
+      throw invalid_argument("evaluator::evaluate: data outputs do not fit the network outputs");
+    }
+
+    vector<double> squared( elements, 0.0 );
+    vector<double> entropy( elements, 0.0 );
+    vector<unsigned int> predicted( elements, 0 );
+    vector<unsigned int> expected( elements, 0 );
+
+    auto worker = [&](const unsigned int &begin, const unsigned int &end) {
+      vector<const vector<double> *> block;
+      vector<vector<double>> results;
+
+      for(unsigned int start = begin; start < end; start += _batch_size) {
+        unsigned int stop = min( start + _batch_size, end );
+
+        block.clear();
+        for(unsigned int i = start; i < stop; i++) {
+          block.push_back( dat.input( i ).lock().get() );
+        }
+
+        net.predict( block, results );
+
+        for(unsigned int i = start; i < stop; i++) {
+          auto &result = results[i - start];
+          auto &target = *(dat.output( i ).lock());
+
+          for(unsigned int k = 0; k < outputs; k++) {
+            double p = min( max( result[k], probability_epsilon ), 1 - probability_epsilon );
+            double error = target[k] - result[k];
+
+            squared[i] += error * error;
+            if( outputs == 1 ) entropy[i] -= target[k] * log( p ) + (1 - target[k]) * log( 1 - p );
+            else entropy[i] -= target[k] * log( p );
+          }
+
+          predicted[i] = classify( result );
+          expected[i] = classify( target );
+        }
+      }
+    };
+
+    unsigned int workers = min( _threads, max( elements, 1U ) );
+    unsigned int chunk = (elements + workers - 1) / workers;
+    vector<exception_ptr> errors( workers );
+    vector<thread> pool;
+
+    // A sample that does not fit the network throws inside a worker, so the error is kept
+    // and thrown again once every thread has finished
+    auto guarded = [&](const unsigned int &t) {
+      try {
+        worker( min( t * chunk, elements ), min( (t + 1) * chunk, elements ) );
+      } catch(...) {
+        errors[t] = current_exception();
+      }
+    };
+
+    for(unsigned int t = 1; t < workers; t++) pool.push_back( thread( guarded, t ) );
+    guarded( 0 );
+
+    for( auto &t : pool ) t.join();
+    for( auto &error : errors ) {
+      if( error ) rethrow_exception( error );
+    }
+
+    metrics result;
+    result.elements = elements;
+    result.mse = 0.0;
+    result.cross_entropy = 0.0;
+    result.accuracy = 0.0;
+    result.confusion.assign( classes, vector<unsigned int>( classes, 0 ) );
+
+    unsigned int hits = 0;
+    for(unsigned int i = 0; i < elements; i++) {
+      result.mse += squared[i];
+      result.cross_entropy += entropy[i];
+      result.confusion[expected[i]][predicted[i]]++;
+      if( expected[i] == predicted[i] ) hits++;
+    }
+
+    if( elements > 0 ) {
+      result.mse /= static_cast<double>( elements ) * outputs;
+      result.cross_entropy /= elements;
+      result.accuracy = static_cast<double>( hits ) / elements;
+    }
+
+    return result;
+  }
+
+  unsigned int evaluator::classify(const vector<double> &outputs) {
+    if( outputs.size() == 1 ) return ( outputs[0] >= 0.5 ) ? 1 : 0;
+    else return distance( outputs.begin(), max_element( outputs.begin(), outputs.end() ) );
+  }
+}
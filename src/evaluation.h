@@ -0,0 +1,111 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___EVALUATION___
+#define ___EVALUATION___
+#include <vector>
+#include "network.h"
+#include "data.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Results of evaluating a network over a data set.
+   *
+   * The confusion matrix is indexed as confusion[expected class][predicted class]. When the
+   * network has a single output, it is treated as a binary classifier with a 0.5 threshold,
+   * otherwise the class is the index of the biggest output.
+   * */
+  struct metrics {
+    unsigned int elements;
+    double mse;
+    double cross_entropy;
+    double accuracy;
+    vector<vector<unsigned int>> confusion;
+  };
+
+  /**
+   * \class evaluator evaluation.h
+   * \brief It evaluates a network over a whole data set.
+   *
+   * The data set is split in contiguous chunks, one per thread, and each chunk is sent
+   * through the network in blocks of batch_size samples (see network::predict). The
+   * per-sample results are reduced afterwards in the data set order, so the metrics are
+   * identical regardless of the number of threads.
+   * */
+  class evaluator {
+    public:
+      /**
+       * It builds an evaluator that uses one thread and blocks of 32 samples
+       * */
+      evaluator();
+
+      /**
+       * It builds an evaluator with the given number of threads and block size
+       * \param threads    number of threads used to evaluate the data set
+       * \param batch_size number of samples sent through the network at once
+       * */
+      evaluator(const unsigned int &threads, const unsigned int &batch_size);
+
+      /**
+       * It sets the number of threads used to evaluate (at least one)
+       * \param threads number of threads
+       * */
+      void threads(const unsigned int &threads);
+
+      /**
+       * It sets the number of samples sent through the network at once (at least one)
+       * \param batch_size number of samples of each block
+       * */
+      void batch_size(const unsigned int &batch_size);
+
+      /**
+       * It returns the number of threads used to evaluate
+       * \return the number of threads
+       * */
+      unsigned int threads() const;
+
+      /**
+       * It returns the number of samples sent through the network at once
+       * \return the block size
+       * */
+      unsigned int batch_size() const;
+
+      /**
+       * It evaluates the network over all the samples of the data set.
+       * \param net the network to evaluate, it is not modified
+       * \param dat the data set
+       * \return the mean squared error, cross-entropy, accuracy and confusion matrix
+       * \throw invalid_argument if the data set outputs do not fit the network outputs, or its
+       * inputs do not fit the network inputs
+       * */
+      metrics evaluate(const network &net, const data &dat) const;
+
+      /**
+       * It returns the class predicted by (or expected from) the given outputs
+       * \param outputs the network outputs, or the expected ones
+       * \return the index of the biggest output, or 0/1 for single output networks
+       * */
+      static unsigned int classify(const vector<double> &outputs);
+
+    private:
+      unsigned int _threads;
+      unsigned int _batch_size;
+  };
+}
+#endif
@@ -0,0 +1,224 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "exporter.h"
+#include "neuron/leaky_relu.h"
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cctype>
+#include <stdexcept>
+
+namespace mp {
+  /*
+   * It writes a double with enough digits to read back the very same value.
+   * */
+  static string literal(const double &value) {
+    char buffer[32];
+    snprintf( buffer, sizeof( buffer ), "%.17g", value );
+
+    string result( buffer );
+    if( result.find_first_of( ".en" ) == string::npos ) result += ".0";
+    return result;
+  }
+
+  static void array_of(ostream &out, const string &name, const double *values,
+                       const unsigned int &size) {
+    out << "  constexpr double " << name << "[" << size << "] = {";
+
+    for(unsigned int i = 0; i < size; i++) {
+      out << ( i % 4 == 0 ? "\n    " : " " ) << literal( values[i] ) << ( i + 1 < size ? "," : "" );
+    }
+
+    out << "\n  };\n\n";
+  }
+
+  /*
+   * The activation of one value, written as the kernels compute it.
+   * */
+  static string activation_of(const activation_kind &kind, const string &v) {
+    switch( kind ) {
+      case activation_kind::sigmoid:
+        return "1 / (1 + std::exp(-1 * " + v + "))";
+      case activation_kind::hyperbolic_tangent:
+        return "std::tanh(" + v + ")";
+      case activation_kind::relu:
+        return v + " > 0 ? " + v + " : 0.0";
+      case activation_kind::leaky_relu:
+        return v + " > 0 ? " + v + " : " + literal( mp::neuron::leaky_relu::slope ) + " * " + v;
+      case activation_kind::rbf:
+        return "std::exp(-" + v + " * " + v + ")";
+      default:
+        return v;
+    }
+  }
+
+  static const char *kind_name(const activation_kind &kind) {
+    switch( kind ) {
+      case activation_kind::sigmoid: return "sigmoid";
+      case activation_kind::hyperbolic_tangent: return "hyperbolic tangent";
+      case activation_kind::relu: return "relu";
+      case activation_kind::leaky_relu: return "leaky relu";
+      case activation_kind::rbf: return "rbf";
+      case activation_kind::linear: return "linear";
+      default: return "mixed";
+    }
+  }
+
+  exporter::exporter() {
+    _name = "model";
+  }
+
+  exporter::exporter(const string &name) {
+    this->name( name );
+  }
+
+  void exporter::name(const string &name) {
+    bool valid = ( not name.empty() ) && ( not isdigit( name[0] ) );
+    for( auto c : name ) valid = valid && ( isalnum( c ) || c == '_' );
+
+    if( not valid ) throw invalid_argument( "exporter: the name is not a C++ identifier" );
+    _name = name;
+  }
+
+  string exporter::name() const {
+    return _name;
+  }
+
+  void exporter::write(const network &net, ostream &out) const {
+    if( net.weight_storage() != storage::float64 ) {
+      throw invalid_argument( "exporter: the weights must be stored as double" );
+    }
+
+    if( net.layer_inputs( 0 ) == 0 ) {
+      throw invalid_argument( "exporter: the network has not been fed" );
+    }
+
+    unsigned int layers = net.layers();
+    vector<vector<activation_kind>> kinds( layers );
+    vector<vector<bool>> biases( layers );
+
+    for(unsigned int i = 0; i < layers; i++) {
+      for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+        auto n = net.neuron(i, j).lock();
+        if( n->kind() == activation_kind::custom ) {
+          throw invalid_argument( "exporter: custom neurons can not be exported" );
+        }
+
+        kinds[i].push_back( n->kind() );
+        biases[i].push_back( n->bias_enabled() );
+      }
+    }
+
+    auto weights = net.weights();
+    bool softmax = ( net.output_stage() == stage::softmax );
+    string guard = "___" + _name + "___";
+    for( auto &c : guard ) c = toupper( c );
+
+    out << "//\n// Generated from a trained NeuronNetwork-CPP network. Do not edit.\n//\n"
+        << "#ifndef " << guard << "\n#define " << guard << "\n#include <cmath>\n\n"
+        << "namespace " << _name << " {\n"
+        << "  constexpr unsigned int inputs = " << net.layer_inputs( 0 ) << ";\n"
+        << "  constexpr unsigned int outputs = " << net.layer_size( layers - 1 ) << ";\n\n"
+        << "  inline double multiply_add(const double &a, const double &b, const double &c) {\n"
+        << "#ifdef FP_FAST_FMA\n    return std::fma( a, b, c );\n"
+        << "#else\n    return a * b + c;\n#endif\n  }\n\n";
+
+    unsigned int position = 0;
+    for(unsigned int i = 0; i < layers; i++) {
+      unsigned int rows = net.layer_size( i ), columns = net.layer_inputs( i );
+      vector<double> bias( weights.begin() + position + rows * columns,
+                           weights.begin() + position + rows * (columns + 1) );
+      for(unsigned int j = 0; j < rows; j++) if( not biases[i][j] ) bias[j] = 0.0;
+
+      auto kind = ( i == layers - 1 ) && softmax ? activation_kind::linear : net.activation( i );
+      out << "  // Layer " << i << ": " << rows << " "
+          << ( ( i == layers - 1 ) && softmax ? "softmax" : kind_name( kind ) )
+          << " neurons over " << columns << " inputs\n";
+
+      array_of( out, "layer" + to_string( i ) + "_factors", weights.data() + position,
+                rows * columns );
+      array_of( out, "layer" + to_string( i ) + "_biases", bias.data(), rows );
+      position += rows * (columns + 1);
+    }
+
+    out << "  inline void predict(const double *input, double *output) {\n";
+
+    for(unsigned int i = 0; i < layers; i++) {
+      unsigned int rows = net.layer_size( i ), columns = net.layer_inputs( i );
+      string l = "layer" + to_string( i );
+      string source = ( i == 0 ) ? "input" : "layer" + to_string( i - 1 );
+      string target = ( i == layers - 1 ) ? "output" : l;
+
+      if( i < layers - 1 ) out << "    double " << l << "[" << rows << "];\n";
+
+      out << "    for(unsigned int r = 0; r < " << rows << "; r++) {\n"
+          << "      double sum = " << l << "_biases[r];\n"
+          << "      for(unsigned int c = 0; c < " << columns << "; c++) {\n"
+          << "        sum = multiply_add( " << source << "[c], " << l << "_factors[r * "
+          << columns << " + c], sum );\n"
+          << "      }\n"
+          << "      " << target << "[r] = sum;\n"
+          << "    }\n";
+
+      if(( i == layers - 1 ) && ( softmax )) {
+        out << "    double maximum = output[0], total = 0.0;\n"
+            << "    for(unsigned int r = 1; r < " << rows
+            << "; r++) maximum = output[r] > maximum ? output[r] : maximum;\n"
+            << "    for(unsigned int r = 0; r < " << rows << "; r++) {\n"
+            << "      output[r] = std::exp( output[r] - maximum );\n"
+            << "      total += output[r];\n"
+            << "    }\n"
+            << "    const double inverse = 1 / total;\n"
+            << "    for(unsigned int r = 0; r < " << rows << "; r++) output[r] *= inverse;\n";
+      }
+      else if( net.activation( i ) != activation_kind::custom ) {
+        string v = target + "[r]";
+        if( net.activation( i ) != activation_kind::linear ) {
+          out << "    for(unsigned int r = 0; r < " << rows << "; r++) " << v << " = "
+              << activation_of( net.activation( i ), v ) << ";\n";
+        }
+      }
+      else {
+        // A layer with mixed activations gets one statement per neuron
+        for(unsigned int j = 0; j < rows; j++) {
+          if( kinds[i][j] == activation_kind::linear ) continue;
+
+          string v = target + "[" + to_string( j ) + "]";
+          out << "    " << v << " = " << activation_of( kinds[i][j], v ) << ";\n";
+        }
+      }
+
+      if( i < layers - 1 ) out << "\n";
+    }
+
+    out << "  }\n}\n#endif\n";
+    if( not out.good() ) throw runtime_error( "exporter: can not write the code" );
+  }
+
+  void exporter::save(const network &net, const string &path) const {
+    ostringstream code;
+    write( net, code );
+
+    ofstream file( path );
+    if( not file.is_open() ) throw runtime_error( "exporter: can not write " + path );
+
+    file << code.str();
+    file.close();
+    if( file.fail() ) throw runtime_error( "exporter: can not write " + path );
+  }
+}
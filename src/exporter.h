@@ -0,0 +1,89 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___EXPORTER___
+#define ___EXPORTER___
+#include <string>
+#include <ostream>
+#include "network.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \class exporter exporter.h
+   * \brief It writes a trained network as a self-contained C++ header.
+   *
+   * The header only needs the standard library. It holds the weights of every layer as
+   * constexpr arrays and one inline predict function for that exact topology: each layer is a
+   * loop with constant bounds followed by its own activation, so there is nothing left to
+   * interpret at run time and the compiler can unroll and vectorize it. The weighted sums
+   * and activations are computed as in the network kernels, so a program compiled with the
+   * same flags gets the same outputs as network::output, bit by bit.
+   * */
+  class exporter {
+    public:
+      /**
+       * It builds an exporter that writes the code in the namespace "model"
+       * */
+      exporter();
+
+      /**
+       * It builds an exporter that writes the code in the given namespace
+       * \param name namespace of the generated code
+       * \throw invalid_argument if the name is not a C++ identifier
+       * */
+      exporter(const string &name);
+
+      /**
+       * It sets the namespace of the generated code
+       * \param name namespace of the generated code
+       * \throw invalid_argument if the name is not a C++ identifier
+       * */
+      void name(const string &name);
+
+      /**
+       * It returns the namespace of the generated code
+       * \return the namespace name
+       * */
+      string name() const;
+
+      /**
+       * It writes the code of the network
+       * \param net the network to export
+       * \param out stream where the header is written
+       * \throw invalid_argument if the network has not been fed, has custom neurons, or does
+       * not store its weights as double
+       * \throw runtime_error if the stream can not be written
+       * */
+      void write(const network &net, ostream &out) const;
+
+      /**
+       * It writes the code of the network in a file
+       * \param net  the network to export
+       * \param path path of the header
+       * \throw invalid_argument if the network has not been fed, has custom neurons, or does
+       * not store its weights as double
+       * \throw runtime_error if the file can not be written
+       * */
+      void save(const network &net, const string &path) const;
+
+    private:
+      string _name;
+  };
+}
+#endif
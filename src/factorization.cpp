@@ -0,0 +1,303 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "factorization.h"
+#include "schedule.h"
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+namespace mp {
+  /*
+   * Multiply-adds of one inference of the network.
+   * */
+  static unsigned long long operations(const network &net) {
+    unsigned long long result = 0;
+
+    for(unsigned int i = 0; i < net.layers(); i++) {
+      result += static_cast<unsigned long long>( net.layer_size( i ) ) * net.layer_inputs( i );
+    }
+
+    return result;
+  }
+
+  /*
+   * It evaluates the data set repeats times with one thread, and returns the seconds taken and
+   * the accuracy.
+   * */
+  static pair<double, double> measure(const network &net, const data &dat,
+                                      const unsigned int &repeats) {
+    evaluator single;
+    metrics result = metrics();
+
+    auto start = chrono::steady_clock::now();
+    for(unsigned int k = 0; k < repeats; k++) result = single.evaluate( net, dat );
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    return { elapsed.count(), result.accuracy };
+  }
+
+  factorizer::factorizer() {
+    _energy = 0.9;
+    _iterations = 0;
+    _repeats = 5;
+  }
+
+  factorizer::factorizer(const double &energy) {
+    this->energy( energy );
+    _iterations = 0;
+    _repeats = 5;
+  }
+
+  void factorizer::energy(const double &energy) {
+    if(( energy <= 0.0 ) || ( energy > 1.0 )) {
+      throw invalid_argument("factorizer::energy: the energy must be in (0, 1]");
+    }
+
+    _energy = energy;
+  }
+
+  void factorizer::fine_tuning(const unsigned int &iterations, const trainer &config) {
+    _iterations = iterations;
+    _trainer = config;
+  }
+
+  void factorizer::repeats(const unsigned int &repeats) {
+    _repeats = max( repeats, 1U );
+  }
+
+  double factorizer::energy() const {
+    return _energy;
+  }
+
+  unsigned int factorizer::iterations() const {
+    return _iterations;
+  }
+
+  unsigned int factorizer::repeats() const {
+    return _repeats;
+  }
+
+  decomposition factorizer::decompose(const vector<double> &matrix, const unsigned int &rows,
+                                      const unsigned int &columns) {
+    if( matrix.size() != static_cast<size_t>( rows ) * columns ) {
+      throw invalid_argument("factorizer::decompose: the matrix is not rows x columns");
+    }
+
+    // The columns of a tall matrix are orthogonalized; a wide one is transposed first
+    bool transposed = rows < columns;
+    unsigned int m = transposed ? columns : rows;
+    unsigned int n = transposed ? rows : columns;
+
+    vector<vector<double>> a( n, vector<double>( m ) );
+    vector<vector<double>> v( n, vector<double>( n, 0.0 ) );
+    for(unsigned int i = 0; i < rows; i++) {
+      for(unsigned int j = 0; j < columns; j++) {
+        if( transposed ) a[i][j] = matrix[i * columns + j];
+        else a[j][i] = matrix[i * columns + j];
+      }
+    }
+    for(unsigned int k = 0; k < n; k++) v[k][k] = 1.0;
+
+    const double epsilon = numeric_limits<double>::epsilon();
+    bool rotated = true;
+
+    for(unsigned int sweep = 0; rotated && ( sweep < 60 ); sweep++) {
+      rotated = false;
+
+      for(unsigned int p = 0; p + 1 < n; p++) {
+        for(unsigned int q = p + 1; q < n; q++) {
+          double alpha = 0.0, beta = 0.0, gamma = 0.0;
+          for(unsigned int i = 0; i < m; i++) {
+            alpha += a[p][i] * a[p][i];
+            beta += a[q][i] * a[q][i];
+            gamma += a[p][i] * a[q][i];
+          }
+
+          if( fabs( gamma ) <= epsilon * sqrt( alpha * beta ) ) continue;
+          rotated = true;
+
+          double zeta = (beta - alpha) / (2 * gamma);
+          double t = ( zeta >= 0 ? 1.0 : -1.0 ) / (fabs( zeta ) + sqrt( 1 + zeta * zeta ));
+          double c = 1 / sqrt( 1 + t * t ), s = c * t;
+
+          for(unsigned int i = 0; i < m; i++) {
+            double x = a[p][i], y = a[q][i];
+            a[p][i] = c * x - s * y;
+            a[q][i] = s * x + c * y;
+          }
+
+          for(unsigned int i = 0; i < n; i++) {
+            double x = v[p][i], y = v[q][i];
+            v[p][i] = c * x - s * y;
+            v[q][i] = s * x + c * y;
+          }
+        }
+      }
+    }
+
+    vector<double> norms( n );
+    for(unsigned int k = 0; k < n; k++) {
+      norms[k] = sqrt( inner_product( a[k].begin(), a[k].end(), a[k].begin(), 0.0 ) );
+    }
+
+    vector<unsigned int> order( n );
+    iota( order.begin(), order.end(), 0 );
+    stable_sort( order.begin(), order.end(), [&](const unsigned int &x, const unsigned int &y) {
+      return norms[x] > norms[y];
+    });
+
+    // left holds the normalized columns of a, right the columns of v
+    decomposition result;
+    result.rows = rows;
+    result.columns = columns;
+    result.singular.resize( n );
+    vector<double> left( m * n ), right( n * n );
+
+    for(unsigned int k = 0; k < n; k++) {
+      unsigned int source = order[k];
+      result.singular[k] = norms[source];
+
+      for(unsigned int i = 0; i < m; i++) {
+        left[i * n + k] = ( norms[source] > 0.0 ) ? a[source][i] / norms[source] : 0.0;
+      }
+      for(unsigned int i = 0; i < n; i++) right[i * n + k] = v[source][i];
+    }
+
+    result.u = transposed ? right : left;
+    result.v = transposed ? left : right;
+    return result;
+  }
+
+  unsigned int factorizer::rank(const vector<double> &singular) const {
+    double total = 0.0, kept = 0.0;
+    for( auto s : singular ) total += s * s;
+
+    unsigned int result = 0;
+    while(( result < singular.size() ) && (( result == 0 ) || ( kept < _energy * total ))) {
+      kept += singular[result] * singular[result];
+      result++;
+    }
+
+    return max( result, 1U );
+  }
+
+  vector<unsigned int> factorizer::factorize(network &net) const {
+    vector<unsigned int> ranks( net.layers(), 0 );
+
+    // From the last layer to the first, so the indices of the layers still to visit are kept
+    for(unsigned int i = net.layers(); i-- > 0; ) {
+      unsigned int rows = net.layer_size( i ), columns = net.layer_inputs( i );
+      auto weights = net.weights();
+
+      unsigned int position = 0;
+      for(unsigned int k = 0; k < i; k++) {
+        position += net.layer_size( k ) * (net.layer_inputs( k ) + 1);
+      }
+
+      vector<double> matrix( weights.begin() + position,
+                             weights.begin() + position + rows * columns );
+      vector<double> biases( weights.begin() + position + rows * columns,
+                             weights.begin() + position + rows * (columns + 1) );
+
+      auto parts = decompose( matrix, rows, columns );
+      unsigned int r = rank( parts.singular ), full = parts.singular.size();
+      if( static_cast<unsigned long long>( r ) * (rows + columns) >=
+          static_cast<unsigned long long>( rows ) * columns ) continue;
+
+      net.insert_layer( i, r );
+      net.activation( i, activation_kind::linear );
+
+      // The thin layer takes S V^T and the original neurons take U
+      weights = net.weights();
+      for(unsigned int k = 0; k < r; k++) {
+        for(unsigned int c = 0; c < columns; c++) {
+          weights[position + k * columns + c] = parts.singular[k] * parts.v[c * full + k];
+        }
+        weights[position + r * columns + k] = 0.0;
+      }
+
+      position += r * (columns + 1);
+      for(unsigned int j = 0; j < rows; j++) {
+        for(unsigned int k = 0; k < r; k++) weights[position + j * r + k] = parts.u[j * full + k];
+      }
+      copy( biases.begin(), biases.end(), weights.begin() + position + rows * r );
+
+      net.weights( weights );
+      ranks[i] = r;
+    }
+
+    return ranks;
+  }
+
+  vector<unsigned int> factorizer::factorize(network &net, const data &training) const {
+    auto ranks = factorize( net );
+
+    trainer epoch = _trainer;
+    epoch.epochs( 1 );
+
+    for(unsigned int k = 0; k < _iterations; k++) {
+      if( _trainer.schedule() ) {
+        epoch.schedule( make_shared<mp::schedule::shifted>( k, _trainer.schedule() ) );
+      }
+
+      epoch.train( net, training );
+    }
+
+    return ranks;
+  }
+
+  factorization_report factorizer::compare(const network &net, const vector<double> &energies,
+                                           const data &training, const data &validation) const {
+    factorization_report report;
+    network dense = net.replica();
+    if( not dense.compiled() ) dense.compile( dense.layer_inputs( 0 ) );
+
+    auto baseline = measure( dense, validation, _repeats );
+    report.accuracy = baseline.second;
+    report.seconds = baseline.first;
+    report.parameters = dense.weights().size();
+    report.operations = operations( dense );
+
+    for( auto threshold : energies ) {
+      factorizer settings = *this;
+      settings.energy( threshold );
+
+      network factorized = net.replica();
+      factorized.optimizer( net.optimizer()->clone() );
+
+      factorization_level level;
+      level.energy = threshold;
+      level.ranks = settings.factorize( factorized, training );
+      if( not factorized.compiled() ) factorized.compile( factorized.layer_inputs( 0 ) );
+
+      auto result = measure( factorized, validation, _repeats );
+      level.parameters = factorized.weights().size();
+      level.operations = operations( factorized );
+      level.accuracy = result.second;
+      level.accuracy_change = result.second - report.accuracy;
+      level.seconds = result.first;
+      level.speedup = ( result.first > 0.0 ) ? baseline.first / result.first : 0.0;
+      report.levels.push_back( level );
+    }
+
+    return report;
+  }
+}
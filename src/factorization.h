@@ -0,0 +1,195 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___FACTORIZATION___
+#define ___FACTORIZATION___
+#include <vector>
+#include "network.h"
+#include "data.h"
+#include "trainer.h"
+#include "evaluation.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Singular value decomposition of a rows x columns matrix: matrix = u * s * v^T.
+   *
+   * u is rows x rank and v is columns x rank, both row-major, with rank = min(rows, columns).
+   * The singular values are sorted from the biggest to the smallest.
+   * */
+  struct decomposition {
+    unsigned int rows;
+    unsigned int columns;
+    vector<double> u;
+    vector<double> singular;
+    vector<double> v;
+  };
+
+  /**
+   * \brief Results of one energy threshold of a factorization sweep.
+   *
+   * The ranks are the ones chosen for each layer of the original network, zero for the layers
+   * that were left as they were. The operations are the multiply-adds of one inference, and
+   * the time is the seconds taken to evaluate the whole validation set.
+   * */
+  struct factorization_level {
+    double energy;
+    vector<unsigned int> ranks;
+    unsigned long long parameters;
+    unsigned long long operations;
+    double accuracy;
+    double accuracy_change;
+    double seconds;
+    double speedup;
+  };
+
+  /**
+   * \brief Results of a factorization sweep: the original network, and each threshold.
+   * */
+  struct factorization_report {
+    double accuracy;
+    unsigned long long parameters;
+    unsigned long long operations;
+    double seconds;
+    vector<factorization_level> levels;
+  };
+
+  /**
+   * \class factorizer factorization.h
+   * \brief It replaces the weight matrices of a trained network with low-rank factors.
+   *
+   * The factors of a layer, a rows x columns matrix W, are decomposed as W = U S V^T. Keeping
+   * the r biggest singular values, the layer is replaced by two thin layers: a linear layer
+   * of r neurons without bias, whose factors are S V^T, followed by the original neurons, whose
+   * factors become U. An inference then takes r * (rows + columns) multiply-adds instead of
+   * rows * columns, so a layer is only replaced when that is fewer.
+   *
+   * The rank of each layer is the smallest one that keeps the given fraction of the energy of
+   * the matrix, the sum of its squared singular values. The replacement can be followed by some
+   * epochs of fine tuning with a trainer.
+   * */
+  class factorizer {
+    public:
+      /**
+       * It builds a factorizer that keeps 90% of the energy, without fine tuning, and that
+       * times each network evaluating the validation set 5 times
+       * */
+      factorizer();
+
+      /**
+       * It builds a factorizer that keeps the given fraction of the energy
+       * \param energy fraction of the energy of each matrix to keep
+       * \throw invalid_argument if energy is not in (0, 1]
+       * */
+      factorizer(const double &energy);
+
+      /**
+       * It sets the fraction of the energy of each matrix to keep
+       * \param energy fraction of the energy to keep
+       * \throw invalid_argument if energy is not in (0, 1]
+       * */
+      void energy(const double &energy);
+
+      /**
+       * It sets the fine tuning after the factorization
+       * \param iterations epochs of fine tuning, none if zero
+       * \param config     trainer used for the fine tuning; its epochs are ignored
+       * */
+      void fine_tuning(const unsigned int &iterations, const trainer &config);
+
+      /**
+       * It sets how many times the validation set is evaluated to time each network
+       * \param repeats number of evaluations (at least one)
+       * */
+      void repeats(const unsigned int &repeats);
+
+      /**
+       * It returns the fraction of the energy of each matrix to keep
+       * \return the energy threshold
+       * */
+      double energy() const;
+
+      /**
+       * It returns the epochs of fine tuning
+       * \return the epochs of fine tuning
+       * */
+      unsigned int iterations() const;
+
+      /**
+       * It returns how many times the validation set is evaluated to time each network
+       * \return the number of evaluations
+       * */
+      unsigned int repeats() const;
+
+      /**
+       * It decomposes a matrix with one-sided Jacobi rotations
+       * \param matrix  row-major rows x columns matrix
+       * \param rows    rows of the matrix
+       * \param columns columns of the matrix
+       * \return the singular value decomposition of the matrix
+       * \throw invalid_argument if the matrix size is not rows x columns
+       * */
+      static decomposition decompose(const vector<double> &matrix, const unsigned int &rows,
+                                     const unsigned int &columns);
+
+      /**
+       * It returns the smallest rank that keeps the energy threshold
+       * \param singular singular values, from the biggest to the smallest
+       * \return the rank, at least one
+       * */
+      unsigned int rank(const vector<double> &singular) const;
+
+      /**
+       * It replaces every layer that gets cheaper with its low-rank factors
+       * \param net the network to factorize
+       * \return the rank of each layer of the original network, zero if it was kept
+       * */
+      vector<unsigned int> factorize(network &net) const;
+
+      /**
+       * It factorizes the network and fine tunes it over the training set
+       * \param net      the network to factorize
+       * \param training samples used by the fine tuning
+       * \return the rank of each layer of the original network, zero if it was kept
+       * */
+      vector<unsigned int> factorize(network &net, const data &training) const;
+
+      /**
+       * It factorizes copies of the network with each energy threshold, fine tuning them over
+       * the training set, and measures their accuracy and evaluation time against the network.
+       * Each copy is tuned with a fresh optimizer of the same type and hyperparameters as the
+       * network's one.
+       * \param net        the trained network, it is not modified
+       * \param energies   energy thresholds to try
+       * \param training   samples used by the fine tuning
+       * \param validation samples used to measure the accuracy and the times
+       * \return the accuracy, size and time of the network, and the results of each threshold
+       * \throw invalid_argument if a threshold is not in (0, 1], or the network can not be
+       * copied
+       * */
+      factorization_report compare(const network &net, const vector<double> &energies,
+                                   const data &training, const data &validation) const;
+
+    private:
+      double _energy;
+      unsigned int _iterations;
+      unsigned int _repeats;
+      trainer _trainer;
+  };
+}
+#endif
@@ -0,0 +1,186 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "halving.h"
+#include "engine.h"
+#include "schedule.h"
+#include <thread>
+#include <algorithm>
+#include <stdexcept>
+
+namespace mp {
+  successive_halving::successive_halving() {
+    _minimum = 1;
+    _maximum = 27;
+    _reduction = 3;
+    _criterion = criterion::mse;
+    _threads = max( thread::hardware_concurrency(), 1U );
+  }
+
+  void successive_halving::budget(const unsigned int &minimum, const unsigned int &maximum) {
+    if(( minimum == 0 ) || ( minimum > maximum )) {
+      throw invalid_argument( "successive_halving::budget: the minimum must be positive and not "
+                              "greater than the maximum" );
+    }
+
+    _minimum = minimum;
+    _maximum = maximum;
+  }
+
+  void successive_halving::reduction(const unsigned int &factor) {
+    if( factor < 2 ) {
+      throw invalid_argument( "successive_halving::reduction: the factor must be at least two" );
+    }
+
+    _reduction = factor;
+  }
+
+  void successive_halving::watched(const criterion &c) {
+    _criterion = c;
+  }
+
+  void successive_halving::threads(const unsigned int &threads) {
+    _threads = max( threads, 1U );
+  }
+
+  void successive_halving::validation_evaluator(const evaluator &e) {
+    _evaluator = e;
+  }
+
+  unsigned int successive_halving::minimum() const {
+    return _minimum;
+  }
+
+  unsigned int successive_halving::maximum() const {
+    return _maximum;
+  }
+
+  unsigned int successive_halving::reduction() const {
+    return _reduction;
+  }
+
+  unsigned int successive_halving::threads() const {
+    return _threads;
+  }
+
+  unsigned int successive_halving::add(network &net, const trainer &config) {
+    _models.push_back( &net );
+    _trainers.push_back( config );
+    return _models.size() - 1;
+  }
+
+  unsigned int successive_halving::candidates() const {
+    return _models.size();
+  }
+
+  halving_report successive_halving::run(const data &training, const data &validation) const {
+    if( _models.empty() ) {
+      throw invalid_argument( "successive_halving::run: there are no candidates to train" );
+    }
+
+    unsigned int count = _models.size();
+    halving_report report;
+    report.best = 0;
+    report.epochs.assign( count, 0 );
+    report.scores.assign( count, 0.0 );
+    report.compute = 0;
+    report.exhaustive_compute = 0;
+
+    // Parameter updates of one epoch of each candidate
+    vector<unsigned long long> epoch_cost( count );
+    for(unsigned int m = 0; m < count; m++) {
+      epoch_cost[m] = static_cast<unsigned long long>( training.elements() ) *
+                      _models[m]->weights().size();
+      report.exhaustive_compute += epoch_cost[m] * _maximum;
+    }
+
+    vector<unsigned int> alive( count );
+    for(unsigned int m = 0; m < count; m++) alive[m] = m;
+
+    unsigned int budget = _minimum;
+
+    while( true ) {
+      // Each survivor resumes from the epoch it reached, which is earlier than the last budget
+      // if it stopped early, so its schedule is shifted by its own epochs
+      engine round( _threads );
+      vector<pair<pair<shared_ptr<mp::schedule::base>, unsigned int>,
+                  shared_ptr<mp::schedule::base>>> shifts;
+
+      for( auto m : alive ) {
+        unsigned int reached = report.epochs[m];
+        trainer config = _trainers[m];
+        config.epochs( budget - reached );
+
+        auto original = config.schedule();
+        if(( original ) && ( reached > 0 )) {
+          auto key = make_pair( original, reached );
+          auto found = find_if( shifts.begin(), shifts.end(),
+                                [&key](const pair<pair<shared_ptr<mp::schedule::base>,
+                                                       unsigned int>,
+                                                  shared_ptr<mp::schedule::base>> &s) {
+                                  return s.first == key;
+                                } );
+
+          if( found == shifts.end() ) {
+            shifts.emplace_back( key, make_shared<mp::schedule::shifted>( reached, original ) );
+            found = shifts.end() - 1;
+          }
+
+          config.schedule( found->second );
+        }
+
+        round.add( *(_models[m]), config );
+      }
+
+      auto results = round.run( training, validation );
+
+      rung_report rung;
+      rung.budget = budget;
+      rung.candidates = alive;
+
+      for(unsigned int k = 0; k < alive.size(); k++) {
+        unsigned int m = alive[k];
+        report.epochs[m] += results[k].epochs;
+        report.compute += epoch_cost[m] * results[k].epochs;
+        report.scores[m] = trainer::score( _evaluator.evaluate( *(_models[m]), validation ),
+                                           _criterion );
+        rung.scores.push_back( report.scores[m] );
+      }
+
+      stable_sort( alive.begin(), alive.end(), [&report](unsigned int a, unsigned int b) {
+        return report.scores[a] < report.scores[b];
+      } );
+
+      bool last = ( budget >= _maximum );
+      alive.resize( last ? 1 : max<unsigned int>( alive.size() / _reduction, 1 ) );
+      rung.survivors = alive;
+      report.rungs.push_back( rung );
+
+      if( last ) break;
+
+      // A single survivor gets the rest of the budget at once
+      budget = ( alive.size() == 1 ) ? _maximum : min( budget * _reduction, _maximum );
+    }
+
+    report.best = alive.front();
+    report.saved = 0.0;
+    if( report.exhaustive_compute > 0 ) {
+      report.saved = 1.0 - static_cast<double>( report.compute ) / report.exhaustive_compute;
+    }
+    return report;
+  }
+}
@@ -0,0 +1,170 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___HALVING___
+#define ___HALVING___
+#include <vector>
+#include "network.h"
+#include "data.h"
+#include "evaluation.h"
+#include "trainer.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Summary of one round of the successive halving.
+   * */
+  struct rung_report {
+    unsigned int budget;
+    vector<unsigned int> candidates;
+    vector<double> scores;
+    vector<unsigned int> survivors;
+  };
+
+  /**
+   * \brief Summary of a whole successive halving.
+   *
+   * The compute is counted in parameter updates: epochs times samples times weights of the
+   * network, which is what one epoch of backpropagation is proportional to.
+   * */
+  struct halving_report {
+    unsigned int best;
+    vector<rung_report> rungs;
+    vector<unsigned int> epochs;
+    vector<double> scores;
+    unsigned long long compute;
+    unsigned long long exhaustive_compute;
+    double saved;
+  };
+
+  /**
+   * \class successive_halving halving.h
+   * \brief It trains many candidate networks and drops the unpromising ones early.
+   *
+   * Every candidate is trained for the minimum budget of epochs and evaluated over the
+   * validation set. Only the best fraction 1 / reduction survives, and the survivors keep
+   * training until the budget multiplied by reduction, and so on, until one candidate is
+   * left or the maximum budget is reached. Each round is run by an engine, so compatible
+   * candidates are trained together.
+   *
+   * The trainer of each candidate gives the settings of every round, except the epochs.
+   * Its schedule is shifted, so a resumed candidate follows it from the epoch it reached.
+   * */
+  class successive_halving {
+    public:
+      /**
+       * It builds a successive halving from 1 to 27 epochs, keeping a third of the
+       * candidates in each round and watching the validation mse
+       * */
+      successive_halving();
+
+      /**
+       * It sets the epochs of the first round and the most epochs a candidate is trained
+       * \param minimum epochs of the first round
+       * \param maximum total epochs of the last round
+       * \throw invalid_argument if minimum is zero or greater than maximum
+       * */
+      void budget(const unsigned int &minimum, const unsigned int &maximum);
+
+      /**
+       * It sets how many times smaller the candidates set becomes, and bigger the budget, in
+       * each round
+       * \param factor reduction factor
+       * \throw invalid_argument if factor is lower than two
+       * */
+      void reduction(const unsigned int &factor);
+
+      /**
+       * It sets the validation metric used to rank the candidates
+       * \param c the watched metric
+       * */
+      void watched(const criterion &c);
+
+      /**
+       * It sets the number of threads of the engine
+       * \param threads number of threads
+       * */
+      void threads(const unsigned int &threads);
+
+      /**
+       * It sets the evaluator used over the validation set
+       * \param e the evaluator
+       * */
+      void validation_evaluator(const evaluator &e);
+
+      /**
+       * It returns the epochs of the first round
+       * \return the minimum budget
+       * */
+      unsigned int minimum() const;
+
+      /**
+       * It returns the most epochs a candidate is trained
+       * \return the maximum budget
+       * */
+      unsigned int maximum() const;
+
+      /**
+       * It returns the reduction factor
+       * \return the reduction factor
+       * */
+      unsigned int reduction() const;
+
+      /**
+       * It returns the number of threads of the engine
+       * \return the number of threads
+       * */
+      unsigned int threads() const;
+
+      /**
+       * It adds a candidate. The network must live until run returns.
+       * \param net    network of the candidate
+       * \param config trainer of the candidate
+       * \return the index of the candidate in the report
+       * */
+      unsigned int add(network &net, const trainer &config);
+
+      /**
+       * It returns the number of candidates
+       * \return the number of candidates
+       * */
+      unsigned int candidates() const;
+
+      /**
+       * It runs the successive halving. The networks are left as trained, so the best one is
+       * ready to use.
+       * \param training   samples used to train
+       * \param validation samples used to rank the candidates
+       * \return the summary of the rounds, and the compute saved against training every
+       * candidate for the maximum budget
+       * \throw invalid_argument if there are no candidates
+       * */
+      halving_report run(const data &training, const data &validation) const;
+
+    private:
+      unsigned int _minimum;
+      unsigned int _maximum;
+      unsigned int _reduction;
+      criterion _criterion;
+      unsigned int _threads;
+      evaluator _evaluator;
+      vector<network *> _models;
+      vector<trainer> _trainers;
+  };
+}
+#endif
@@ -0,0 +1,128 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "hogwild.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+namespace mp {
+  hogwild::hogwild() {
+    threads( thread::hardware_concurrency() );
+    _learning = 0.1;
+    _sparse = true;
+  }
+
+  hogwild::hogwild(const unsigned int &threads, const double &learning) {
+    this->threads( threads );
+    _learning = learning;
+    _sparse = true;
+  }
+
+  void hogwild::threads(const unsigned int &threads) {
+    _threads = max( threads, 1U );
+  }
+
+  void hogwild::learning_rate(const double &learning) {
+    _learning = learning;
+  }
+
+  void hogwild::sparse(const bool &sparse) {
+    _sparse = sparse;
+  }
+
+  unsigned int hogwild::threads() const {
+    return _threads;
+  }
+
+  double hogwild::learning_rate() const {
+    return _learning;
+  }
+
+  bool hogwild::sparse() const {
+    return _sparse;
+  }
+
+  unsigned long hogwild::train(network &net, const data &training, const unsigned int &epochs,
+                               const unsigned int &seed) const {
+    if(( training.inputs_length() != net.layer_inputs( 0 ) ) ||
+       ( training.outputs_length() != net.layer_size( net.layers() - 1 ) )) {
+      throw invalid_argument( "hogwild::train: the samples do not fit the network" );
+    }
+
+    auto initial = net.weights();
+    unsigned int size = initial.size();
+
+    unique_ptr<atomic<double>[]> shared( new atomic<double>[size] );
+    for(unsigned int i = 0; i < size; i++) shared[i].store( initial[i], memory_order_relaxed );
+
+    // The replicas are built up front, so a network that can not be copied fails here
+    vector<network> replicas;
+    replicas.reserve( _threads );
+    for(unsigned int t = 0; t < _threads; t++) replicas.push_back( net.replica() );
+
+    atomic<unsigned long> written( 0 );
+
+    auto work = [&](const unsigned int &t) {
+      auto &replica = replicas[t];
+      vector<double> current( size );
+      vector<unsigned int> order( training.elements() );
+      iota( order.begin(), order.end(), 0 );
+      unsigned long own = 0;
+
+      for(unsigned int epoch = 0; epoch < epochs; epoch++) {
+        // Every thread shuffles the same way and takes every _threads-th sample
+        mt19937 generator( seed + epoch );
+        shuffle( order.begin(), order.end(), generator );
+
+        for(unsigned int k = t; k < order.size(); k += _threads) {
+          for(unsigned int i = 0; i < size; i++) {
+            current[i] = shared[i].load( memory_order_relaxed );
+          }
+
+          replica.weights( current );
+          auto gradient = replica.gradients( *(training.input( order[k] ).lock()),
+                                             *(training.output( order[k] ).lock()) );
+
+          for(unsigned int i = 0; i < size; i++) {
+            if(( _sparse ) && ( gradient[i] == 0.0 )) continue;
+
+            double value = shared[i].load( memory_order_relaxed );
+            shared[i].store( value - _learning * gradient[i], memory_order_relaxed );
+            own++;
+          }
+        }
+      }
+
+      written.fetch_add( own, memory_order_relaxed );
+    };
+
+    vector<thread> workers;
+    for(unsigned int t = 1; t < _threads; t++) workers.emplace_back( work, t );
+    work( 0 );
+    for( auto &w : workers ) w.join();
+
+    for(unsigned int i = 0; i < size; i++) initial[i] = shared[i].load( memory_order_relaxed );
+    net.weights( initial );
+
+    return written.load();
+  }
+}
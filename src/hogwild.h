@@ -0,0 +1,113 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___HOGWILD___
+#define ___HOGWILD___
+#include <vector>
+#include "network.h"
+#include "data.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \class hogwild hogwild.h
+   * \brief It trains a network with asynchronous, lock-free stochastic gradient descent.
+   *
+   * Every thread trains a replica of the network (see network::replica) over its share of
+   * the samples. Before each sample the replica reads the shared weights, and afterwards it
+   * subtracts its gradient from them, without locks and without waiting for the other
+   * threads. The shared weights are relaxed atomics, so the reads and writes are not torn,
+   * but concurrent updates of the same weight may overwrite each other. With sparse updates
+   * only the weights with a gradient other than zero are written, which keeps the threads
+   * apart when the activations (ReLU, for instance) zero most of the gradient.
+   *
+   * The updates are plain stochastic gradient descent with the given learning rate: the
+   * optimizer of the network is not used. The result depends on the scheduling of the
+   * threads, except with a single thread.
+   * */
+  class hogwild {
+    public:
+      /**
+       * It builds a trainer with one thread per hardware thread, a learning rate of 0.1 and
+       * sparse updates
+       * */
+      hogwild();
+
+      /**
+       * It builds a trainer with the given number of threads and learning rate
+       * \param threads  number of threads
+       * \param learning learning rate
+       * */
+      hogwild(const unsigned int &threads, const double &learning);
+
+      /**
+       * It sets the number of threads (at least one)
+       * \param threads number of threads
+       * */
+      void threads(const unsigned int &threads);
+
+      /**
+       * It sets the learning rate
+       * \param learning learning rate
+       * */
+      void learning_rate(const double &learning);
+
+      /**
+       * It sets if only the weights with a gradient other than zero are written
+       * \param sparse true for sparse updates, false to write every weight
+       * */
+      void sparse(const bool &sparse);
+
+      /**
+       * It returns the number of threads
+       * \return the number of threads
+       * */
+      unsigned int threads() const;
+
+      /**
+       * It returns the learning rate
+       * \return the learning rate
+       * */
+      double learning_rate() const;
+
+      /**
+       * It checks if the updates are sparse
+       * \return true if only the weights with a gradient other than zero are written
+       * */
+      bool sparse() const;
+
+      /**
+       * It trains the network. Each epoch the samples are shuffled with the seed and dealt
+       * to the threads.
+       * \param net      the network to train, it gets the final shared weights
+       * \param training samples used to train
+       * \param epochs   number of passes over the samples
+       * \param seed     seed of the shuffle
+       * \return the number of weights written, added over all the samples
+       * \throw invalid_argument if the network has custom neurons, or the samples do not fit it
+       * */
+      unsigned long train(network &net, const data &training, const unsigned int &epochs,
+                          const unsigned int &seed = 0) const;
+
+    private:
+      unsigned int _threads;
+      double _learning;
+      bool _sparse;
+  };
+}
+#endif
@@ -0,0 +1,172 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "initializer.h"
+#include <thread>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+namespace mp {
+  const double two_pi = 6.283185307179586;
+
+  // Finalizer of splitmix64: a bijective mix of the 64 bits of its argument
+  static unsigned long long mix(unsigned long long value) {
+    value += 0x9e3779b97f4a7c15ULL;
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+  }
+
+  initializer::initializer() {
+    _method = scheme::xavier;
+    _seed = 0;
+    _range = 0.5;
+    _threads = 1;
+    _biases = false;
+  }
+
+  initializer::initializer(const scheme &method, const unsigned long long &seed) {
+    _method = method;
+    _seed = seed;
+    _range = 0.5;
+    _threads = 1;
+    _biases = false;
+  }
+
+  void initializer::method(const scheme &method) {
+    _method = method;
+  }
+
+  void initializer::seed(const unsigned long long &seed) {
+    _seed = seed;
+  }
+
+  void initializer::range(const double &range) {
+    _range = range;
+  }
+
+  void initializer::threads(const unsigned int &threads) {
+    _threads = max( threads, 1U );
+  }
+
+  void initializer::biases(const bool &enable) {
+    _biases = enable;
+  }
+
+  scheme initializer::method() const {
+    return _method;
+  }
+
+  unsigned long long initializer::seed() const {
+    return _seed;
+  }
+
+  double initializer::range() const {
+    return _range;
+  }
+
+  unsigned int initializer::threads() const {
+    return _threads;
+  }
+
+  bool initializer::biases() const {
+    return _biases;
+  }
+
+  double initializer::uniform(const unsigned long long &seed, const unsigned long long &counter) {
+    // The 53 high bits fill the mantissa of a double in [0, 1)
+    return (mix( mix( seed ) ^ counter ) >> 11) * (1.0 / 9007199254740992.0);
+  }
+
+  void initializer::initialize(network &net) const {
+    if( net.layer_inputs( 0 ) == 0 ) {
+      throw invalid_argument("initializer::initialize: the network has not been fed");
+    }
+
+    if( _biases ) {
+      for(unsigned int i = 0; i < net.layers(); i++) {
+        for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+          net.neuron(i, j).lock()->enable_bias();
+        }
+      }
+    }
+
+    vector<double> values( net.weights().size(), 0.0 );
+
+    // Start of the factors of every layer inside the weights() layout, and their scales
+    vector<unsigned long long> begin( net.layers() + 1, 0 );
+    vector<double> scale( net.layers(), 0.0 );
+    vector<unsigned int> factors( net.layers(), 0 );
+
+    for(unsigned int i = 0; i < net.layers(); i++) {
+      double fan_in = net.layer_inputs( i );
+      double fan_out = net.layer_size( i );
+
+      factors[i] = net.layer_size( i ) * net.layer_inputs( i );
+      begin[i + 1] = begin[i] + factors[i] + net.layer_size( i );
+
+      switch( _method ) {
+        case scheme::uniform:
+          scale[i] = _range;
+          break;
+        case scheme::xavier:
+          scale[i] = ( fan_in + fan_out > 0 ) ? sqrt( 6.0 / (fan_in + fan_out) ) : 0.0;
+          break;
+        case scheme::he:
+          scale[i] = ( fan_in > 0 ) ? sqrt( 2.0 / fan_in ) : 0.0;
+          break;
+      }
+    }
+
+    auto draw = [&](const unsigned long long &index, const unsigned int &layer) {
+      if( _method == scheme::he ) {
+        // Box-Muller over two consecutive values of the stream
+        double u1 = uniform( _seed, 2 * index );
+        double u2 = uniform( _seed, 2 * index + 1 );
+        return scale[layer] * sqrt( -2 * log( 1 - u1 ) ) * cos( two_pi * u2 );
+      }
+
+      return scale[layer] * (2 * uniform( _seed, index ) - 1);
+    };
+
+    auto worker = [&](const unsigned long long &first, const unsigned long long &last) {
+      unsigned int layer = 0;
+
+      for(unsigned long long w = first; w < last; w++) {
+        while( w >= begin[layer + 1] ) layer++;
+
+        // The biases of each layer follow its factors and stay at zero
+        if( w < begin[layer] + factors[layer] ) values[w] = draw( w, layer );
+      }
+    };
+
+    unsigned long long total = values.size();
+    unsigned int workers = min<unsigned long long>( _threads, max( total, 1ULL ) );
+    unsigned long long chunk = (total + workers - 1) / workers;
+    vector<thread> pool;
+
+    for(unsigned int t = 1; t < workers; t++) {
+      pool.push_back( thread( worker, min( t * chunk, total ), min( (t + 1) * chunk, total ) ) );
+    }
+
+    worker( 0, min( chunk, total ) );
+    for( auto &t : pool ) t.join();
+
+    net.weights( values );
+  }
+}
@@ -0,0 +1,146 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___INITIALIZER___
+#define ___INITIALIZER___
+#include <vector>
+#include "network.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Distributions used to draw the starting factors of a network.
+   * */
+  enum class scheme : unsigned int {
+    uniform = 0, //!< U(-range, range)
+    xavier,      //!< U(-l, l), l = sqrt(6 / (fan_in + fan_out)); suits sigmoid and tanh layers
+    he           //!< N(0, 2 / fan_in); suits ReLU layers
+  };
+
+  /**
+   * \class initializer initializer.h
+   * \brief It sets the factors of a network to seeded random values and the biases to zero.
+   *
+   * It can also enable the bias of every neuron first, so a network that was just fed is
+   * ready to be trained.
+   *
+   * Every factor is drawn from its own counter-based stream: the value of the factor with
+   * index i in the weights() layout only depends on the seed and on i. The layout is split
+   * in contiguous chunks, one per thread, so large networks are filled in parallel and the
+   * result is bit-identical regardless of the number of threads.
+   * */
+  class initializer {
+    public:
+      /**
+       * It builds a Xavier initializer with seed 0 that uses one thread
+       * */
+      initializer();
+
+      /**
+       * It builds an initializer with the given scheme and seed that uses one thread
+       * \param method distribution of the factors
+       * \param seed   seed of the streams
+       * */
+      initializer(const scheme &method, const unsigned long long &seed);
+
+      /**
+       * It sets the distribution of the factors
+       * \param method distribution of the factors
+       * */
+      void method(const scheme &method);
+
+      /**
+       * It sets the seed of the streams
+       * \param seed seed of the streams
+       * */
+      void seed(const unsigned long long &seed);
+
+      /**
+       * It sets the limit of the uniform scheme (0.5 by default)
+       * \param range factors are drawn from U(-range, range)
+       * */
+      void range(const double &range);
+
+      /**
+       * It sets the number of threads used to fill the network (at least one)
+       * \param threads number of threads
+       * */
+      void threads(const unsigned int &threads);
+
+      /**
+       * It sets if the bias of every neuron is enabled before drawing the factors (it is not
+       * by default)
+       * \param enable true to enable the biases
+       * */
+      void biases(const bool &enable);
+
+      /**
+       * It returns the distribution of the factors
+       * \return the scheme used
+       * */
+      scheme method() const;
+
+      /**
+       * It returns the seed of the streams
+       * \return the seed
+       * */
+      unsigned long long seed() const;
+
+      /**
+       * It returns the limit of the uniform scheme
+       * \return the range
+       * */
+      double range() const;
+
+      /**
+       * It returns the number of threads used to fill the network
+       * \return the number of threads
+       * */
+      unsigned int threads() const;
+
+      /**
+       * It returns if the bias of every neuron is enabled before drawing the factors
+       * \return true if the biases are enabled
+       * */
+      bool biases() const;
+
+      /**
+       * It draws new factors for every neuron of the network and sets the biases to zero
+       * \param net network to initialize
+       * \throw invalid_argument if the network has not been fed, so its first layer has no
+       * factors
+       * */
+      void initialize(network &net) const;
+
+      /**
+       * It returns the value of a counter-based stream
+       * \param seed    seed of the stream
+       * \param counter position inside the stream
+       * \return a value in [0, 1) that only depends on the seed and the counter
+       * */
+      static double uniform(const unsigned long long &seed, const unsigned long long &counter);
+
+    private:
+      scheme _method;
+      unsigned long long _seed;
+      double _range;
+      unsigned int _threads;
+      bool _biases;
+  };
+}
+#endif
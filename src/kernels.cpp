@@ -0,0 +1,385 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "kernels.h"
+#include "neuron/leaky_relu.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+namespace mp {
+  namespace kernels {
+    void forward(const double *weights, const double *bias, const double *inputs, double *outputs,
+                 const unsigned int &rows, const unsigned int &columns, const unsigned int &batch) {
+      for(unsigned int s = 0; s < batch; s++) {
+        const double * __restrict__ x = inputs + s * columns;
+        double * __restrict__ y = outputs + s * rows;
+
+        for(unsigned int r = 0; r < rows; r++) {
+          const double * __restrict__ w = weights + r * columns;
+          double sum = bias[r];
+
+          for(unsigned int c = 0; c < columns; c++) {
+            sum = multiply_add( x[c], w[c], sum );
+          }
+
+          y[r] = sum;
+        }
+      }
+    }
+
+    void forward_stacked(const double *const *parameters, const double *const *inputs,
+                         double *const *outputs, const unsigned int &models,
+                         const unsigned int &rows, const unsigned int &columns,
+                         const unsigned int &batch) {
+      for(unsigned int s = 0; s < batch; s++) {
+        for(unsigned int m = 0; m < models; m++) {
+          const double * __restrict__ x = inputs[m] + s * columns;
+          const double * __restrict__ bias = parameters[m] + rows * columns;
+          double * __restrict__ y = outputs[m] + s * rows;
+
+          for(unsigned int r = 0; r < rows; r++) {
+            const double * __restrict__ w = parameters[m] + r * columns;
+            double sum = bias[r];
+
+            for(unsigned int c = 0; c < columns; c++) {
+              sum = multiply_add( x[c], w[c], sum );
+            }
+
+            y[r] = sum;
+          }
+        }
+      }
+    }
+
+    void forward_sparse(const unsigned int *offsets, const unsigned int *indices,
+                        const double *values, const double *bias, const double *inputs,
+                        double *outputs, const unsigned int &rows, const unsigned int &columns,
+                        const unsigned int &batch) {
+      for(unsigned int s = 0; s < batch; s++) {
+        const double * __restrict__ x = inputs + s * columns;
+        double * __restrict__ y = outputs + s * rows;
+
+        for(unsigned int r = 0; r < rows; r++) {
+          double sum = bias[r];
+
+          for(unsigned int k = offsets[r]; k < offsets[r + 1]; k++) {
+            sum = multiply_add( x[indices[k]], values[k], sum );
+          }
+
+          y[r] = sum;
+        }
+      }
+    }
+
+    static uint32_t float_bits(const float &value) {
+      uint32_t bits;
+      memcpy( &bits, &value, sizeof(bits) );
+      return bits;
+    }
+
+    static float bits_float(const uint32_t &bits) {
+      float value;
+      memcpy( &value, &bits, sizeof(value) );
+      return value;
+    }
+
+    uint16_t to_bfloat16(const double &value) {
+      uint32_t bits = float_bits( static_cast<float>( value ) );
+
+      // NaN stays a quiet NaN instead of rounding into an infinity
+      if(( bits & 0x7fffffff ) > 0x7f800000 ) return ( bits >> 16 ) | 0x0040;
+
+      bits += 0x7fff + ( ( bits >> 16 ) & 1 );
+      return bits >> 16;
+    }
+
+    float from_bfloat16(const uint16_t &bits) {
+      return bits_float( static_cast<uint32_t>( bits ) << 16 );
+    }
+
+    uint16_t to_half(const double &value) {
+      uint32_t bits = float_bits( static_cast<float>( value ) );
+      uint16_t sign = ( bits >> 16 ) & 0x8000;
+      uint32_t magnitude = bits & 0x7fffffff;
+
+      if( magnitude > 0x7f800000 ) return sign | 0x7e00;
+      // From 65520 on everything rounds beyond the largest half, 65504
+      if( magnitude >= 0x477ff000 ) return sign | 0x7c00;
+
+      // Below 2^-14 the half is subnormal: a multiple of 2^-24, rounded in float
+      if( magnitude < 0x38800000 ) {
+        float scaled = bits_float( magnitude ) * 16777216.0f;
+        return sign | static_cast<uint16_t>( nearbyint( scaled ) );
+      }
+
+      // Rebias the exponent and round the 13 dropped bits of the mantissa to even
+      magnitude = magnitude - 0x38000000 + 0xfff + ( ( magnitude >> 13 ) & 1 );
+      return sign | static_cast<uint16_t>( magnitude >> 13 );
+    }
+
+    float from_half(const uint16_t &bits) {
+      uint32_t sign = static_cast<uint32_t>( bits & 0x8000 ) << 16;
+      uint32_t exponent = ( bits >> 10 ) & 0x1f;
+      uint32_t mantissa = bits & 0x3ff;
+
+      if( exponent == 0 ) {
+        float value = ldexp( static_cast<float>( mantissa ), -24 );
+        return sign ? -value : value;
+      }
+
+      if( exponent == 0x1f ) return bits_float( sign | 0x7f800000 | ( mantissa << 13 ) );
+      return bits_float( sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 ) );
+    }
+
+    void reduce(const double *values, uint16_t *reduced, const unsigned int &size,
+                const storage &format) {
+      for(unsigned int i = 0; i < size; i++) {
+        reduced[i] = ( format == storage::bfloat16 ) ? to_bfloat16( values[i] ) :
+                                                       to_half( values[i] );
+      }
+    }
+
+    /*
+     * It widens eight consecutive reduced factors to float. bfloat16 only needs a shift; with
+     * F16C the halves are converted by the hardware.
+     * */
+    template<storage format>
+    static inline void widen(const uint16_t *values, float *widened) {
+      if( format == storage::bfloat16 ) {
+        for(unsigned int k = 0; k < 8; k++) {
+          widened[k] = bits_float( static_cast<uint32_t>( values[k] ) << 16 );
+        }
+      } else {
+#ifdef __F16C__
+        __m128i packed = _mm_loadu_si128( reinterpret_cast<const __m128i *>( values ) );
+        _mm256_storeu_ps( widened, _mm256_cvtph_ps( packed ) );
+#else
+        for(unsigned int k = 0; k < 8; k++) widened[k] = from_half( values[k] );
+#endif
+      }
+    }
+
+    template<storage format>
+    static float reduced_dot(const uint16_t *weights, const float *inputs,
+                             const unsigned int &columns) {
+      float lanes[8] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+      float widened[8];
+      unsigned int c = 0;
+
+      for(; c + 8 <= columns; c += 8) {
+        widen<format>( weights + c, widened );
+        for(unsigned int k = 0; k < 8; k++) lanes[k] += widened[k] * inputs[c + k];
+      }
+
+      float sum = ( ( lanes[0] + lanes[1] ) + ( lanes[2] + lanes[3] ) ) +
+                  ( ( lanes[4] + lanes[5] ) + ( lanes[6] + lanes[7] ) );
+
+      for(; c < columns; c++) {
+        float factor = ( format == storage::bfloat16 ) ? from_bfloat16( weights[c] ) :
+                                                         from_half( weights[c] );
+        sum += factor * inputs[c];
+      }
+
+      return sum;
+    }
+
+    template<storage format>
+    static void forward_reduced(const uint16_t *weights, const double *bias,
+                                const double *inputs, double *outputs, const unsigned int &rows,
+                                const unsigned int &columns, const unsigned int &batch,
+                                float *x) {
+      for(unsigned int s = 0; s < batch; s++) {
+        const double *sample = inputs + s * columns;
+        double *y = outputs + s * rows;
+        for(unsigned int c = 0; c < columns; c++) x[c] = static_cast<float>( sample[c] );
+
+        for(unsigned int r = 0; r < rows; r++) {
+          y[r] = bias[r] + reduced_dot<format>( weights + r * columns, x, columns );
+        }
+      }
+    }
+
+    void forward_reduced(const uint16_t *weights, const storage &format, const double *bias,
+                         const double *inputs, double *outputs, const unsigned int &rows,
+                         const unsigned int &columns, const unsigned int &batch,
+                         float *widened) {
+      if( format == storage::bfloat16 ) {
+        forward_reduced<storage::bfloat16>(weights, bias, inputs, outputs, rows, columns, batch,
+                                           widened);
+      } else {
+        forward_reduced<storage::half>(weights, bias, inputs, outputs, rows, columns, batch,
+                                       widened);
+      }
+    }
+
+    void sigmoid(double *values, const unsigned int &size) {
+      for(unsigned int i = 0; i < size; i++) {
+        values[i] = 1/(1 + exp(-1 * values[i]));
+      }
+    }
+
+    void softmax(double *values, const unsigned int &rows, const unsigned int &batch) {
+      for(unsigned int s = 0; s < batch; s++) {
+        double * __restrict__ v = values + s * rows;
+        double maximum = v[0];
+        double sum = 0.0;
+
+        for(unsigned int r = 1; r < rows; r++) maximum = v[r] > maximum ? v[r] : maximum;
+
+        for(unsigned int r = 0; r < rows; r++) {
+          v[r] = exp( v[r] - maximum );
+          sum += v[r];
+        }
+
+        const double inverse = 1 / sum;
+        for(unsigned int r = 0; r < rows; r++) v[r] *= inverse;
+      }
+    }
+
+    void activate(const mp::neuron::activation_kind &kind, double *values,
+                  const unsigned int &size) {
+      double * __restrict__ v = values;
+      const double slope = mp::neuron::leaky_relu::slope;
+
+      switch( kind ) {
+        case mp::neuron::activation_kind::sigmoid:
+          sigmoid(values, size);
+          break;
+
+        case mp::neuron::activation_kind::hyperbolic_tangent:
+          for(unsigned int i = 0; i < size; i++) v[i] = tanh( v[i] );
+          break;
+
+        case mp::neuron::activation_kind::relu:
+          for(unsigned int i = 0; i < size; i++) v[i] = v[i] > 0 ? v[i] : 0.0;
+          break;
+
+        case mp::neuron::activation_kind::leaky_relu:
+          for(unsigned int i = 0; i < size; i++) v[i] = v[i] > 0 ? v[i] : slope * v[i];
+          break;
+
+        case mp::neuron::activation_kind::rbf:
+          for(unsigned int i = 0; i < size; i++) v[i] = exp( -v[i] * v[i] );
+          break;
+
+        default:
+          break;
+      }
+    }
+
+    void derive(const mp::neuron::activation_kind &kind, const double *sums, const double *outputs,
+                double *deltas, const unsigned int &size) {
+      const double * __restrict__ z = sums;
+      const double * __restrict__ o = outputs;
+      double * __restrict__ d = deltas;
+      const double slope = mp::neuron::leaky_relu::slope;
+
+      switch( kind ) {
+        case mp::neuron::activation_kind::sigmoid:
+          for(unsigned int i = 0; i < size; i++) d[i] *= o[i] * (1 - o[i]);
+          break;
+
+        case mp::neuron::activation_kind::hyperbolic_tangent:
+          for(unsigned int i = 0; i < size; i++) d[i] *= 1 - o[i] * o[i];
+          break;
+
+        case mp::neuron::activation_kind::relu:
+          for(unsigned int i = 0; i < size; i++) d[i] = o[i] > 0 ? d[i] : 0.0;
+          break;
+
+        case mp::neuron::activation_kind::leaky_relu:
+          for(unsigned int i = 0; i < size; i++) d[i] = o[i] > 0 ? d[i] : slope * d[i];
+          break;
+
+        case mp::neuron::activation_kind::rbf:
+          for(unsigned int i = 0; i < size; i++) d[i] *= -2 * z[i] * o[i];
+          break;
+
+        default:
+          break;
+      }
+    }
+
+    void backward(const double *weights, const double *deltas, double *previous,
+                  const unsigned int &rows, const unsigned int &columns, const unsigned int &batch) {
+      for(unsigned int s = 0; s < batch; s++) {
+        const double * __restrict__ d = deltas + s * rows;
+        double * __restrict__ p = previous + s * columns;
+
+        for(unsigned int c = 0; c < columns; c++) p[c] = 0.0;
+
+        for(unsigned int r = 0; r < rows; r++) {
+          const double * __restrict__ w = weights + r * columns;
+          const double delta = d[r];
+
+          for(unsigned int c = 0; c < columns; c++) {
+            p[c] += delta * w[c];
+          }
+        }
+      }
+    }
+
+    void backward_sigmoid(const double *weights, const double *deltas, const double *outputs,
+                          double *previous, const unsigned int &rows, const unsigned int &columns,
+                          const unsigned int &batch) {
+      for(unsigned int s = 0; s < batch; s++) {
+        const double * __restrict__ d = deltas + s * rows;
+        const double * __restrict__ o = outputs + s * columns;
+        double * __restrict__ p = previous + s * columns;
+
+        for(unsigned int c = 0; c < columns; c++) p[c] = 0.0;
+
+        for(unsigned int r = 0; r < rows; r++) {
+          const double * __restrict__ w = weights + r * columns;
+          const double delta = d[r];
+
+          for(unsigned int c = 0; c < columns; c++) {
+            p[c] += delta * w[c];
+          }
+        }
+
+        for(unsigned int c = 0; c < columns; c++) {
+          p[c] *= o[c] * (1 - o[c]);
+        }
+      }
+    }
+
+    void gradients(const double *deltas, const double *inputs, double *weight_gradients,
+                   double *bias_gradients, const unsigned int &rows, const unsigned int &columns,
+                   const unsigned int &batch, const double &scale) {
+      for(unsigned int s = 0; s < batch; s++) {
+        const double * __restrict__ d = deltas + s * rows;
+        const double * __restrict__ x = inputs + s * columns;
+
+        for(unsigned int r = 0; r < rows; r++) {
+          double * __restrict__ g = weight_gradients + r * columns;
+          const double delta = scale * d[r];
+
+          for(unsigned int c = 0; c < columns; c++) {
+            g[c] += delta * x[c];
+          }
+
+          bias_gradients[r] += delta;
+        }
+      }
+    }
+  }
+}
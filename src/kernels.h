@@ -0,0 +1,226 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___KERNELS___
+#define ___KERNELS___
+#include <cmath>
+#include <cstdint>
+#include "neuron/base.h"
+
+namespace mp {
+  /**
+   * \brief How the factors of a layer are stored for its forward pass.
+   * */
+  enum class storage : unsigned int {
+    float64 = 0, //!< The factors are used as they are
+    bfloat16,    //!< Upper half of a float: 8 bits of exponent and 7 of mantissa
+    half         //!< IEEE 754 binary16: 5 bits of exponent and 10 of mantissa
+  };
+
+  namespace kernels { // Dense kernels used by the network engine
+    /**
+     * It returns a * b + c. With hardware FMA it is always one fused operation, so every code
+     * path that uses it rounds the weighted sums in the same way, whatever the compiler decides
+     * to contract on its own.
+     * */
+    inline double multiply_add(const double &a, const double &b, const double &c) {
+#ifdef FP_FAST_FMA
+      return std::fma( a, b, c );
+#else
+      return a * b + c;
+#endif
+    }
+
+    /**
+     * It computes the weighted sums of a layer for a batch of samples:
+     * outputs[s][r] = bias[r] + sum_c weights[r][c] * inputs[s][c]
+     * \param weights row-major matrix of rows x columns factors
+     * \param bias    rows biases
+     * \param inputs  batch x columns inputs
+     * \param outputs batch x rows weighted sums
+     * */
+    void forward(const double *weights, const double *bias, const double *inputs, double *outputs,
+                 const unsigned int &rows, const unsigned int &columns, const unsigned int &batch);
+
+    /**
+     * Same as forward for a stack of models with the same shape, in one call. For each sample
+     * the weighted sums of every model are computed while the sample is still in cache, which
+     * pays off when the models share their inputs (the first layers of a stack).
+     * \param parameters pointer to the factors of each model, followed by its biases
+     * \param inputs     pointer to the batch x columns inputs of each model
+     * \param outputs    pointer to the batch x rows weighted sums of each model
+     * \param models     number of models in the stack
+     * */
+    void forward_stacked(const double *const *parameters, const double *const *inputs,
+                         double *const *outputs, const unsigned int &models,
+                         const unsigned int &rows, const unsigned int &columns,
+                         const unsigned int &batch);
+
+    /**
+     * Same as forward for a layer whose factors are stored in compressed sparse rows: the
+     * factors of row r are values[offsets[r]] to values[offsets[r + 1] - 1], in the columns
+     * given by indices. Only the stored factors are multiplied, in increasing column order,
+     * so a layer whose other factors are zero gets the weighted sums of forward, bit by bit.
+     * \param offsets rows + 1 positions of the first factor of each row
+     * \param indices column of each stored factor
+     * \param values  stored factors
+     * \param bias    rows biases
+     * \param inputs  batch x columns inputs
+     * \param outputs batch x rows weighted sums
+     * */
+    void forward_sparse(const unsigned int *offsets, const unsigned int *indices,
+                        const double *values, const double *bias, const double *inputs,
+                        double *outputs, const unsigned int &rows, const unsigned int &columns,
+                        const unsigned int &batch);
+
+    /**
+     * It rounds a value to the nearest bfloat16, through float, with ties to even
+     * \param value value to round
+     * \return the bits of the bfloat16
+     * */
+    uint16_t to_bfloat16(const double &value);
+
+    /**
+     * It returns the float value of a bfloat16
+     * \param bits bits of the bfloat16
+     * \return its exact float value
+     * */
+    float from_bfloat16(const uint16_t &bits);
+
+    /**
+     * It rounds a value to the nearest IEEE half, through float, with ties to even. Values
+     * beyond the half range become infinities, and the smallest ones subnormals or zeros.
+     * \param value value to round
+     * \return the bits of the half
+     * */
+    uint16_t to_half(const double &value);
+
+    /**
+     * It returns the float value of an IEEE half
+     * \param bits bits of the half
+     * \return its exact float value
+     * */
+    float from_half(const uint16_t &bits);
+
+    /**
+     * It rounds an array of factors to a 16-bit storage
+     * \param values  factors to round
+     * \param reduced it receives the rounded factors
+     * \param size    number of factors
+     * \param format  storage::bfloat16 or storage::half
+     * */
+    void reduce(const double *values, uint16_t *reduced, const unsigned int &size,
+                const storage &format);
+
+    /**
+     * Same as forward for factors stored with 16 bits. The factors are widened to float
+     * inside the dot product, eight at a time, and multiplied by the inputs rounded to float.
+     * The products add up in eight float lanes, and only the sum of each row goes back to
+     * double to add its bias.
+     * \param weights row-major matrix of rows x columns reduced factors
+     * \param format  storage of the factors, storage::bfloat16 or storage::half
+     * \param bias    rows biases
+     * \param inputs  batch x columns inputs
+     * \param outputs batch x rows weighted sums
+     * \param widened columns floats where each sample is rounded, so the kernel does not
+     * allocate
+     * */
+    void forward_reduced(const uint16_t *weights, const storage &format, const double *bias,
+                         const double *inputs, double *outputs, const unsigned int &rows,
+                         const unsigned int &columns, const unsigned int &batch,
+                         float *widened);
+
+    /**
+     * It applies the logistic function in place
+     * \param values values to transform
+     * \param size   number of values
+     * */
+    void sigmoid(double *values, const unsigned int &size);
+
+    /**
+     * It turns each sample of a batch into probabilities in place:
+     * values[s][r] = exp(values[s][r] - m) / sum_k exp(values[s][k] - m), m = max_k values[s][k]
+     * Subtracting the maximum keeps every exponent at or below zero, so it never overflows.
+     * \param values batch x rows weighted sums
+     * \param rows   values per sample
+     * \param batch  number of samples
+     * */
+    void softmax(double *values, const unsigned int &rows, const unsigned int &batch);
+
+    /**
+     * It applies an activation function in place. Custom activations are left untouched,
+     * since they can only be evaluated by their neurons.
+     * \param kind   activation to apply
+     * \param values weighted sums to transform into outputs
+     * \param size   number of values
+     * */
+    void activate(const mp::neuron::activation_kind &kind, double *values,
+                  const unsigned int &size);
+
+    /**
+     * It multiplies the deltas by the derivative of an activation:
+     * deltas[i] *= f'(sums[i]), written in terms of outputs[i] whenever it is possible.
+     * Custom activations are left untouched.
+     * \param kind    activation of the outputs
+     * \param sums    weighted sums of the neurons, only read by the rbf kind
+     * \param outputs outputs of the neurons
+     * \param deltas  deltas to scale
+     * \param size    number of values
+     * */
+    void derive(const mp::neuron::activation_kind &kind, const double *sums, const double *outputs,
+                double *deltas, const unsigned int &size);
+
+    /**
+     * It propagates the deltas of a layer to the layer before it:
+     * previous[s][c] = sum_r deltas[s][r] * weights[r][c]
+     * The rows of the weights are read contiguously and accumulated into the previous deltas,
+     * so there is no need to keep a transposed copy of the matrix.
+     * \param weights  row-major matrix of rows x columns factors
+     * \param deltas   batch x rows deltas of the layer
+     * \param previous batch x columns deltas of the layer before (output)
+     * */
+    void backward(const double *weights, const double *deltas, double *previous,
+                  const unsigned int &rows, const unsigned int &columns, const unsigned int &batch);
+
+    /**
+     * Same as backward, but the result of each sample is multiplied by the sigmoid derivative
+     * output * (1 - output) while it is still in cache.
+     * \param weights  row-major matrix of rows x columns factors
+     * \param deltas   batch x rows deltas of the layer
+     * \param outputs  batch x columns outputs of the layer before
+     * \param previous batch x columns deltas of the layer before (output)
+     * */
+    void backward_sigmoid(const double *weights, const double *deltas, const double *outputs,
+                          double *previous, const unsigned int &rows, const unsigned int &columns,
+                          const unsigned int &batch);
+
+    /**
+     * It accumulates the gradients of a layer for a batch of samples:
+     * weight_gradients[r][c] += scale * sum_s deltas[s][r] * inputs[s][c]
+     * bias_gradients[r] += scale * sum_s deltas[s][r]
+     * \param deltas           batch x rows deltas of the layer
+     * \param inputs           batch x columns inputs of the layer
+     * \param weight_gradients row-major rows x columns gradients
+     * \param bias_gradients   rows gradients
+     * \param scale            factor applied to every term (1 / batch for the mean)
+     * */
+    void gradients(const double *deltas, const double *inputs, double *weight_gradients,
+                   double *bias_gradients, const unsigned int &rows, const unsigned int &columns,
+                   const unsigned int &batch, const double &scale);
+  }
+}
+#endif
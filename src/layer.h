@@ -0,0 +1,81 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___LAYER___
+#define ___LAYER___
+#include <vector>
+#include <cstdint>
+#include "neuron/base.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Neurons of a layer that share the activation kind and the bias setting.
+   *
+   * The rows are kept in the layer order. When they are consecutive the kernels work on the
+   * outputs in place; otherwise the run is gathered into the layer scratch, transformed as a
+   * contiguous block and scattered back.
+   * */
+  struct run {
+    mp::neuron::activation_kind kind;
+    bool bias;
+    bool contiguous;
+    vector<unsigned int> rows;
+  };
+
+  /**
+   * \brief Contiguous view of a network layer used by the compiled network.
+   *
+   * The factors are stored row-major (one row per neuron, one column per input) and followed
+   * by the biases, so the whole layer is a single array that the optimizer can update in one
+   * pass. The gradients use the same layout. The outputs and deltas hold one row per sample,
+   * for up to capacity samples. All of the arrays live in the network arena.
+   * */
+  struct layer {
+    unsigned int rows;
+    unsigned int columns;
+    unsigned int capacity;
+
+    double *parameters;
+    double *gradients;
+    double *outputs;
+    double *deltas;
+
+    vector<unsigned char> bias_enabled;
+
+    // True when every neuron of the layer is a sigmoid, so the fused kernels can be used.
+    // Otherwise the activation and its derivative are applied run by run.
+    bool sigmoid;
+    vector<run> runs;
+    vector<const mp::neuron::base *> neurons;
+
+    // capacity x rows weighted sums, only kept when some run needs them for its derivative
+    double *sums;
+
+    // 3 x capacity x rows, only reserved when some run is not contiguous
+    double *scratch;
+
+    // Factors rounded to the 16-bit storage of the network, if any, for the forward pass.
+    // They are kept outside the arena and rounded again after every change of the parameters.
+    vector<uint16_t> reduced;
+
+    // columns floats where the forward pass over the reduced factors rounds each input sample
+    vector<float> widened;
+  };
+}
+#endif
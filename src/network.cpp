@@ -16,85 +16,766 @@
 //    along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "network.h"
+#include "kernels.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace mp {
+  /*
+   * It groups the neurons of a layer by activation kind and bias setting, in order of first
+   * appearance, and fills the per-row views of the layer.
+   * */
+  static void group(mp::layer &l, const vector<shared_ptr<base>> &neurons) {
+    l.runs.clear();
+    l.bias_enabled.resize( neurons.size() );
+    l.neurons.resize( neurons.size() );
+    l.sigmoid = true;
+
+    for(unsigned int j = 0; j < neurons.size(); j++) {
+      auto kind = neurons[j]->kind();
+      bool bias = neurons[j]->bias_enabled();
+
+      l.bias_enabled[j] = bias;
+      l.neurons[j] = neurons[j].get();
+      if( kind != activation_kind::sigmoid ) l.sigmoid = false;
+
+      unsigned int r = 0;
+      while(( r < l.runs.size() ) && (( l.runs[r].kind != kind ) || ( l.runs[r].bias != bias ))) {
+        r++;
+      }
+
+      if( r == l.runs.size() ) l.runs.push_back( { kind, bias, true, vector<unsigned int>() } );
+      l.runs[r].rows.push_back( j );
+    }
+
+    for( auto &current : l.runs ) {
+      unsigned int span = current.rows.back() - current.rows.front() + 1;
+      current.contiguous = ( span == current.rows.size() );
+    }
+  }
+
+  static bool keeps_sums(const mp::layer &l) {
+    for( auto &current : l.runs ) {
+      if( current.kind == activation_kind::rbf ) return true;
+    }
+
+    return false;
+  }
+
+  static bool scattered(const mp::layer &l) {
+    for( auto &current : l.runs ) {
+      if( not current.contiguous ) return true;
+    }
+
+    return false;
+  }
+
+  // Part of a compiled layer buffer that belongs to the samples from offset on
+  static double* rows_of(double *buffer, const unsigned int &offset, const unsigned int &rows) {
+    return buffer ? buffer + offset * rows : nullptr;
+  }
+
+  /*
+   * It turns the weighted sums of a batch into outputs, run by run. scratch must hold
+   * batch x rows values when some run is not contiguous.
+   * */
+  static void activate(const mp::layer &l, double *values, double *scratch,
+                       const unsigned int &batch) {
+    if(( l.runs.size() == 1 ) && ( l.runs[0].kind != activation_kind::custom )) {
+      kernels::activate(l.runs[0].kind, values, batch * l.rows);
+      return;
+    }
+
+    for( auto &current : l.runs ) {
+      unsigned int size = current.rows.size();
+
+      if( current.kind == activation_kind::custom ) {
+        for(unsigned int s = 0; s < batch; s++) {
+          for( auto r : current.rows ) {
+            values[s * l.rows + r] = l.neurons[r]->activation( values[s * l.rows + r] );
+          }
+        }
+      } else if( current.contiguous ) {
+        for(unsigned int s = 0; s < batch; s++) {
+          kernels::activate(current.kind, values + s * l.rows + current.rows[0], size);
+        }
+      } else {
+        for(unsigned int s = 0; s < batch; s++) {
+          for(unsigned int k = 0; k < size; k++) {
+            scratch[s * size + k] = values[s * l.rows + current.rows[k]];
+          }
+        }
+
+        kernels::activate(current.kind, scratch, batch * size);
+
+        for(unsigned int s = 0; s < batch; s++) {
+          for(unsigned int k = 0; k < size; k++) {
+            values[s * l.rows + current.rows[k]] = scratch[s * size + k];
+          }
+        }
+      }
+    }
+  }
+
+  /*
+   * It multiplies the deltas of a batch by the activation derivatives, run by run. sums is
+   * only read by rbf runs, and scratch must hold 3 x batch x rows values when some run is not
+   * contiguous.
+   * */
+  static void derive(const mp::layer &l, const double *sums, const double *outputs,
+                     double *deltas, double *scratch, const unsigned int &batch) {
+    if(( l.runs.size() == 1 ) && ( l.runs[0].kind != activation_kind::custom )) {
+      kernels::derive(l.runs[0].kind, sums, outputs, deltas, batch * l.rows);
+      return;
+    }
+
+    for( auto &current : l.runs ) {
+      unsigned int size = current.rows.size();
+      bool rbf = ( current.kind == activation_kind::rbf );
+
+      if( current.kind == activation_kind::custom ) {
+        for(unsigned int s = 0; s < batch; s++) {
+          for( auto r : current.rows ) {
+            deltas[s * l.rows + r] *= l.neurons[r]->derivative( outputs[s * l.rows + r] );
+          }
+        }
+      } else if( current.contiguous ) {
+        for(unsigned int s = 0; s < batch; s++) {
+          unsigned int offset = s * l.rows + current.rows[0];
+          kernels::derive(current.kind, rbf ? sums + offset : nullptr, outputs + offset,
+                          deltas + offset, size);
+        }
+      } else {
+        double *gathered = scratch + batch * size;
+        double *gathered_sums = scratch + 2 * batch * size;
+
+        for(unsigned int s = 0; s < batch; s++) {
+          for(unsigned int k = 0; k < size; k++) {
+            unsigned int index = s * l.rows + current.rows[k];
+            scratch[s * size + k] = outputs[index];
+            gathered[s * size + k] = deltas[index];
+            if( rbf ) gathered_sums[s * size + k] = sums[index];
+          }
+        }
+
+        kernels::derive(current.kind, gathered_sums, scratch, gathered, batch * size);
+
+        for(unsigned int s = 0; s < batch; s++) {
+          for(unsigned int k = 0; k < size; k++) {
+            deltas[s * l.rows + current.rows[k]] = gathered[s * size + k];
+          }
+        }
+      }
+    }
+  }
+
+  /*
+   * It builds a neuron of the given kind that keeps the factors and the bias of source. The
+   * neuron is placed in the network pool.
+   * */
+  static shared_ptr<base> convert(const activation_kind &kind, const base &source,
+                                  const shared_ptr<pool> &storage) {
+    switch( kind ) {
+      case activation_kind::linear:
+        return allocate_shared<linear>( pool_allocator<linear>( storage ), source );
+      case activation_kind::sigmoid:
+        return allocate_shared<sigmoid>( pool_allocator<sigmoid>( storage ), source );
+      case activation_kind::hyperbolic_tangent:
+        return allocate_shared<hyperbolic_tangent>( pool_allocator<hyperbolic_tangent>( storage ),
+                                                    source );
+      case activation_kind::relu:
+        return allocate_shared<relu>( pool_allocator<relu>( storage ), source );
+      case activation_kind::leaky_relu:
+        return allocate_shared<leaky_relu>( pool_allocator<leaky_relu>( storage ), source );
+      case activation_kind::rbf:
+        return allocate_shared<rbf>( pool_allocator<rbf>( storage ), source );
+      default:
+        throw invalid_argument("network::activation: custom neurons must be set one by one");
+    }
+  }
+
   network::network() {
+    _compiled = false;
+    _capacity = 32;
+    _checkpoint = 1;
+    _storage = storage::float64;
+    _batch_inputs = nullptr;
+    _pool = make_shared<pool>();
+    _stage = stage::activation;
+    _optimizer = make_shared<mp::optimizer::sgd>(0.9, 0.1);
     update_network_map(1, 1, 1);
   }
 
 
   network::network(const unsigned int &hidden_layers, const unsigned int &layer_size,
                    const unsigned int &output_size) {
+    _compiled = false;
+    _capacity = 32;
+    _checkpoint = 1;
+    _storage = storage::float64;
+    _batch_inputs = nullptr;
+    _pool = make_shared<pool>();
+    _stage = stage::activation;
+    _optimizer = make_shared<mp::optimizer::sgd>(0.9, 0.1);
     update_network_map(hidden_layers, layer_size, output_size);
   }
 
+  network::network(const network &other) : network( other.replica() ) {
+    _optimizer = other._optimizer->clone();
+  }
+
+  network& network::operator=(const network &other) {
+    if( this != &other ) *this = network( other );
+    return *this;
+  }
+
+  network network::replica() const {
+    network result;
+    result._inputs = _inputs;
+    result._stage = _stage;
+    result._capacity = _capacity;
+    result._checkpoint = _checkpoint;
+    result._storage = _storage;
+    result._hidden_layers.resize( _hidden_layers.size() );
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      auto &source = layer( i );
+      auto &target = ( i == layers() - 1 ) ? result._output_layer : result._hidden_layers[i];
+      target.resize( source.size() );
+
+      for(unsigned int j = 0; j < source.size(); j++) {
+        if( source[j]->kind() == activation_kind::custom ) {
+          throw invalid_argument("network::replica: custom neurons can not be copied");
+        }
+
+        target[j] = convert( source[j]->kind(), *(source[j]), result._pool );
+      }
+    }
+
+    result.fix_layer_inputs();
+    result._stats.resize( result.layers() );
+    if( not _compiled ) return result;
+
+    // The neurons keep the factors they had when this network was compiled, so the trained
+    // ones are taken from the arena
+    result.compile( _inputs.size(), _capacity );
+    for(unsigned int i = 0; i < layers(); i++) {
+      auto &l = _packed[i];
+      copy( l.parameters, l.parameters + l.rows * (l.columns + 1), result._packed[i].parameters );
+    }
+
+    result.round_weights();
+    return result;
+  }
+
   void network::feed(const vector<double> &inputs) {
-    unsigned int old_inputs_size = _inputs.size();
-    _inputs = inputs;
-    if( old_inputs_size != inputs.size() ) fix_layer_inputs( 0 );
+    if( _compiled ) {
+      if( inputs.size() != _inputs.size() ) {
+        throw invalid_argument("network::feed: the inputs do not fit the compiled network");
+      }
+
+      copy( inputs.begin(), inputs.end(), _inputs.begin() );
+    } else {
+      unsigned int old_inputs_size = _inputs.size();
+      _inputs = inputs;
+      if( old_inputs_size != inputs.size() ) fix_layer_inputs( 0 );
+    }
+  }
+
+  void network::compile(const unsigned int &inputs_size, const unsigned int &batch_capacity) {
+    release();
+
+    if( _inputs.size() != inputs_size ) _inputs.assign( inputs_size, 0.0 );
+    fix_layer_inputs();
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      if( layer_size( i ) == 0 ) {
+        throw invalid_argument("network::compile: every layer needs at least one neuron");
+      }
+    }
+
+    _capacity = max( batch_capacity, 1U );
+
+    _packed.resize( layers() );
+    for(unsigned int i = 0; i < layers(); i++) {
+      group( _packed[i], layer( i ) );
+    }
+
+    // With checkpoints the layers that are not kept write into shared buffers, one for each
+    // position inside a segment, and the deltas alternate between two buffers
+    bool checkpointed = _checkpoint > 1;
+    unsigned int slots = checkpointed ? min( _checkpoint - 1, layers() - 1 ) : 0;
+    unsigned int widest = 0;
+    unsigned int slot_rows = 0;
+    bool slot_sums = false;
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      widest = max( widest, layer_size( i ) );
+      if( stored( i ) ) continue;
+
+      slot_rows = max( slot_rows, layer_size( i ) );
+      if( keeps_sums( _packed[i] ) ) slot_sums = true;
+    }
+
+    size_t total = batch_values( _packed, _capacity, true );
+    for(unsigned int i = 0; i < layers(); i++) {
+      total += 2 * arena::footprint( layer_size( i ) * (layer_inputs( i ) + 1) );
+    }
+
+    _arena.reserve( total );
+    _batch_inputs = _arena.allocate( _capacity * inputs_size );
+
+    vector<double *> shared_deltas;
+    vector<double *> shared_outputs;
+    vector<double *> shared_sums;
+    if( checkpointed ) {
+      for(unsigned int d = 0; d < 2; d++) {
+        shared_deltas.push_back( _arena.allocate( _capacity * widest ) );
+      }
+
+      for(unsigned int p = 0; p < slots; p++) {
+        shared_outputs.push_back( _arena.allocate( _capacity * slot_rows ) );
+        if( slot_sums ) shared_sums.push_back( _arena.allocate( _capacity * slot_rows ) );
+      }
+    }
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      auto &l = _packed[i];
+      auto &neurons = layer( i );
+
+      l.rows = layer_size( i );
+      l.columns = layer_inputs( i );
+      l.capacity = _capacity;
+      l.parameters = _arena.allocate( l.rows * (l.columns + 1) );
+      l.gradients = _arena.allocate( l.rows * (l.columns + 1) );
+
+      if( stored( i ) ) {
+        l.outputs = _arena.allocate( _capacity * l.rows );
+        l.deltas = checkpointed ? shared_deltas[i % 2] : _arena.allocate( _capacity * l.rows );
+        l.sums = keeps_sums( l ) ? _arena.allocate( _capacity * l.rows ) : nullptr;
+      } else {
+        l.outputs = shared_outputs[i % _checkpoint];
+        l.deltas = shared_deltas[i % 2];
+        l.sums = keeps_sums( l ) ? shared_sums[i % _checkpoint] : nullptr;
+      }
+
+      l.scratch = scattered( l ) ? _arena.allocate( 3 * _capacity * l.rows ) : nullptr;
+
+      double *bias = l.parameters + l.rows * l.columns;
+      for(unsigned int j = 0; j < l.rows; j++) {
+        auto &factors = neurons[j]->factors();
+        copy( factors.begin(), factors.end(), l.parameters + j * l.columns );
+        bias[j] = neurons[j]->bias();
+      }
+    }
+
+    round_weights();
+    _stats.resize( layers() );
+    _compiled = true;
+  }
+
+  bool network::compiled() const {
+    return _compiled;
+  }
+
+  void network::checkpoint(const unsigned int &every) {
+    release();
+    _checkpoint = max( every, 1U );
+  }
+
+  unsigned int network::checkpoint() const {
+    return _checkpoint;
+  }
+
+  void network::weight_storage(const storage &format) {
+    _storage = format;
+    if( _compiled ) round_weights();
+  }
+
+  storage network::weight_storage() const {
+    return _storage;
+  }
+
+  size_t network::memory() const {
+    if( not _compiled ) return 0;
+
+    size_t bytes = _arena.capacity() * sizeof(double);
+    for( auto &l : _packed ) {
+      bytes += l.reduced.size() * sizeof(uint16_t) + l.widened.size() * sizeof(float);
+    }
+    return bytes;
+  }
+
+  size_t network::activation_memory(const unsigned int &batch) const {
+    unsigned int count = min( max( batch, 1U ), _capacity );
+    if( _compiled ) return batch_values( _packed, count, false ) * sizeof(double);
+
+    vector<mp::layer> grouped( layers() );
+    for(unsigned int i = 0; i < layers(); i++) {
+      group( grouped[i], layer( i ) );
+    }
+
+    return batch_values( grouped, count, false ) * sizeof(double);
+  }
+
+  void network::activation(const unsigned int &layer_index, const activation_kind &kind) {
+    if( kind == activation_kind::custom ) {
+      throw invalid_argument("network::activation: custom neurons must be set one by one");
+    }
+
+    release();
+
+    auto &neurons = ( layer_index == layers() - 1 ) ? _output_layer
+                                                    : _hidden_layers.at( layer_index );
+    for( auto &n : neurons ) {
+      if( n->kind() != kind ) n = convert( kind, *n, _pool );
+    }
+  }
+
+  void network::output_stage(const stage &output) {
+    _stage = output;
+  }
+
+  stage network::output_stage() const {
+    return _stage;
+  }
+
+  activation_kind network::activation(const unsigned int &layer_index) const {
+    auto &neurons = layer( layer_index );
+    auto kind = neurons.front()->kind();
+
+    for( auto &n : neurons ) {
+      if( n->kind() != kind ) return activation_kind::custom;
+    }
+
+    return kind;
   }
 
   void network::update_network_map(const unsigned int &hidden_layers,
                                    const unsigned int &layer_size,
                                    const unsigned int &output_size) {
+    release();
+
     _hidden_layers.resize( hidden_layers );
     _output_layer.resize( output_size );
 
-    for(unsigned int i = 0; i < hidden_layers; i++) {
-      auto layer = _hidden_layers.at( i );
-      layer.resize( layer_size );
-      _hidden_layers[i] = layer;
+    for( auto &hidden_layer : _hidden_layers ) {
+      hidden_layer.resize( layer_size );
     }
     fix_layer_inputs();
+    _stats.resize( layers() );
   }
 
   void network::neuron(const unsigned int &layer_index, const unsigned int &neuron_index,
                        const shared_ptr<base> &neuron) {
+    release();
+
     if( layer_index == layers() - 1 ) {
-      _output_layer[neuron_index] = neuron;
+      _output_layer.at( neuron_index ) = neuron;
     } else {
-      auto layer = _hidden_layers.at( layer_index );
-      layer[neuron_index] = neuron;
-      _hidden_layers[layer_index] = layer;
+      _hidden_layers.at( layer_index ).at( neuron_index ) = neuron;
+    }
+  }
+
+  void network::remove_neuron(const unsigned int &layer_index, const unsigned int &neuron_index) {
+    if( layer_index >= layers() - 1 ) {
+      throw invalid_argument("network::remove_neuron: only hidden neurons can be removed");
+    }
+
+    auto &neurons = _hidden_layers[layer_index];
+    if( neuron_index >= neurons.size() ) {
+      throw invalid_argument("network::remove_neuron: the neuron does not exist");
+    }
+
+    if( neurons.size() == 1 ) {
+      throw invalid_argument("network::remove_neuron: a layer needs at least one neuron");
+    }
+
+    release();
+    neurons.erase( neurons.begin() + neuron_index );
+
+    // The next layer loses the column of the neuron
+    auto &next = ( layer_index + 1 == layers() - 1 ) ? _output_layer
+                                                     : _hidden_layers[layer_index + 1];
+    for( auto &n : next ) {
+      unsigned int size = n->factors_size();
+
+      for(unsigned int f = neuron_index; f + 1 < size; f++) n->set_factor(f, n->factor( f + 1 ));
+      n->resize( size - 1 );
+    }
+  }
+
+  void network::insert_layer(const unsigned int &layer_index, const unsigned int &size) {
+    if( layer_index >= layers() ) {
+      throw invalid_argument("network::insert_layer: layers go before the output layer");
+    }
+
+    if( size == 0 ) {
+      throw invalid_argument("network::insert_layer: a layer needs at least one neuron");
     }
+
+    release();
+    _hidden_layers.insert( _hidden_layers.begin() + layer_index, vector<shared_ptr<base>>( size ) );
+    fix_layer_inputs();
+    _stats.resize( layers() );
   }
 
   void network::spread_out() {
-    for(unsigned int i = 0; i < layers(); i++) {
-      for(unsigned int j = 0; j < layer_size( i ); j++) {
-        if( i == 0 ) neuron(i, j).lock()->refresh( _inputs );
-        else neuron(i, j).lock()->refresh( layer( i - 1 ) );
+    ensure_compiled();
+    copy( _inputs.begin(), _inputs.end(), _batch_inputs );
+    forward_batch( 1 );
+  }
+
+  void network::apply_softmax() {
+    if( _outputs.empty() ) return;
+    kernels::softmax(_outputs.data(), _outputs.size(), 1);
+  }
+
+  void network::backpropagate(const vector<double> &inputs, const vector<double> &expected) {
+    vector<const vector<double> *> batch_inputs( 1, &inputs );
+    vector<const vector<double> *> batch_expected( 1, &expected );
+    backpropagate( batch_inputs, batch_expected );
+  }
+
+  void network::backpropagate(const vector<const vector<double> *> &inputs,
+                              const vector<const vector<double> *> &expected) {
+    if( inputs.empty() ) return;
+    if( inputs.size() != expected.size() ) {
+      throw invalid_argument("network::backpropagate: inputs and expected sizes differ");
+    }
+
+    feed( *(inputs.back()) );
+    ensure_compiled();
+    reset_neuron_changes();
+    _batch_outputs.clear();
+
+    unsigned int total = inputs.size();
+    for(unsigned int start = 0; start < total; start += _capacity) {
+      unsigned int count = min( _capacity, total - start );
+
+      load_batch( inputs, start, count );
+      forward_batch( count );
+      keep_outputs( count );
+      backward_batch( expected, start, count, 1.0 / total );
+    }
+
+    adjust_weights();
+  }
+
+  void network::backpropagate_stacked(const vector<network *> &models,
+                                     const vector<const vector<double> *> &inputs,
+                                     const vector<const vector<double> *> &expected) {
+    if(( models.empty() ) || ( inputs.empty() )) return;
+    if( inputs.size() != expected.size() ) {
+      throw invalid_argument("network::backpropagate_stacked: inputs and expected sizes differ");
+    }
+
+    unsigned int capacity = models[0]->_capacity;
+    for( auto model : models ) {
+      if( not models[0]->stackable( *model ) ) {
+        throw invalid_argument("network::backpropagate_stacked: the networks are not stackable");
       }
+
+      model->feed( *(inputs.back()) );
+      model->ensure_compiled();
+      model->reset_neuron_changes();
+      model->_batch_outputs.clear();
+      capacity = min( capacity, model->_capacity );
     }
 
-    _outputs.clear();
-    _outputs.reserve( _output_layer.size() );
+    unsigned int total = inputs.size();
+    for(unsigned int start = 0; start < total; start += capacity) {
+      unsigned int count = min( capacity, total - start );
+
+      for( auto model : models ) model->load_batch( inputs, start, count );
+      forward_stacked( models, count );
 
-    for( auto neuron : _output_layer ) {
-      _outputs.push_back( neuron->output() );
+      for( auto model : models ) {
+        model->keep_outputs( count );
+        model->backward_batch( expected, start, count, 1.0 / total );
+      }
     }
+
+    for( auto model : models ) model->adjust_weights();
   }
 
-  void network::apply_softmax() {
-    double sum = 0;
-    for(unsigned int i = 0; i < _outputs.size(); i++){
-      sum += _outputs.at( i );
+  void network::backpropagate_pipelined(const vector<const vector<double> *> &inputs,
+                                        const vector<const vector<double> *> &expected,
+                                        const unsigned int &stages,
+                                        const unsigned int &micro_batch) {
+    if( inputs.empty() ) return;
+    if( inputs.size() != expected.size() ) {
+      throw invalid_argument("network::backpropagate_pipelined: inputs and expected sizes differ");
+    }
+
+    if( micro_batch == 0 ) {
+      throw invalid_argument("network::backpropagate_pipelined: the micro-batch is empty");
     }
 
-    for(unsigned int i = 0; i < _outputs.size(); i++) {
-      _outputs[i] /= sum;
+    if( _checkpoint > 1 ) {
+      throw invalid_argument("network::backpropagate_pipelined: checkpoints are not supported");
     }
+
+    feed( *(inputs.back()) );
+    ensure_compiled();
+
+    // The stages can not throw, so the targets are checked before they start
+    for( auto target : expected ) {
+      if( target->size() != _packed.back().rows ) {
+        throw invalid_argument("network::backpropagate: expected outputs do not fit the output layer");
+      }
+    }
+
+    reset_neuron_changes();
+    _batch_outputs.clear();
+
+    auto bounds = pipeline_stages( stages );
+    unsigned int micro = min( micro_batch, _capacity );
+    unsigned int chunk = _capacity / micro * micro;
+    unsigned int total = inputs.size();
+    unsigned int count = 0;
+
+    for(unsigned int start = 0; start < total; start += chunk) {
+      count = min( chunk, total - start );
+
+      load_batch( inputs, start, count );
+      pipeline_batch( expected, start, count, micro, bounds, 1.0 / total );
+      keep_outputs( count );
+    }
+
+    auto &last = _packed.back();
+    _outputs.assign( last.outputs + (count - 1) * last.rows, last.outputs + count * last.rows );
+    adjust_weights();
   }
 
-  void network::backpropagate(const vector<double> &inputs, const vector<double> &expected) {
-    feed(inputs);
-    spread_out();
+  vector<unsigned int> network::pipeline_stages(const unsigned int &stages) const {
+    unsigned int count = min( max( stages, 1U ), layers() );
+    double total = 0.0;
+    for(unsigned int i = 0; i < layers(); i++) total += layer_size( i ) * (layer_inputs( i ) + 1.0);
+
+    // A stage ends when it reaches its share of the weights, or when each of the stages still
+    // to open needs one of the layers left
+    vector<unsigned int> bounds( 1, 0 );
+    double done = 0.0;
+    for(unsigned int i = 0; ( i + 1 < layers() ) && ( bounds.size() < count ); i++) {
+      done += layer_size( i ) * (layer_inputs( i ) + 1.0);
+      unsigned int left = layers() - 1 - i;
+      unsigned int missing = count - bounds.size();
+
+      if(( done >= total * bounds.size() / count ) || ( left == missing )) {
+        bounds.push_back( i + 1 );
+      }
+    }
+
+    bounds.push_back( layers() );
+    return bounds;
+  }
+
+  bool network::stackable(const network &other) const {
+    if(( _inputs.size() != other._inputs.size() ) || ( layers() != other.layers() )) return false;
+    if( _stage != other._stage ) return false;
+    if(( _storage != storage::float64 ) || ( other._storage != storage::float64 )) return false;
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      auto &mine = layer( i );
+      auto &theirs = other.layer( i );
+      if( mine.size() != theirs.size() ) return false;
+
+      for(unsigned int j = 0; j < mine.size(); j++) {
+        if( mine[j]->kind() != theirs[j]->kind() ) return false;
+        if( mine[j]->kind() == activation_kind::custom ) return false;
+        if( mine[j]->bias_enabled() != theirs[j]->bias_enabled() ) return false;
+      }
+    }
+
+    return true;
+  }
+
+  vector<double> network::gradients(const vector<double> &inputs, const vector<double> &expected) {
+    vector<const vector<double> *> batch_inputs( 1, &inputs );
+    vector<const vector<double> *> batch_expected( 1, &expected );
+
+    feed( inputs );
+    ensure_compiled();
     reset_neuron_changes();
-    update_deltas(expected);
-    update_neuron_factors();
+    load_batch( batch_inputs, 0, 1 );
+    forward_batch( 1 );
+    backward_batch( batch_expected, 0, 1, 1.0 );
+
+    vector<double> values;
+    for( auto &l : _packed ) {
+      values.insert( values.end(), l.gradients, l.gradients + l.rows * (l.columns + 1) );
+    }
+
+    return values;
+  }
+
+  vector<double> network::gradients(const vector<const vector<double> *> &inputs,
+                                    const vector<const vector<double> *> &expected) {
+    if( inputs.size() != expected.size() ) {
+      throw invalid_argument("network::gradients: inputs and expected sizes differ");
+    }
+
+    vector<double> values;
+    if( inputs.empty() ) {
+      values.assign( weights().size(), 0.0 );
+      return values;
+    }
+
+    feed( *(inputs.back()) );
+    ensure_compiled();
+    reset_neuron_changes();
+
+    unsigned int total = inputs.size();
+    for(unsigned int start = 0; start < total; start += _capacity) {
+      unsigned int count = min( _capacity, total - start );
+
+      load_batch( inputs, start, count );
+      forward_batch( count );
+      backward_batch( expected, start, count, 1.0 / total );
+    }
+
+    for( auto &l : _packed ) {
+      values.insert( values.end(), l.gradients, l.gradients + l.rows * (l.columns + 1) );
+    }
+
+    return values;
+  }
+
+  void network::apply_gradients(const vector<double> &values) {
+    ensure_compiled();
+
+    unsigned int size = 0;
+    for( auto &l : _packed ) size += l.rows * (l.columns + 1);
+
+    if( values.size() != size ) {
+      throw invalid_argument("network::apply_gradients: the gradient does not fit the weights");
+    }
+
+    auto source = values.begin();
+    for( auto &l : _packed ) {
+      unsigned int count = l.rows * (l.columns + 1);
+      copy( source, source + count, l.gradients );
+      source += count;
+
+      for( auto &current : l.runs ) {
+        if( current.bias ) continue;
+        for( auto r : current.rows ) l.gradients[l.rows * l.columns + r] = 0.0;
+      }
+    }
+
     adjust_weights();
   }
 
+  void network::optimizer(const shared_ptr<mp::optimizer::base> &opt) {
+    _optimizer = opt;
+  }
+
+  shared_ptr<mp::optimizer::base> network::optimizer() const {
+    return _optimizer;
+  }
+
   unsigned int network::layers() const {
     return _hidden_layers.size() + 1;
   }
@@ -105,31 +786,112 @@ namespace mp {
   }
 
   weak_ptr<base> network::neuron(const unsigned int &layer_index,
-                                 const unsigned int &neuron_index) const {
+                                 const unsigned int &neuron_index) {
+    release();
+
     if( layer_index == layers() - 1 ) return weak_ptr<base>( _output_layer.at( neuron_index ) );
     else return weak_ptr<base>( _hidden_layers.at( layer_index ).at( neuron_index ) );
   }
 
+  weak_ptr<const base> network::neuron(const unsigned int &layer_index,
+                                       const unsigned int &neuron_index) const {
+    return weak_ptr<const base>( layer( layer_index ).at( neuron_index ) );
+  }
+
+  unsigned int network::layer_inputs(const unsigned int &layer_index) const {
+    if( layer_index == 0 ) return _inputs.size();
+    else return layer_size( layer_index - 1 );
+  }
+
+  vector<double> network::weights() const {
+    vector<double> values;
+
+    if( _compiled ) {
+      for( auto &l : _packed ) {
+        values.insert( values.end(), l.parameters, l.parameters + l.rows * (l.columns + 1) );
+      }
+
+      return values;
+    }
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      for( auto &n : layer( i ) ) {
+        values.insert( values.end(), n->factors().begin(), n->factors().end() );
+      }
+
+      for( auto &n : layer( i ) ) {
+        values.push_back( n->bias() );
+      }
+    }
+
+    return values;
+  }
+
+  void network::weights(const vector<double> &values) {
+    unsigned int size = 0;
+    for(unsigned int i = 0; i < layers(); i++) {
+      for( auto &n : layer( i ) ) size += n->factors_size() + 1;
+    }
+
+    if( values.size() != size ) {
+      throw invalid_argument("network::weights: the values do not fit the network");
+    }
+
+    unsigned int position = 0;
+
+    if( _compiled ) {
+      for( auto &l : _packed ) {
+        unsigned int factors = l.rows * l.columns;
+        copy( values.begin() + position, values.begin() + position + factors, l.parameters );
+        position += factors;
+
+        for(unsigned int j = 0; j < l.rows; j++, position++) {
+          if( l.bias_enabled[j] ) l.parameters[l.rows * l.columns + j] = values[position];
+        }
+      }
+
+      round_weights();
+      return;
+    }
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      for( auto &n : layer( i ) ) {
+        for(unsigned int f = 0; f < n->factors_size(); f++) {
+          n->set_factor(f, values[position++]);
+        }
+      }
+
+      for( auto &n : layer( i ) ) {
+        n->set_bias( values[position++] );
+      }
+    }
+  }
+
+  stats network::statistics() const {
+    return _stats;
+  }
+
+  void network::reset_statistics() {
+    _stats.reset();
+  }
+
   vector<double> network::output() const {
     return _outputs;
   }
 
-  void network::fix_layer_inputs(const unsigned int &layer) {
-    if( layer == 0 ) {
-      auto before_size = _inputs.size();
+  vector<double> network::batch_outputs() const {
+    return _batch_outputs;
+  }
 
-      for(unsigned int i = 0; i < layer_size( layer ); i++) {
-        auto n = neuron( layer, i ).lock();
-        if(( n ) && ( n->factors_size() != before_size )) n->resize( before_size );
-        else if( not n ) neuron(layer, i, shared_ptr<base>(new sigmoid( before_size, false )));
-      }
-    } else {
-      auto before_size = layer_size( layer - 1 );
+  void network::fix_layer_inputs(const unsigned int &layer_index) {
+    auto before_size = layer_inputs( layer_index );
+    auto &neurons = ( layer_index == layers() - 1 ) ? _output_layer : _hidden_layers[layer_index];
 
-      for(unsigned int i = 0; i < layer_size( layer ); i++) {
-        auto n = neuron( layer, i ).lock();
-        if(( n ) && ( n->factors_size() != before_size ) ) n->resize( before_size );
-        else if( not n ) neuron( layer, i, shared_ptr<base>( new sigmoid( before_size, false ) ) );
+    for( auto &n : neurons ) {
+      if( not n ) {
+        n = allocate_shared<sigmoid>( pool_allocator<sigmoid>( _pool ), before_size, false );
+      } else if( n->factors_size() != before_size ) {
+        n->resize( before_size );
       }
     }
   }
@@ -140,6 +902,91 @@ namespace mp {
     return _outputs;
   }
 
+  void network::predict(const vector<const vector<double> *> &inputs,
+                        vector<vector<double>> &outputs) const {
+    unsigned int batch = inputs.size();
+    vector<double> current( batch * _inputs.size() );
+    vector<double> next;
+    vector<double> parameters;
+    vector<uint16_t> reduced;
+    vector<double> scratch;
+    vector<float> widened;
+    mp::layer editable;
+
+    for(unsigned int s = 0; s < batch; s++) {
+      if( inputs[s]->size() != _inputs.size() ) {
+        throw invalid_argument("network::predict: the sample does not fit the layer inputs");
+      }
+
+      copy( inputs[s]->begin(), inputs[s]->end(), current.begin() + s * _inputs.size() );
+    }
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      unsigned int rows = layer_size( i );
+      unsigned int columns = layer_inputs( i );
+      auto &neurons = layer( i );
+      const double *weights;
+      const uint16_t *reduced_weights = nullptr;
+      const mp::layer *grouped;
+
+      // The editable network is packed on the fly, so both states share the same kernels
+      if( _compiled ) {
+        weights = _packed[i].parameters;
+        reduced_weights = _packed[i].reduced.data();
+        grouped = &_packed[i];
+      } else {
+        editable.rows = rows;
+        group( editable, neurons );
+        grouped = &editable;
+
+        parameters.resize( rows * (columns + 1) );
+        for(unsigned int j = 0; j < rows; j++) {
+          if( neurons[j]->factors_size() != columns ) {
+            throw invalid_argument("network::predict: the sample does not fit the layer inputs");
+          }
+
+          copy( neurons[j]->factors().begin(), neurons[j]->factors().end(),
+                parameters.begin() + j * columns );
+          parameters[rows * columns + j] = neurons[j]->bias();
+        }
+
+        weights = parameters.data();
+
+        if( _storage != storage::float64 ) {
+          reduced.resize( rows * columns );
+          kernels::reduce(weights, reduced.data(), rows * columns, _storage);
+          reduced_weights = reduced.data();
+        }
+      }
+
+      next.resize( batch * rows );
+      if( _storage == storage::float64 ) {
+        kernels::forward(weights, weights + rows * columns, current.data(), next.data(), rows,
+                         columns, batch);
+      } else {
+        widened.resize( max( widened.size(), (size_t) columns ) );
+        kernels::forward_reduced(reduced_weights, _storage, weights + rows * columns,
+                                 current.data(), next.data(), rows, columns, batch,
+                                 widened.data());
+      }
+
+      if(( i == layers() - 1 ) && ( _stage == stage::softmax )) {
+        kernels::softmax(next.data(), rows, batch);
+      } else {
+        scratch.resize( batch * rows );
+        activate(*grouped, next.data(), scratch.data(), batch);
+      }
+
+      current.swap( next );
+    }
+
+    unsigned int rows = layer_size( layers() - 1 );
+    outputs.resize( batch );
+    for(unsigned int s = 0; s < batch; s++) {
+      outputs[s].assign( current.begin() + s * rows, current.begin() + (s + 1) * rows );
+    }
+  }
+
   void network::fix_layer_inputs() {
     for(unsigned int i = 0; i < layers(); i++) {
       fix_layer_inputs( i );
@@ -151,70 +998,373 @@ namespace mp {
     else return _hidden_layers.at( index );
   }
 
-  void network::reset_neuron_changes() {
+  void network::ensure_compiled() {
+    if( not _compiled ) compile( _inputs.size(), _capacity );
+  }
+
+  void network::release() {
+    if( not _compiled ) return;
+
     for(unsigned int i = 0; i < layers(); i++) {
-      for(unsigned int j = 0; j < layer_size( i ); j++) {
-        neuron(i, j).lock()->reset_changes();
+      auto &l = _packed[i];
+      auto &neurons = layer( i );
+      const double *bias = l.parameters + l.rows * l.columns;
+
+      for(unsigned int j = 0; j < l.rows; j++) {
+        for(unsigned int f = 0; f < l.columns; f++) {
+          neurons[j]->set_factor(f, l.parameters[j * l.columns + f]);
+        }
+
+        neurons[j]->set_bias( bias[j] );
+        neurons[j]->set_delta( l.deltas[j] );
       }
     }
+
+    _compiled = false;
   }
 
-  void network::update_deltas(const vector<double> &expected) {
-    update_output_deltas(expected);
-    update_hidden_deltas();
+  void network::load_batch(const vector<const vector<double> *> &inputs, const unsigned int &start,
+                           const unsigned int &count) {
+    unsigned int columns = _inputs.size();
+
+    for(unsigned int s = 0; s < count; s++) {
+      auto &sample = *(inputs[start + s]);
+      if( sample.size() != columns ) {
+        throw invalid_argument("network::backpropagate: the inputs do not fit the compiled network");
+      }
+
+      copy( sample.begin(), sample.end(), _batch_inputs + s * columns );
+    }
+  }
+
+  void network::keep_outputs(const unsigned int &batch) {
+    auto &last = _packed.back();
+    _batch_outputs.insert( _batch_outputs.end(), last.outputs, last.outputs + batch * last.rows );
   }
 
-  void network::update_output_deltas(const vector<double> &expected) {
-    for(unsigned int i = 0; ((i < expected.size()) || (i < _output_layer.size())); i++) {
-      auto neuron = _output_layer.at( i );
+  void network::forward_batch(const unsigned int &batch) {
+    for(unsigned int i = 0; i < layers(); i++) forward_layer(i, 0, batch);
 
-      double delta_value = -( expected.at(i) - neuron->output() ) * neuron->output();
-      delta_value *= (1 - neuron->output());
+    auto &last = _packed.back();
+    _outputs.assign( last.outputs + (batch - 1) * last.rows, last.outputs + batch * last.rows );
+  }
 
-      neuron->set_delta( delta_value );
+  void network::forward_layer(const unsigned int &index, const unsigned int &offset,
+                              const unsigned int &batch) {
+    auto &l = _packed[index];
+    const double *inputs = ( index == 0 ) ? _batch_inputs + offset * _inputs.size() :
+                                            _packed[index - 1].outputs + offset * l.columns;
+
+    MP_STATS_SCOPE(_stats, index, phase::forward,
+                   (2ULL * l.rows * l.columns + 4ULL * l.rows) * batch,
+                   8ULL * (l.rows * (l.columns + 1) + (l.columns + l.rows) * batch));
+
+    if( _storage == storage::float64 ) {
+      kernels::forward(l.parameters, l.parameters + l.rows * l.columns, inputs,
+                       l.outputs + offset * l.rows, l.rows, l.columns, batch);
+    } else {
+      kernels::forward_reduced(l.reduced.data(), _storage, l.parameters + l.rows * l.columns,
+                               inputs, l.outputs + offset * l.rows, l.rows, l.columns, batch,
+                               l.widened.data());
     }
+
+    activate_layer(index, offset, batch);
   }
 
-  void network::update_hidden_deltas() {
-    for(unsigned int h = layers() - 2; h < layers() - 1; h--) {
-      for(unsigned int n = 0; n < layer_size( h ); n++) {
-        auto hide_neuron = neuron(h, n).lock();
-        double delta = 0;
+  bool network::stored(const unsigned int &index) const {
+    if(( _checkpoint < 2 ) || ( index == layers() - 1 )) return true;
+    return (index + 1) % _checkpoint == 0;
+  }
 
-        for(unsigned int i = 0; i < layer_size( h + 1 ); i++) {
-          auto next = neuron(h + 1, i).lock();
-          delta += (next->delta() * next->factor(i));
-        }
+  size_t network::batch_values(const vector<mp::layer> &grouped, const unsigned int &count,
+                               const bool &padded) const {
+    auto piece = [&padded](const size_t &size) { return padded ? arena::footprint( size ) : size; };
+
+    // The layers that are not kept share the checkpoint buffers, see compile()
+    bool checkpointed = _checkpoint > 1;
+    unsigned int slots = checkpointed ? min( _checkpoint - 1, layers() - 1 ) : 0;
+    unsigned int widest = 0;
+    unsigned int slot_rows = 0;
+    bool slot_sums = false;
+    size_t total = piece( count * _inputs.size() );
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      unsigned int rows = layer_size( i );
+      widest = max( widest, rows );
+      if( scattered( grouped[i] ) ) total += piece( 3 * count * rows );
 
-        delta *= hide_neuron->output() * (1 - hide_neuron->output());
-        hide_neuron->set_delta(delta);
+      if( not stored( i ) ) {
+        slot_rows = max( slot_rows, rows );
+        if( keeps_sums( grouped[i] ) ) slot_sums = true;
+        continue;
       }
+
+      total += piece( count * rows );
+      if( not checkpointed ) total += piece( count * rows );
+      if( keeps_sums( grouped[i] ) ) total += piece( count * rows );
+    }
+
+    if( checkpointed ) {
+      total += 2 * piece( count * widest );
+      total += slots * piece( count * slot_rows ) * ( slot_sums ? 2 : 1 );
     }
+
+    return total;
   }
 
-  void network::update_neuron_factors() {
-    for(unsigned int i = 0; i < layers(); i++) {
-      for(unsigned int j = 0; j < layer_size( i ); j++) {
-        auto hide_neuron = neuron(i, j).lock();
+  void network::activate_layer(const unsigned int &index, const unsigned int &offset,
+                               const unsigned int &batch) {
+    auto &l = _packed[index];
+    double *outputs = l.outputs + offset * l.rows;
+
+    if(( index == layers() - 1 ) && ( _stage == stage::softmax )) {
+      kernels::softmax(outputs, l.rows, batch);
+    } else {
+      if( l.sums ) copy( outputs, outputs + batch * l.rows, l.sums + offset * l.rows );
+      activate(l, outputs, rows_of( l.scratch, offset, 3 * l.rows ), batch);
+    }
+  }
+
+  void network::forward_stacked(const vector<network *> &models, const unsigned int &batch) {
+    unsigned int count = models.size();
+    auto &first = *(models[0]);
+    vector<const double *> parameters( count );
+    vector<const double *> inputs( count );
+    vector<double *> outputs( count );
+
+    for(unsigned int i = 0; i < first.layers(); i++) {
+      auto &l = first._packed[i];
+
+      for(unsigned int m = 0; m < count; m++) {
+        parameters[m] = models[m]->_packed[i].parameters;
+        outputs[m] = models[m]->_packed[i].outputs;
+
+        // The first layers of all the models read the same copy of the batch
+        inputs[m] = ( i == 0 ) ? first._batch_inputs : models[m]->_packed[i - 1].outputs;
+      }
+
+      kernels::forward_stacked(parameters.data(), inputs.data(), outputs.data(), count, l.rows,
+                               l.columns, batch);
+
+      for( auto model : models ) model->activate_layer(i, 0, batch);
+    }
+
+    for( auto model : models ) {
+      auto &last = model->_packed.back();
+      model->_outputs.assign( last.outputs + (batch - 1) * last.rows,
+                              last.outputs + batch * last.rows );
+    }
+  }
+
+  void network::pipeline_batch(const vector<const vector<double> *> &expected,
+                               const unsigned int &start, const unsigned int &batch,
+                               const unsigned int &micro_batch, const vector<unsigned int> &bounds,
+                               const double &scale) {
+    unsigned int stages = bounds.size() - 1;
+    unsigned int micro_batches = (batch + micro_batch - 1) / micro_batch;
+
+    // Micro-batches that each stage has finished, forward and backward
+    vector<unsigned int> forwarded( stages, 0 );
+    vector<unsigned int> backwarded( stages, 0 );
+    mutex progress_lock;
+    condition_variable progress;
+
+    auto wait = [&](const vector<unsigned int> &done, const unsigned int &stage,
+                    const unsigned int &count) {
+      unique_lock<mutex> guard( progress_lock );
+      progress.wait( guard, [&]() { return done[stage] >= count; } );
+    };
+
+    auto signal = [&](vector<unsigned int> &done, const unsigned int &stage,
+                      const unsigned int &count) {
+      {
+        lock_guard<mutex> guard( progress_lock );
+        done[stage] = count;
+      }
+
+      progress.notify_all();
+    };
+
+    // Each layer belongs to one stage, so its gradients add the micro-batches in order
+    auto work = [&](const unsigned int &s) {
+      for(unsigned int m = 0; m < micro_batches; m++) {
+        unsigned int offset = m * micro_batch;
+        unsigned int size = min( micro_batch, batch - offset );
 
-        for(unsigned int f = 0; f < hide_neuron->factors_size(); f++) {
-          if( i == 0 ) { // Between input and first hidden layer
-            hide_neuron->add_factor_change(f, hide_neuron->delta() * _inputs.at(f));
-          } else { // Between hidden layers
-            auto before_neuron = neuron( i - 1, j ).lock();
-            hide_neuron->add_factor_change(f, hide_neuron->delta() * before_neuron->output());
+        if( s > 0 ) wait( forwarded, s - 1, m + 1 );
+        for(unsigned int i = bounds[s]; i < bounds[s + 1]; i++) forward_layer(i, offset, size);
+        signal( forwarded, s, m + 1 );
+      }
+
+      for(unsigned int m = 0; m < micro_batches; m++) {
+        unsigned int offset = m * micro_batch;
+        unsigned int size = min( micro_batch, batch - offset );
+
+        if( s + 1 < stages ) wait( backwarded, s + 1, m + 1 );
+        for(unsigned int h = bounds[s + 1] - 1; ( h >= bounds[s] ) && ( h < bounds[s + 1] ); h--) {
+          if( h == layers() - 1 ) {
+            update_output_deltas(expected, start + offset, offset, size);
+          } else {
+            update_hidden_deltas(h, offset, size);
           }
+
+          update_neuron_factors(h, offset, size, scale);
         }
+        signal( backwarded, s, m + 1 );
+      }
+    };
+
+    vector<thread> workers;
+    for(unsigned int s = 1; s < stages; s++) workers.emplace_back( work, s );
+    work( 0 );
+
+    for( auto &worker : workers ) worker.join();
+  }
+
+  void network::reset_neuron_changes() {
+    for( auto &l : _packed ) {
+      fill( l.gradients, l.gradients + l.rows * (l.columns + 1), 0.0 );
+    }
+  }
+
+  void network::update_deltas(const vector<const vector<double> *> &expected,
+                              const unsigned int &start, const unsigned int &batch) {
+    update_output_deltas(expected, start, 0, batch);
+    update_hidden_deltas(batch);
+  }
+
+  void network::update_output_deltas(const vector<const vector<double> *> &expected,
+                                     const unsigned int &start, const unsigned int &offset,
+                                     const unsigned int &batch) {
+    auto &l = _packed.back();
+    double *outputs = l.outputs + offset * l.rows;
+    double *deltas = l.deltas + offset * l.rows;
+
+    MP_STATS_SCOPE(_stats, layers() - 1, phase::output_deltas,
+                   4ULL * l.rows * batch, 8ULL * 3 * l.rows * batch);
+
+    for(unsigned int s = 0; s < batch; s++) {
+      auto &target = *(expected[start + s]);
+      if( target.size() != l.rows ) {
+        throw invalid_argument("network::backpropagate: expected outputs do not fit the output layer");
+      }
+
+      for(unsigned int r = 0; r < l.rows; r++) {
+        deltas[s * l.rows + r] = -( target[r] - outputs[s * l.rows + r] );
+      }
+    }
+
+    // With the softmax stage p - y is already the cross-entropy delta of the weighted sums
+    if( _stage != stage::softmax ) {
+      derive(l, rows_of( l.sums, offset, l.rows ), outputs, deltas,
+             rows_of( l.scratch, offset, 3 * l.rows ), batch);
+    }
+  }
+
+  void network::update_hidden_deltas(const unsigned int &batch) {
+    for(unsigned int h = layers() - 2; h < layers() - 1; h--) update_hidden_deltas(h, 0, batch);
+  }
+
+  void network::update_hidden_deltas(const unsigned int &index, const unsigned int &offset,
+                                     const unsigned int &batch) {
+    auto &current = _packed[index];
+    auto &next = _packed[index + 1];
+    double *outputs = current.outputs + offset * current.rows;
+    double *deltas = current.deltas + offset * current.rows;
+    const double *next_deltas = next.deltas + offset * next.rows;
+
+    MP_STATS_SCOPE(_stats, index, phase::hidden_deltas,
+                   (2ULL * next.rows * next.columns + 3ULL * current.rows) * batch,
+                   8ULL * (next.rows * next.columns + 3 * current.rows * batch));
+
+    if( current.sigmoid ) {
+      kernels::backward_sigmoid(next.parameters, next_deltas, outputs, deltas, next.rows,
+                                next.columns, batch);
+    } else {
+      kernels::backward(next.parameters, next_deltas, deltas, next.rows, next.columns, batch);
+      derive(current, rows_of( current.sums, offset, current.rows ), outputs, deltas,
+             rows_of( current.scratch, offset, 3 * current.rows ), batch);
+    }
+  }
+
+  void network::backward_batch(const vector<const vector<double> *> &expected,
+                               const unsigned int &start, const unsigned int &batch,
+                               const double &scale) {
+    if( _checkpoint < 2 ) {
+      update_deltas(expected, start, batch);
+      update_neuron_factors(batch, scale);
+      return;
+    }
+
+    // The segments go from the back: the forward pass has just left the last one in the shared
+    // buffers, the others are computed again from the kept layer before them. Each layer takes
+    // its gradients before the deltas of the layer before it reuse the buffer of the next one.
+    unsigned int last = layers() - 1;
+    update_output_deltas(expected, start, 0, batch);
+
+    for(unsigned int end = last; end < layers(); ) {
+      unsigned int first = end - end % _checkpoint;
+      if( end != last ) {
+        for(unsigned int i = first; i < end; i++) forward_layer(i, 0, batch);
+      }
+
+      for(unsigned int h = end; ( h >= first ) && ( h <= end ); h--) {
+        if( h != last ) update_hidden_deltas(h, 0, batch);
+        update_neuron_factors(h, 0, batch, scale);
       }
+
+      end = first - 1;
+    }
+  }
+
+  void network::update_neuron_factors(const unsigned int &batch, const double &scale) {
+    for(unsigned int i = 0; i < layers(); i++) update_neuron_factors(i, 0, batch, scale);
+  }
+
+  void network::update_neuron_factors(const unsigned int &index, const unsigned int &offset,
+                                      const unsigned int &batch, const double &scale) {
+    auto &l = _packed[index];
+    const double *inputs = ( index == 0 ) ? _batch_inputs + offset * _inputs.size() :
+                                            _packed[index - 1].outputs + offset * l.columns;
+    double *bias_gradients = l.gradients + l.rows * l.columns;
+
+    MP_STATS_SCOPE(_stats, index, phase::neuron_factors,
+                   2ULL * l.rows * (l.columns + 1) * batch,
+                   8ULL * (2 * l.rows * (l.columns + 1) + (l.rows + l.columns) * batch));
+
+    kernels::gradients(l.deltas + offset * l.rows, inputs, l.gradients, bias_gradients, l.rows,
+                       l.columns, batch, scale);
+
+    for( auto &current : l.runs ) {
+      if( current.bias ) continue;
+      for( auto r : current.rows ) bias_gradients[r] = 0.0;
     }
   }
 
   void network::adjust_weights() {
     for(unsigned int i = 0; i < layers(); i++) {
-      for(unsigned int j = 0; j < layer_size( i ); j++) {
-        auto hide_neuron = neuron(i, j).lock();
-        hide_neuron->apply_changes(0.9, 0.1);
+      auto &l = _packed[i];
+      unsigned int size = l.rows * (l.columns + 1);
+
+      MP_STATS_SCOPE(_stats, i, phase::adjust_weights, 5ULL * size, 8ULL * 5 * size);
+
+      _optimizer->step(i, l.parameters, l.gradients, size);
+    }
+
+    round_weights();
+  }
+
+  void network::round_weights() {
+    for( auto &l : _packed ) {
+      if( _storage == storage::float64 ) {
+        vector<uint16_t>().swap( l.reduced );
+        vector<float>().swap( l.widened );
+        continue;
       }
+
+      l.reduced.resize( l.rows * l.columns );
+      l.widened.resize( l.columns );
+      kernels::reduce(l.parameters, l.reduced.data(), l.rows * l.columns, _storage);
     }
   }
 }
@@ -19,13 +19,35 @@
 #define ___NETWORK___
 #include <vector>
 #include <memory>
+#include <stdexcept>
 #include "neuron/base.h"
 #include "neuron/sigmoid.h"
+#include "neuron/linear.h"
+#include "neuron/hyperbolic_tangent.h"
+#include "neuron/relu.h"
+#include "neuron/leaky_relu.h"
+#include "neuron/rbf.h"
+#include "stats.h"
+#include "layer.h"
+#include "arena.h"
+#include "kernels.h"
+#include "pool.h"
+#include "optimizer/base.h"
+#include "optimizer/sgd.h"
 
 using namespace std;
 using namespace mp::neuron;
 
 namespace mp {
+  /**
+   * \brief How the output layer turns its weighted sums into the network outputs, and which
+   * loss the backward pass minimizes.
+   * */
+  enum class stage : unsigned int {
+    activation = 0, //!< Each output neuron applies its activation; squared error loss
+    softmax         //!< Softmax over the weighted sums; cross-entropy loss, p - y gradient
+  };
+
   /**
    * \class network network.h
    * \brief This class represents the multilayer percentron network.
@@ -41,10 +63,24 @@ namespace mp {
    * hidden layer and one output layer).
    *
    * By design, I tried that the network have a flexible structure, that implies:
-   * - The length of each layer can be variable (Work In Progress)
+   * - The length of each layer can be variable: remove_neuron shrinks a hidden layer
    * - A layer can have any kind of neurons, with any kind of configuration, you can for
    *   example have a layer with three neurons, 2 of them sigmoid (one with bias, one without bias),
    *   and the another one RBF (with or without bias).
+   *
+   * The network has two states. While it is being built (editable state) the neurons own
+   * their factors, and feeding inputs of a different length restructures the first layer.
+   * compile() validates the topology, places all of the factors, gradients and activations
+   * in a single arena and moves the network to the executable state, where feeding,
+   * spreading out and backpropagating do not resize or copy anything, and inputs of the
+   * wrong length are reported with an invalid_argument exception. The network compiles itself
+   * the first time it runs, and goes back to the editable state when its structure changes or
+   * a neuron is handed out for editing, copying the trained factors back to the neurons. The
+   * const methods never change the state, so they can run while other threads predict.
+   *
+   * The neurons created by the network are placed, together with their reference counts,
+   * in a pool owned by the network instead of one heap object each. The passes never touch
+   * the shared pointers, which are only kept for the public neuron accessors.
    * */
   class network {
     public:
@@ -64,13 +100,110 @@ namespace mp {
       network(const unsigned int &hidden_layers, const unsigned int &layer_size,
               const unsigned int &output_size);
 
+      /**
+       * It builds a deep copy of the network, as replica() does, with an optimizer of the same
+       * kind and hyperparameters but without its state
+       * \param other the network to copy
+       * \throw invalid_argument if the network has custom neurons, which can not be copied
+       * */
+      network(const network &other);
+
+      /**
+       * It replaces the network with a deep copy of another one, as the copy constructor does
+       * \param other the network to copy
+       * \return this network
+       * \throw invalid_argument if the network has custom neurons, which can not be copied
+       * */
+      network& operator=(const network &other);
+
+      network(network &&other) = default;
+      network& operator=(network &&other) = default;
+
+      /**
+       * It builds a copy of the network with its own neurons and storage: the same layers,
+       * activations, weights, inputs, output stage, checkpoints and weight storage. The copy
+       * starts with the default optimizer, and it is compiled if this network is. This
+       * network is left in the state it was.
+       * \return the copy of the network
+       * \throw invalid_argument if the network has custom neurons, which can not be copied
+       * */
+      network replica() const;
+
       /**
        * It feeds the neuron with the given inputs. Notice that the inputs don't need to have
        * a specified length. The network will be restructured to ensure that all layer are
        * correctly connected with the new inputs
+       * \throw invalid_argument if the network is compiled and the inputs length is not the
+       * compiled one
        * */
       void feed(const vector<double> &inputs);
 
+      /**
+       * It validates the topology, allocates all the network storage in one arena and moves
+       * the network to the executable state.
+       * \param inputs_size    number of inputs of the network
+       * \param batch_capacity number of samples that the arena can hold at once. Bigger
+       * batches are trained in chunks of this size.
+       * \throw invalid_argument if a layer has no neurons
+       * */
+      void compile(const unsigned int &inputs_size, const unsigned int &batch_capacity = 32);
+
+      /**
+       * It checks if the network is in the executable state
+       * \return true if the network is compiled
+       * */
+      bool compiled() const;
+
+      /**
+       * It sets how often the training keeps the activations of a layer. With a value k
+       * greater than 1 only the outputs of every k-th layer and of the output layer have their
+       * own storage; the layers in between share k - 1 buffers, and the backward pass computes
+       * them again from the last kept layer, one segment at a time. The deltas of all layers
+       * share two buffers. It costs up to one more forward pass per batch, and the stored
+       * activations grow as L / k + k instead of L for L layers. The gradients do not change.
+       * \param every distance between two kept layers. 0 and 1 keep every layer.
+       * */
+      void checkpoint(const unsigned int &every);
+
+      /**
+       * It returns how often the training keeps the activations of a layer
+       * \return distance between two kept layers, 1 if every layer is kept
+       * */
+      unsigned int checkpoint() const;
+
+      /**
+       * It sets how the factors are stored for the forward passes. With storage::bfloat16 or
+       * storage::half a 16-bit copy of the factors, rounded to nearest, is what spreading out,
+       * predicting and the forward half of the training read, with the dot products in float.
+       * The backward pass and the optimizer still work on the double factors, which are
+       * rounded again after every update. The biases stay in double.
+       * \param format storage of the factors
+       * */
+      void weight_storage(const storage &format);
+
+      /**
+       * It returns how the factors are stored for the forward passes
+       * \return the storage of the factors
+       * */
+      storage weight_storage() const;
+
+      /**
+       * It returns the bytes reserved by the compiled network: the weights, their gradients,
+       * their 16-bit copy if any, and the activations and deltas of a full batch.
+       * \return the size of the arena in bytes, or 0 if the network is not compiled
+       * */
+      size_t memory() const;
+
+      /**
+       * It returns the bytes that training a mini-batch of the given size keeps for its
+       * samples: the batch inputs, the outputs of the kept layers and their deltas, and the
+       * buffers where the checkpointed layers are computed again (see checkpoint()). Batches
+       * bigger than the compiled capacity are trained in chunks, so they take a full chunk.
+       * \param batch number of samples of the mini-batch
+       * \return the activation memory of the mini-batch in bytes, without the arena padding
+       * */
+      size_t activation_memory(const unsigned int &batch) const;
+
       /**
        * It updates the network map to have the specified number of hidden layers, each one with
        * the specified layer size, and the output layer with the specified output size
@@ -81,6 +214,37 @@ namespace mp {
       void update_network_map(const unsigned int &hidden_layers, const unsigned int &layer_size,
                               const unsigned int &output_size);
 
+      /**
+       * It replaces every neuron of a layer with a neuron of the given activation that keeps
+       * the same factors and bias. ReLU layers, for example, are cheaper to run and train than
+       * the default sigmoid ones.
+       * \param layer_index Layer to change
+       * \param kind        Activation of the new neurons
+       * \throw invalid_argument if kind is custom
+       * */
+      void activation(const unsigned int &layer_index, const activation_kind &kind);
+
+      /**
+       * It returns the activation of a layer
+       * \param layer_index Layer to check
+       * \return the activation shared by all the neurons of the layer, or custom if they differ
+       * */
+      activation_kind activation(const unsigned int &layer_index) const;
+
+      /**
+       * It selects the output stage. With stage::softmax the weighted sums of the output layer
+       * go through a max-subtracted softmax instead of the neuron activations, and the
+       * backward pass minimizes the cross-entropy, whose deltas are simply p - y.
+       * \param output Output stage of the network
+       * */
+      void output_stage(const stage &output);
+
+      /**
+       * It returns the output stage
+       * \return the output stage of the network
+       * */
+      stage output_stage() const;
+
       /**
        * It stores the given neuron in the network. This can be useful to change the default
        * neurons.
@@ -91,13 +255,34 @@ namespace mp {
       void neuron(const unsigned int &layer_index, const unsigned int &neuron_index,
                   const shared_ptr<base> &neuron);
 
+      /**
+       * It removes a neuron from a hidden layer, together with the factor that each neuron of
+       * the next layer has for it, so the layers can end up with different sizes.
+       * \param layer_index  Hidden layer of the neuron
+       * \param neuron_index Index of the neuron inside the layer
+       * \throw invalid_argument if the layer is the output layer or the neuron is the last one
+       * of its layer
+       * */
+      void remove_neuron(const unsigned int &layer_index, const unsigned int &neuron_index);
+
+      /**
+       * It inserts a new hidden layer of sigmoid neurons, without bias and with zero factors,
+       * before the given layer. The factors of the neurons of the layer that now follows it
+       * are resized to the new layer size, so they must be set again.
+       * \param layer_index Index that the new layer will have, up to the output layer index
+       * \param size        Number of neurons of the new layer
+       * \throw invalid_argument if the index is after the output layer or the size is zero
+       * */
+      void insert_layer(const unsigned int &layer_index, const unsigned int &size);
+
       /**
        * It spread out the network neurons!
        * */
       void spread_out();
 
       /**
-       * It applies a softmax function to the neuron outputs.
+       * It applies a numerically stable softmax function to the current outputs. Networks with
+       * the softmax output stage already return probabilities and do not need it.
        * */
       void apply_softmax();
 
@@ -109,6 +294,108 @@ namespace mp {
        * */
       void backpropagate(const vector<double> &inputs, const vector<double> &expected);
 
+      /**
+       * It trains the network with a mini-batch. The gradients of all the samples are averaged
+       * and the weights are adjusted once.
+       * \param inputs   pointers to the inputs of each sample
+       * \param expected pointers to the expected outputs of each sample
+       * \throw invalid_argument if the samples do not fit the network
+       * */
+      void backpropagate(const vector<const vector<double> *> &inputs,
+                         const vector<const vector<double> *> &expected);
+
+      /**
+       * It trains several stackable networks with the same mini-batch. Every layer of all the
+       * networks runs in one stacked forward kernel, and the first layers read each input
+       * sample once for all of them. Each network keeps its own optimizer, and the result is
+       * the same as calling backpropagate on each one.
+       * \param models   networks to train, see stackable()
+       * \param inputs   pointers to the inputs of each sample
+       * \param expected pointers to the expected outputs of each sample
+       * \throw invalid_argument if the networks are not stackable or the samples do not fit
+       * */
+      static void backpropagate_stacked(const vector<network *> &models,
+                                        const vector<const vector<double> *> &inputs,
+                                        const vector<const vector<double> *> &expected);
+
+      /**
+       * It trains the network with a mini-batch, as backpropagate does, with the layers split
+       * in contiguous stages of about the same number of weights, one thread each. The samples
+       * loaded in the arena are cut into micro-batches that go through the stages in order:
+       * while a stage runs the forward pass of a micro-batch, the stage before it runs the
+       * next one, and the backward pass follows the same schedule from the output layer. The
+       * stages share the weights, which are adjusted once at the end, so the result is the
+       * same as with backpropagate.
+       * \param inputs      pointers to the inputs of each sample
+       * \param expected    pointers to the expected outputs of each sample
+       * \param stages      number of stages, see pipeline_stages()
+       * \param micro_batch samples of each micro-batch, up to the compiled batch capacity
+       * \throw invalid_argument if the samples do not fit the network, the micro-batch is
+       * empty or the network keeps checkpoints
+       * */
+      void backpropagate_pipelined(const vector<const vector<double> *> &inputs,
+                                   const vector<const vector<double> *> &expected,
+                                   const unsigned int &stages, const unsigned int &micro_batch);
+
+      /**
+       * It splits the layers in contiguous stages with about the same number of weights
+       * \param stages number of stages, from one up to the number of layers
+       * \return the first layer of each stage, followed by the number of layers
+       * */
+      vector<unsigned int> pipeline_stages(const unsigned int &stages) const;
+
+      /**
+       * It checks if a network can be stacked with this one: both have the same inputs and
+       * layer sizes, the same activation and bias setting on every neuron, the same output
+       * stage, and double factors (storage::float64), which the stacked kernel reads.
+       * \param other network to compare with
+       * \return true if both networks can be trained together with backpropagate_stacked
+       * */
+      bool stackable(const network &other) const;
+
+      /**
+       * It returns the gradient of the loss for the given sample, with the layout of weights():
+       * half the sum of the squared differences, or the cross-entropy with the softmax output
+       * stage. The weights are not changed.
+       * \param inputs the inputs of the network
+       * \param expected the expected result of the network
+       * \return the gradient of every weight
+       * */
+      vector<double> gradients(const vector<double> &inputs, const vector<double> &expected);
+
+      /**
+       * It returns the mean gradient of the loss over a mini-batch, with the layout of
+       * weights(). The weights are not changed.
+       * \param inputs   pointers to the inputs of each sample
+       * \param expected pointers to the expected outputs of each sample
+       * \return the gradient of every weight
+       * \throw invalid_argument if the samples do not fit the network
+       * */
+      vector<double> gradients(const vector<const vector<double> *> &inputs,
+                               const vector<const vector<double> *> &expected);
+
+      /**
+       * It adjusts the weights with the optimizer, as backpropagate does, but with the given
+       * gradient. The gradients of disabled biases are ignored.
+       * \param values gradient of every weight, with the layout of weights()
+       * \throw invalid_argument if the size is not the size of weights()
+       * */
+      void apply_gradients(const vector<double> &values);
+
+      /**
+       * It sets the optimizer used to adjust the weights after each backpropagation. By
+       * default the network uses mp::optimizer::sgd with a learning rate of 0.9 and a
+       * momentum of 0.1.
+       * \param opt the optimizer to use
+       * */
+      void optimizer(const shared_ptr<mp::optimizer::base> &opt);
+
+      /**
+       * It returns the optimizer used to adjust the weights
+       * \return the current optimizer
+       * */
+      shared_ptr<mp::optimizer::base> optimizer() const;
+
       /**
        * It returns the number of layers of the network (hidden layers + output layer).
        * \return the number of hidden layers of the network
@@ -123,13 +410,26 @@ namespace mp {
       unsigned int layer_size(const unsigned int &layer_index) const;
 
       /**
-       * It returns a weak reference of the specified neuron.
+       * It returns a weak reference of the specified neuron. If the network is compiled, the
+       * trained factors are copied back to the neurons and the network goes back to the
+       * editable state, so any change done through the reference is seen by the network.
        * \param layer_index  Layer where the neuron must be set
        * \param neuron_index Index of the neuron inside the layer
        * \return a weak pointer to the specified neuron
        * */
-      weak_ptr<base> neuron(const unsigned int &layer_index,
-                            const unsigned int &neuron_index) const;
+      weak_ptr<base> neuron(const unsigned int &layer_index, const unsigned int &neuron_index);
+
+      /**
+       * It returns a read-only reference of the specified neuron, for its kind, activation
+       * and bias flag. The network is not changed, so while it is compiled the factors and
+       * the bias of the neuron are the ones it had when it was compiled; the trained ones
+       * are read with weights().
+       * \param layer_index  Layer of the neuron
+       * \param neuron_index Index of the neuron inside the layer
+       * \return a weak pointer to the specified neuron
+       * */
+      weak_ptr<const base> neuron(const unsigned int &layer_index,
+                                  const unsigned int &neuron_index) const;
 
       /**
        * It returns current network outputs
@@ -137,6 +437,13 @@ namespace mp {
        * */
       vector<double> output() const;
 
+      /**
+       * It returns the outputs of every sample of the last trained mini-batch, one sample
+       * after another
+       * \return the outputs of the last mini-batch
+       * */
+      vector<double> batch_outputs() const;
+
       /**
        * It returns the network output when it is feeded with the given input
        * \param inputs the inputs for the network
@@ -144,11 +451,76 @@ namespace mp {
        * */
       vector<double> output(const vector<double> &inputs);
 
+      /**
+       * It computes the network outputs of a block of samples. The block goes through the
+       * network layer by layer, so the factors of each neuron are read once for all of the
+       * samples. It does not change the network state (the inputs, neuron outputs and network
+       * outputs stay untouched), so several threads can call it at the same time.
+       * \param inputs  pointers to the inputs of each sample
+       * \param outputs it receives the network outputs of each sample
+       * \throw invalid_argument if a sample does not fit the first layer of the network
+       * */
+      void predict(const vector<const vector<double> *> &inputs,
+                   vector<vector<double>> &outputs) const;
+
+      /**
+       * It returns all the network weights in a single vector. Each layer stores the factors
+       * of its neurons one after the other, followed by their biases.
+       * \return the network weights
+       * */
+      vector<double> weights() const;
+
+      /**
+       * It sets all the network weights from a vector with the layout returned by weights().
+       * The biases of the neurons that have the bias disabled are ignored.
+       * \param values the new network weights
+       * \throw invalid_argument if the size of values does not fit the network
+       * */
+      void weights(const vector<double> &values);
+
+      /**
+       * It returns the number of inputs that the given layer receives.
+       * \param layer_index index of the layer
+       * \return the size of the network inputs for the first layer, or the size of the
+       * layer before for the rest of them
+       * */
+      unsigned int layer_inputs(const unsigned int &layer_index) const;
+
+      /**
+       * It returns a snapshot of the per-layer and per-phase counters (wall time, calls,
+       * estimated flops and bytes moved). The counters are only collected when the library
+       * is built with MP_NETWORK_STATS, otherwise all of them stay at zero.
+       * \return a copy of the current network counters
+       * */
+      stats statistics() const;
+
+      /**
+       * It sets all the network counters to zero
+       * */
+      void reset_statistics();
+
     private:
       vector<double> _inputs;
+
+      // Storage of the neurons created by the network. Their control blocks live in it too,
+      // so the pool is released when the last neuron and the last weak_ptr are gone.
+      shared_ptr<pool> _pool;
       vector<vector<shared_ptr<base>>> _hidden_layers;
       vector<shared_ptr<base>> _output_layer;
       vector<double> _outputs;
+      vector<double> _batch_outputs;
+      stats _stats;
+      shared_ptr<mp::optimizer::base> _optimizer;
+      stage _stage;
+
+      // Executable state: contiguous layers and batch inputs, all of them inside the arena
+      bool _compiled;
+      unsigned int _capacity;
+      unsigned int _checkpoint;
+      storage _storage;
+      arena _arena;
+      vector<mp::layer> _packed;
+      double *_batch_inputs;
 
       /**
        * It fix the neuron factors of the specified layer, and if the neuron is
@@ -171,6 +543,82 @@ namespace mp {
        * */
       const vector<shared_ptr<base>>& layer(const unsigned int &index) const;
 
+      /**
+       * It compiles the network for the current inputs if it is in the editable state
+       * */
+      void ensure_compiled();
+
+      /**
+       * It copies the compiled factors back to the neurons and moves the network to the
+       * editable state
+       * */
+      void release();
+
+      /**
+       * It copies a chunk of samples into the batch inputs of the arena
+       * \param inputs pointers to the inputs of each sample
+       * \param start  index of the first sample of the chunk
+       * \param count  number of samples of the chunk
+       * */
+      void load_batch(const vector<const vector<double> *> &inputs, const unsigned int &start,
+                      const unsigned int &count);
+
+      /**
+       * It appends the outputs of the loaded batch to the outputs of the mini-batch
+       * \param batch number of samples loaded
+       * */
+      void keep_outputs(const unsigned int &batch);
+
+      /**
+       * It spreads out the loaded batch through the compiled layers
+       * \param batch number of samples loaded
+       * */
+      void forward_batch(const unsigned int &batch);
+
+      /**
+       * It spreads out the loaded samples through one compiled layer
+       * \param index  index of the layer
+       * \param offset first sample of the arena to spread out
+       * \param batch  number of samples
+       * */
+      void forward_layer(const unsigned int &index, const unsigned int &offset,
+                         const unsigned int &batch);
+
+      /**
+       * It checks if a layer keeps its outputs during the backward pass, see checkpoint()
+       * \param index index of the layer
+       * \return true if the outputs of the layer have their own storage
+       * */
+      bool stored(const unsigned int &index) const;
+
+      /**
+       * It counts the doubles that a chunk of samples needs in the arena: the batch inputs,
+       * the kept outputs, sums and deltas, the checkpoint buffers and the scatter scratch
+       * \param grouped the layers grouped by runs of neurons
+       * \param count   number of samples of the chunk
+       * \param padded  true to count each piece with its arena footprint
+       * \return the number of doubles
+       * */
+      size_t batch_values(const vector<mp::layer> &grouped, const unsigned int &count,
+                          const bool &padded) const;
+
+      /**
+       * It turns the weighted sums of a compiled layer into its outputs
+       * \param index  index of the layer
+       * \param offset first sample of the arena to activate
+       * \param batch  number of samples
+       * */
+      void activate_layer(const unsigned int &index, const unsigned int &offset,
+                          const unsigned int &batch);
+
+      /**
+       * It runs the forward pass of several stackable networks over the batch loaded in each
+       * of them, one stacked kernel call per layer
+       * \param models networks to run
+       * \param batch  number of samples loaded
+       * */
+      static void forward_stacked(const vector<network *> &models, const unsigned int &batch);
+
       /**
        * It reset all neuron changes
        * */
@@ -178,21 +626,63 @@ namespace mp {
 
       /**
        * It update neuron's deltas
-       * \param expected expected network's outputs
+       * \param expected expected network's outputs of each sample of the batch
        * */
-      void update_deltas(const vector<double> &expected);
-      void update_output_deltas(const vector<double> &expected);
-      void update_hidden_deltas();
+      void update_deltas(const vector<const vector<double> *> &expected, const unsigned int &start,
+                         const unsigned int &batch);
+      void update_output_deltas(const vector<const vector<double> *> &expected,
+                                const unsigned int &start, const unsigned int &offset,
+                                const unsigned int &batch);
+      void update_hidden_deltas(const unsigned int &batch);
+      void update_hidden_deltas(const unsigned int &index, const unsigned int &offset,
+                                const unsigned int &batch);
+
+      /**
+       * It computes the gradients of the loaded batch after its forward pass. With checkpoints
+       * each segment of layers is computed again before its deltas, see checkpoint().
+       * \param expected expected network's outputs of each sample of the batch
+       * \param start    index of the first sample of the batch
+       * \param batch    number of samples loaded
+       * \param scale    factor applied to each sample gradient
+       * */
+      void backward_batch(const vector<const vector<double> *> &expected,
+                          const unsigned int &start, const unsigned int &batch,
+                          const double &scale);
 
       /**
        * It updates all neuron factors to improve the network output.
+       * \param batch number of samples loaded
+       * \param scale factor applied to each sample gradient
        * */
-      void update_neuron_factors();
+      void update_neuron_factors(const unsigned int &batch, const double &scale);
+      void update_neuron_factors(const unsigned int &index, const unsigned int &offset,
+                                 const unsigned int &batch, const double &scale);
+
+      /**
+       * It runs the forward and backward passes of the loaded samples through the pipeline
+       * stages, one thread per stage, see backpropagate_pipelined()
+       * \param expected    expected network's outputs of each sample
+       * \param start       index of the first loaded sample in expected
+       * \param batch       number of samples loaded
+       * \param micro_batch samples of each micro-batch
+       * \param bounds      first layer of each stage, followed by the number of layers
+       * \param scale       factor applied to each sample gradient
+       * */
+      void pipeline_batch(const vector<const vector<double> *> &expected,
+                          const unsigned int &start, const unsigned int &batch,
+                          const unsigned int &micro_batch, const vector<unsigned int> &bounds,
+                          const double &scale);
 
       /**
        * It adjust the neuron factors according to their deltas
        * */
       void adjust_weights();
+
+      /**
+       * It rounds the compiled factors to the 16-bit storage of the network, or frees their
+       * rounded copy if the factors are used as they are
+       * */
+      void round_weights();
   };
 }
 #endif
@@ -37,24 +37,15 @@ namespace mp {
     }
 
     base::base(const base& n) {
-      set_delta(n.delta());
-
-      set_factors(n.last_factor_changes());
-      set_factors(n.factor_changes());
-      set_factors(n.factors());
-
-      if(n.bias_enabled()){
-        enable_bias();
-        _bias = n.bias();
-        _bias_change = n.bias_change();
-        _last_bias_change = n.last_bias_change();
-      }
-      else {
-        _bias = 0.0;
-        _bias_change = 0.0;
-        _last_bias_change = 0.0;
-        disable_bias();
-      }
+      _factors = n.factors();
+      _factor_changes = n.factor_changes();
+      _last_factor_changes = n.last_factor_changes();
+      _bias_enabled = n.bias_enabled();
+      _bias = _bias_enabled ? n.bias() : 0.0;
+      _bias_change = _bias_enabled ? n.bias_change() : 0.0;
+      _last_bias_change = _bias_enabled ? n.last_bias_change() : 0.0;
+      _delta = n.delta();
+      _output = n.output();
     }
 
     void base::resize(const unsigned int &factors_size) {
@@ -225,6 +216,42 @@ namespace mp {
       _output = calculate_output(neuron_layer);
     }
 
+    double base::activation(const double &sum) const {
+      return sum;
+    }
+
+    double base::derivative(const double &) const {
+      return 1.0;
+    }
+
+    double base::slope(const double &sum) const {
+      return derivative( activation( sum ) );
+    }
+
+    activation_kind base::kind() const {
+      return activation_kind::custom;
+    }
+
+    double base::weighted_sum(const std::vector<double> &input_layer) const {
+      double sum = bias();
+
+      for(unsigned int i = 0; ((i < input_layer.size()) || (i < factors_size())); i++) {
+        sum += (input_layer.at(i) * factor(i));
+      }
+
+      return sum;
+    }
+
+    double base::weighted_sum(const std::vector<std::shared_ptr<base>> &neuron_layer) const {
+      double sum = bias();
+
+      for(unsigned int i = 0; ((i < neuron_layer.size()) || (i < factors_size())); i++) {
+        sum += (neuron_layer.at(i)->output() * factor(i));
+      }
+
+      return sum;
+    }
+
     base::~base() {
     }
   }
@@ -22,6 +22,19 @@
 
 namespace mp { // Stands for MultilayerPerceptron
   namespace neuron { //Neuron's namespace
+    /**
+     * \brief Activation functions that the network knows how to run with batched kernels.
+     * Neurons reporting custom are evaluated one by one through their virtual methods.
+     * */
+    enum class activation_kind : unsigned int {
+      custom = 0,
+      linear,
+      sigmoid,
+      hyperbolic_tangent,
+      relu,
+      leaky_relu,
+      rbf
+    };
     /**
      * \class base base.h
      * \brief This class represents a neuron's base in the network. Each neuron have an arbitrary
@@ -221,12 +234,61 @@ namespace mp { // Stands for MultilayerPerceptron
         void refresh(const std::vector<double> &input_layer);
         void refresh(const std::vector<std::shared_ptr<base>> &neuron_layer);
 
-        ~base();
+        /**
+         * \brief It applies the neuron activation function to the given weighted sum. It does
+         * not change the neuron state, so it can be used to evaluate the neuron from several
+         * threads at the same time.
+         * \param sum the weighted sum of the inputs plus the bias
+         * \return the neuron output for that sum. By default it returns the sum unchanged.
+         * */
+        virtual double activation(const double &sum) const;
+
+        /**
+         * \brief It returns the derivative of the activation function, written in terms of
+         * the neuron output.
+         * \param output the neuron output
+         * \return the derivative of the activation at that output. By default it returns one.
+         * */
+        virtual double derivative(const double &output) const;
+
+        /**
+         * \brief It returns the derivative of the activation function at the given weighted
+         * sum, for the activations whose output does not tell the sum.
+         * \param sum the weighted sum of the inputs plus the bias
+         * \return the derivative of the activation at that sum. By default it returns
+         * derivative( activation( sum ) ).
+         * */
+        virtual double slope(const double &sum) const;
+
+        /**
+         * \brief It tells the network which batched kernel computes the same activation and
+         * derivative as this neuron. A subclass that overrides activation must override this
+         * method too, or leave it as custom.
+         * \return the activation kind of the neuron. By default it returns custom.
+         * */
+        virtual activation_kind kind() const;
+
+        virtual ~base();
 
       protected:
         virtual double calculate_output(const std::vector<double> &input_layer) =0;
         virtual double calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) =0;
 
+        /**
+         * \brief It returns the bias plus the sum of the inputs weighted by the factors
+         * \param input_layer inputs of the neuron
+         * \return the weighted sum that the activation function receives
+         * */
+        double weighted_sum(const std::vector<double> &input_layer) const;
+
+        /**
+         * \brief It returns the bias plus the sum of the outputs of the layer before, weighted
+         * by the factors
+         * \param neuron_layer layer that feeds the neuron
+         * \return the weighted sum that the activation function receives
+         * */
+        double weighted_sum(const std::vector<std::shared_ptr<base>> &neuron_layer) const;
+
       private:
         std::vector<double> _factors;
         std::vector<double> _factor_changes;
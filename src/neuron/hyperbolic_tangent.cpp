@@ -0,0 +1,52 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "hyperbolic_tangent.h"
+
+namespace mp {
+  namespace neuron {
+    hyperbolic_tangent::hyperbolic_tangent() : mp::neuron::base() {}
+
+    hyperbolic_tangent::hyperbolic_tangent(const unsigned int &inputs_size, const bool &bias_enabled) :
+    mp::neuron::base(inputs_size, bias_enabled) {}
+
+    hyperbolic_tangent::hyperbolic_tangent(const base &n) : mp::neuron::base(n) {}
+
+    double hyperbolic_tangent::calculate_output(const std::vector<double> &input_layer) {
+      return activation( weighted_sum( input_layer ) );
+    }
+
+    double hyperbolic_tangent::calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) {
+      return activation( weighted_sum( neuron_layer ) );
+    }
+
+    double hyperbolic_tangent::activation(const double &sum) const {
+      return std::tanh( sum );
+    }
+
+    double hyperbolic_tangent::derivative(const double &output) const {
+      return 1 - output * output;
+    }
+
+    activation_kind hyperbolic_tangent::kind() const {
+      return activation_kind::hyperbolic_tangent;
+    }
+
+    hyperbolic_tangent::~hyperbolic_tangent() {
+    }
+  }
+}
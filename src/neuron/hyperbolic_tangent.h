@@ -0,0 +1,58 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___HYPERBOLIC_TANGENT__NEURON___
+#define ___HYPERBOLIC_TANGENT__NEURON___
+#include <vector>
+#include <memory>
+#include <cmath>
+#include "base.h"
+
+namespace mp { // Stands for Multilayer Perceptron
+  namespace neuron { // Neuron's namespace
+
+    class hyperbolic_tangent : public mp::neuron::base {
+      public:
+        // Empty constructor
+        hyperbolic_tangent();
+
+        // Fill constructor
+        hyperbolic_tangent(const unsigned int &inputs_size, const bool &bias_enabled);
+
+        // Copy constructor
+        hyperbolic_tangent(const base &n);
+
+        // Destructor
+        ~hyperbolic_tangent();
+
+        // Hyperbolic tangent of the weighted sum
+        double activation(const double &sum) const override;
+
+        // 1 - output * output
+        double derivative(const double &output) const override;
+
+        // activation_kind::hyperbolic_tangent
+        activation_kind kind() const override;
+
+      protected:
+        double calculate_output(const std::vector<double> &input_layer) override;
+        double calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) override;
+    };
+  }
+}
+
+#endif
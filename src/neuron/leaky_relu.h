@@ -0,0 +1,61 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___LEAKY_RELU__NEURON___
+#define ___LEAKY_RELU__NEURON___
+#include <vector>
+#include <memory>
+#include <cmath>
+#include "base.h"
+
+namespace mp { // Stands for Multilayer Perceptron
+  namespace neuron { // Neuron's namespace
+
+    class leaky_relu : public mp::neuron::base {
+      public:
+        // Empty constructor
+        leaky_relu();
+
+        // Fill constructor
+        leaky_relu(const unsigned int &inputs_size, const bool &bias_enabled);
+
+        // Copy constructor
+        leaky_relu(const base &n);
+
+        // Destructor
+        ~leaky_relu();
+
+        // Leaky rectified linear unit: sum for positive sums, slope * sum otherwise
+        double activation(const double &sum) const override;
+
+        // 1 for positive outputs, slope otherwise
+        double derivative(const double &output) const override;
+
+        // activation_kind::leaky_relu
+        activation_kind kind() const override;
+
+        // Slope of the negative side, shared by every leaky_relu so they can run in one kernel
+        static const double slope;
+
+      protected:
+        double calculate_output(const std::vector<double> &input_layer) override;
+        double calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) override;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,52 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "linear.h"
+
+namespace mp {
+  namespace neuron {
+    linear::linear() : mp::neuron::base() {}
+
+    linear::linear(const unsigned int &inputs_size, const bool &bias_enabled) :
+    mp::neuron::base(inputs_size, bias_enabled) {}
+
+    linear::linear(const base &n) : mp::neuron::base(n) {}
+
+    double linear::calculate_output(const std::vector<double> &input_layer) {
+      return activation( weighted_sum( input_layer ) );
+    }
+
+    double linear::calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) {
+      return activation( weighted_sum( neuron_layer ) );
+    }
+
+    double linear::activation(const double &sum) const {
+      return sum;
+    }
+
+    double linear::derivative(const double &) const {
+      return 1.0;
+    }
+
+    activation_kind linear::kind() const {
+      return activation_kind::linear;
+    }
+
+    linear::~linear() {
+    }
+  }
+}
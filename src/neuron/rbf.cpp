@@ -0,0 +1,57 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "rbf.h"
+#include <stdexcept>
+
+namespace mp {
+  namespace neuron {
+    rbf::rbf() : mp::neuron::base() {}
+
+    rbf::rbf(const unsigned int &inputs_size, const bool &bias_enabled) :
+    mp::neuron::base(inputs_size, bias_enabled) {}
+
+    rbf::rbf(const base &n) : mp::neuron::base(n) {}
+
+    double rbf::calculate_output(const std::vector<double> &input_layer) {
+      return activation( weighted_sum( input_layer ) );
+    }
+
+    double rbf::calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) {
+      return activation( weighted_sum( neuron_layer ) );
+    }
+
+    double rbf::activation(const double &sum) const {
+      return std::exp( -sum * sum );
+    }
+
+    double rbf::derivative(const double &) const {
+      throw std::logic_error("rbf::derivative: the output does not give the sign of the sum");
+    }
+
+    double rbf::slope(const double &sum) const {
+      return -2 * sum * activation( sum );
+    }
+
+    activation_kind rbf::kind() const {
+      return activation_kind::rbf;
+    }
+
+    rbf::~rbf() {
+    }
+  }
+}
@@ -27,23 +27,23 @@ namespace mp {
     sigmoid::sigmoid(const base &n) : mp::neuron::base(n) {}
 
     double sigmoid::calculate_output(const std::vector<double> &input_layer) {
-      double sum = this->bias();
+      return activation( weighted_sum( input_layer ) );
+    }
 
-      for(unsigned int i = 0; ((i < input_layer.size()) || (i < this->factors_size())); i++) {
-        sum += (input_layer.at(i) * this->factor(i));
-      }
+    double sigmoid::calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) {
+      return activation( weighted_sum( neuron_layer ) );
+    }
 
+    double sigmoid::activation(const double &sum) const {
       return 1/(1 + exp(-1 * sum));
     }
 
-    double sigmoid::calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) {
-      double sum = this->bias();
-
-      for(unsigned int i = 0; ((i < neuron_layer.size()) || (i < this->factors_size())); i++) {
-        sum += (neuron_layer.at(i)->output() * this->factor(i));
-      }
+    double sigmoid::derivative(const double &output) const {
+      return output * (1 - output);
+    }
 
-      return 1/(1 + exp(-1 * sum));
+    activation_kind sigmoid::kind() const {
+      return activation_kind::sigmoid;
     }
 
     sigmoid::~sigmoid() {
@@ -39,6 +39,15 @@ namespace mp { // Stands for Multilayer Perceptron
         // Destructor
         ~sigmoid();
 
+        // Logistic function applied to the weighted sum
+        double activation(const double &sum) const override;
+
+        // output * (1 - output)
+        double derivative(const double &output) const override;
+
+        // activation_kind::sigmoid
+        activation_kind kind() const override;
+
       protected:
         double calculate_output(const std::vector<double> &input_layer) override;
         double calculate_output(const std::vector<std::shared_ptr<base>> &neuron_layer) override;
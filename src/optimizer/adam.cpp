@@ -0,0 +1,72 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "adam.h"
+#include <cmath>
+
+namespace mp {
+  namespace optimizer {
+    adam::adam(const double &learning, const double &beta1, const double &beta2,
+               const double &epsilon) :
+    mp::optimizer::base(learning), _beta1(beta1), _beta2(beta2), _epsilon(epsilon) {}
+
+    adam::~adam() {
+    }
+
+    double adam::beta1() const {
+      return _beta1;
+    }
+
+    double adam::beta2() const {
+      return _beta2;
+    }
+
+    double adam::epsilon() const {
+      return _epsilon;
+    }
+
+    std::shared_ptr<mp::optimizer::base> adam::clone() const {
+      return std::make_shared<adam>( learning_rate(), _beta1, _beta2, _epsilon );
+    }
+
+    unsigned int adam::slots() const {
+      return 2;
+    }
+
+    void adam::update(double *parameters, const double *gradients, double *state,
+                      const unsigned int &size, const unsigned long &step) {
+      double * __restrict__ w = parameters;
+      const double * __restrict__ g = gradients;
+      double * __restrict__ m = state;
+      double * __restrict__ v = state + size;
+      const double beta1 = _beta1;
+      const double beta2 = _beta2;
+      const double epsilon = _epsilon;
+      const double t = static_cast<double>( step );
+      const double rate = learning_rate() * std::sqrt( 1 - std::pow( beta2, t ) )
+                          / (1 - std::pow( beta1, t ));
+
+      for(unsigned int i = 0; i < size; i++) {
+        double mi = beta1 * m[i] + (1 - beta1) * g[i];
+        double vi = beta2 * v[i] + (1 - beta2) * g[i] * g[i];
+        m[i] = mi;
+        v[i] = vi;
+        w[i] -= rate * mi / (std::sqrt( vi ) + epsilon);
+      }
+    }
+  }
+}
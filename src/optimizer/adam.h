@@ -0,0 +1,59 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___ADAM__OPTIMIZER___
+#define ___ADAM__OPTIMIZER___
+#include "base.h"
+
+namespace mp {
+  namespace optimizer {
+    /**
+     * \class adam adam.h
+     * \brief Adaptive moment estimation.
+     *
+     * It keeps the moving averages of the gradients and the squared gradients (two slots per
+     * parameter) and folds the bias correction into the step size:
+     * factor -= learning * sqrt(1 - beta2^t) / (1 - beta1^t) * m / (sqrt(v) + epsilon).
+     * */
+    class adam : public mp::optimizer::base {
+      public:
+        // Fill constructor
+        adam(const double &learning, const double &beta1 = 0.9, const double &beta2 = 0.999,
+             const double &epsilon = 1e-8);
+
+        // Destructor
+        ~adam();
+
+        double beta1() const;
+        double beta2() const;
+        double epsilon() const;
+
+        std::shared_ptr<mp::optimizer::base> clone() const override;
+
+      protected:
+        unsigned int slots() const override;
+        void update(double *parameters, const double *gradients, double *state,
+                    const unsigned int &size, const unsigned long &step) override;
+
+      private:
+        double _beta1;
+        double _beta2;
+        double _epsilon;
+    };
+  }
+}
+#endif
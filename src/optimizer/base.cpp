@@ -0,0 +1,67 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "base.h"
+
+namespace mp {
+  namespace optimizer {
+    base::base(const double &learning) {
+      _learning = learning;
+    }
+
+    base::~base() {
+    }
+
+    void base::step(const unsigned int &layer, double *parameters, const double *gradients,
+                    const unsigned int &size) {
+      if( layer >= _states.size() ) {
+        _states.resize( layer + 1 );
+        _steps.resize( layer + 1, 0 );
+      }
+
+      auto &layer_state = _states[layer];
+      if( layer_state.size() != slots() * size ) {
+        layer_state.assign( slots() * size, 0.0 );
+        _steps[layer] = 0;
+      }
+
+      _steps[layer]++;
+      update(parameters, gradients, layer_state.data(), size, _steps[layer]);
+    }
+
+    void base::learning_rate(const double &learning) {
+      _learning = learning;
+    }
+
+    double base::learning_rate() const {
+      return _learning;
+    }
+
+    void base::reset() {
+      _states.clear();
+      _steps.clear();
+    }
+
+    const std::vector<double>& base::state(const unsigned int &layer) const {
+      return _states.at( layer );
+    }
+
+    unsigned long base::steps(const unsigned int &layer) const {
+      return _steps.at( layer );
+    }
+  }
+}
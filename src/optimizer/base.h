@@ -0,0 +1,122 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___OPTIMIZER___
+#define ___OPTIMIZER___
+#include <vector>
+#include <memory>
+
+namespace mp {
+  namespace optimizer { // Optimizer's namespace
+    /**
+     * \class base base.h
+     * \brief This class represents the rule used to update the network factors from their
+     * gradients.
+     *
+     * The network calls step once per layer with all the layer parameters (factors and biases)
+     * stored contiguously, and their gradients with the same layout. Each optimizer keeps its
+     * own state (velocities, moving averages...) contiguously per layer, and updates the
+     * parameters and its state in a single pass over the arrays.
+     *
+     * \note This class can not be instanciated. Derived classes must implement the methods
+     * slots, update and clone.
+     * */
+    class base {
+      public:
+        /**
+         * \brief It builds an optimizer with the given learning rate
+         * \param learning the learning rate
+         * */
+        base(const double &learning);
+
+        virtual ~base();
+
+        /**
+         * \brief It updates the parameters of a layer with their gradients. The state of the
+         * layer is created (or rebuilt if the layer size changed) the first time it is needed.
+         * \param layer      index of the layer
+         * \param parameters parameters of the layer, they are updated in place
+         * \param gradients  gradients of the parameters
+         * \param size       number of parameters of the layer
+         * */
+        void step(const unsigned int &layer, double *parameters, const double *gradients,
+                  const unsigned int &size);
+
+        /**
+         * \brief It sets a new learning rate. The optimizer state is kept.
+         * \param learning the new learning rate
+         * */
+        void learning_rate(const double &learning);
+
+        /**
+         * \brief It returns the current learning rate
+         * \return the learning rate
+         * */
+        double learning_rate() const;
+
+        /**
+         * \brief It forgets the state of all layers
+         * */
+        void reset();
+
+        /**
+         * \brief It builds an optimizer of the same kind, learning rate and hyperparameters,
+         * without any state, so it can train another network on its own
+         * \return the new optimizer
+         * */
+        virtual std::shared_ptr<base> clone() const =0;
+
+        /**
+         * \brief It returns the state of the given layer
+         * \param layer index of the layer
+         * \return the layer state, slots() arrays of the layer size stored one after the other
+         * */
+        const std::vector<double>& state(const unsigned int &layer) const;
+
+        /**
+         * \brief It returns the number of steps applied to the given layer since its state
+         * was created
+         * \param layer index of the layer
+         * \return number of steps of the layer
+         * */
+        unsigned long steps(const unsigned int &layer) const;
+
+      protected:
+        /**
+         * \brief Number of values stored per parameter
+         * */
+        virtual unsigned int slots() const =0;
+
+        /**
+         * \brief Fused kernel that updates the parameters and the state in one pass
+         * \param parameters parameters of the layer
+         * \param gradients  gradients of the parameters
+         * \param state      layer state (slots() * size values)
+         * \param size       number of parameters
+         * \param step       number of the step being applied, starting at 1
+         * */
+        virtual void update(double *parameters, const double *gradients, double *state,
+                            const unsigned int &size, const unsigned long &step) =0;
+
+      private:
+        double _learning;
+        std::vector<std::vector<double>> _states;
+        std::vector<unsigned long> _steps;
+    };
+  }
+}
+#endif
@@ -0,0 +1,56 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "nesterov.h"
+
+namespace mp {
+  namespace optimizer {
+    nesterov::nesterov(const double &learning, const double &momentum) :
+    mp::optimizer::base(learning), _momentum(momentum) {}
+
+    nesterov::~nesterov() {
+    }
+
+    double nesterov::momentum() const {
+      return _momentum;
+    }
+
+    std::shared_ptr<mp::optimizer::base> nesterov::clone() const {
+      return std::make_shared<nesterov>( learning_rate(), _momentum );
+    }
+
+    unsigned int nesterov::slots() const {
+      return 1;
+    }
+
+    void nesterov::update(double *parameters, const double *gradients, double *state,
+                          const unsigned int &size, const unsigned long &) {
+      double * __restrict__ w = parameters;
+      const double * __restrict__ g = gradients;
+      double * __restrict__ velocity = state;
+      const double learning = learning_rate();
+      const double momentum = _momentum;
+
+      for(unsigned int i = 0; i < size; i++) {
+        double previous = velocity[i];
+        double current = momentum * previous - learning * g[i];
+        velocity[i] = current;
+        w[i] += (1 + momentum) * current - momentum * previous;
+      }
+    }
+  }
+}
@@ -0,0 +1,61 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "rmsprop.h"
+#include <cmath>
+
+namespace mp {
+  namespace optimizer {
+    rmsprop::rmsprop(const double &learning, const double &decay, const double &epsilon) :
+    mp::optimizer::base(learning), _decay(decay), _epsilon(epsilon) {}
+
+    rmsprop::~rmsprop() {
+    }
+
+    double rmsprop::decay() const {
+      return _decay;
+    }
+
+    double rmsprop::epsilon() const {
+      return _epsilon;
+    }
+
+    std::shared_ptr<mp::optimizer::base> rmsprop::clone() const {
+      return std::make_shared<rmsprop>( learning_rate(), _decay, _epsilon );
+    }
+
+    unsigned int rmsprop::slots() const {
+      return 1;
+    }
+
+    void rmsprop::update(double *parameters, const double *gradients, double *state,
+                         const unsigned int &size, const unsigned long &) {
+      double * __restrict__ w = parameters;
+      const double * __restrict__ g = gradients;
+      double * __restrict__ average = state;
+      const double learning = learning_rate();
+      const double decay = _decay;
+      const double epsilon = _epsilon;
+
+      for(unsigned int i = 0; i < size; i++) {
+        double a = decay * average[i] + (1 - decay) * g[i] * g[i];
+        average[i] = a;
+        w[i] -= learning * g[i] / (std::sqrt( a ) + epsilon);
+      }
+    }
+  }
+}
@@ -0,0 +1,55 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___RMSPROP__OPTIMIZER___
+#define ___RMSPROP__OPTIMIZER___
+#include "base.h"
+
+namespace mp {
+  namespace optimizer {
+    /**
+     * \class rmsprop rmsprop.h
+     * \brief Gradient descent scaled by a moving average of the squared gradients.
+     *
+     * average' = decay * average + (1 - decay) * gradient^2,
+     * factor -= learning * gradient / (sqrt(average') + epsilon).
+     * */
+    class rmsprop : public mp::optimizer::base {
+      public:
+        // Fill constructor
+        rmsprop(const double &learning, const double &decay = 0.9, const double &epsilon = 1e-8);
+
+        // Destructor
+        ~rmsprop();
+
+        double decay() const;
+        double epsilon() const;
+
+        std::shared_ptr<mp::optimizer::base> clone() const override;
+
+      protected:
+        unsigned int slots() const override;
+        void update(double *parameters, const double *gradients, double *state,
+                    const unsigned int &size, const unsigned long &step) override;
+
+      private:
+        double _decay;
+        double _epsilon;
+    };
+  }
+}
+#endif
@@ -0,0 +1,55 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "sgd.h"
+
+namespace mp {
+  namespace optimizer {
+    sgd::sgd(const double &learning, const double &momentum) :
+    mp::optimizer::base(learning), _momentum(momentum) {}
+
+    sgd::~sgd() {
+    }
+
+    double sgd::momentum() const {
+      return _momentum;
+    }
+
+    std::shared_ptr<mp::optimizer::base> sgd::clone() const {
+      return std::make_shared<sgd>( learning_rate(), _momentum );
+    }
+
+    unsigned int sgd::slots() const {
+      return 1;
+    }
+
+    void sgd::update(double *parameters, const double *gradients, double *state,
+                     const unsigned int &size, const unsigned long &) {
+      double * __restrict__ w = parameters;
+      const double * __restrict__ g = gradients;
+      double * __restrict__ last = state;
+      const double learning = learning_rate();
+      const double momentum = _momentum;
+
+      for(unsigned int i = 0; i < size; i++) {
+        double change = learning * (g[i] + momentum * last[i]);
+        w[i] -= change;
+        last[i] = change;
+      }
+    }
+  }
+}
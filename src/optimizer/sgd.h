@@ -0,0 +1,53 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___SGD__OPTIMIZER___
+#define ___SGD__OPTIMIZER___
+#include "base.h"
+
+namespace mp {
+  namespace optimizer {
+    /**
+     * \class sgd sgd.h
+     * \brief Gradient descent with momentum.
+     *
+     * It follows the rule used by neuron::base::apply_changes:
+     * change = learning * (gradient + momentum * last_change), factor -= change.
+     * */
+    class sgd : public mp::optimizer::base {
+      public:
+        // Fill constructor
+        sgd(const double &learning, const double &momentum);
+
+        // Destructor
+        ~sgd();
+
+        double momentum() const;
+
+        std::shared_ptr<mp::optimizer::base> clone() const override;
+
+      protected:
+        unsigned int slots() const override;
+        void update(double *parameters, const double *gradients, double *state,
+                    const unsigned int &size, const unsigned long &step) override;
+
+      private:
+        double _momentum;
+    };
+  }
+}
+#endif
@@ -0,0 +1,84 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "pool.h"
+#include <algorithm>
+#include <new>
+
+namespace mp {
+  // Every piece is aligned and padded for any fundamental type
+  const std::size_t pool_alignment = alignof(std::max_align_t);
+
+  static std::size_t padded(const std::size_t &bytes) {
+    return (bytes + pool_alignment - 1) / pool_alignment * pool_alignment;
+  }
+
+  pool::pool(const std::size_t &chunk_size) {
+    _chunk_size = padded( std::max( chunk_size, pool_alignment ) );
+    _next = nullptr;
+    _left = 0;
+    _used = 0;
+  }
+
+  pool::~pool() {
+    for( auto chunk : _chunks ) {
+      ::operator delete( chunk );
+    }
+  }
+
+  void* pool::allocate(const std::size_t &bytes) {
+    std::size_t size = padded( std::max( bytes, std::size_t( 1 ) ) );
+    std::size_t slot = size / pool_alignment;
+
+    _used += size;
+
+    if(( slot < _free.size() ) && ( not _free[slot].empty() )) {
+      void *piece = _free[slot].back();
+      _free[slot].pop_back();
+      return piece;
+    }
+
+    if( size > _left ) {
+      std::size_t chunk_size = std::max( _chunk_size, size );
+      _next = static_cast<char *>( ::operator new( chunk_size ) );
+      _left = chunk_size;
+      _chunks.push_back( _next );
+    }
+
+    void *piece = _next;
+    _next += size;
+    _left -= size;
+    return piece;
+  }
+
+  void pool::deallocate(void *piece, const std::size_t &bytes) {
+    std::size_t size = padded( std::max( bytes, std::size_t( 1 ) ) );
+    std::size_t slot = size / pool_alignment;
+
+    if( slot >= _free.size() ) _free.resize( slot + 1 );
+    _free[slot].push_back( piece );
+    _used -= size;
+  }
+
+  std::size_t pool::chunks() const {
+    return _chunks.size();
+  }
+
+  std::size_t pool::used() const {
+    return _used;
+  }
+}
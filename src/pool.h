@@ -0,0 +1,125 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___POOL___
+#define ___POOL___
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mp {
+  /**
+   * \class pool pool.h
+   * \brief Chunked storage for many small objects with stable addresses.
+   *
+   * The memory is taken from the system in large chunks and handed out in order. Released
+   * pieces are kept in a free list by size and reused by the next request of that size.
+   * Nothing is given back to the system until the pool is destroyed, so a piece never moves.
+   * */
+  class pool {
+    public:
+      /**
+       * It builds an empty pool
+       * \param chunk_size minimum size in bytes of every chunk taken from the system
+       * */
+      pool(const std::size_t &chunk_size = 64 * 1024);
+
+      pool(const pool &) = delete;
+      pool& operator=(const pool &) = delete;
+
+      ~pool();
+
+      /**
+       * It hands out a piece of memory aligned for any object
+       * \param bytes size of the piece
+       * \return the address of the piece
+       * */
+      void* allocate(const std::size_t &bytes);
+
+      /**
+       * It gives a piece back to the pool so it can be reused
+       * \param piece address returned by allocate
+       * \param bytes size used when the piece was allocated
+       * */
+      void deallocate(void *piece, const std::size_t &bytes);
+
+      /**
+       * It returns the number of chunks taken from the system
+       * \return the number of chunks
+       * */
+      std::size_t chunks() const;
+
+      /**
+       * It returns the number of bytes handed out and not given back
+       * \return the bytes in use
+       * */
+      std::size_t used() const;
+
+    private:
+      std::size_t _chunk_size;
+      std::vector<char *> _chunks;
+      char *_next;
+      std::size_t _left;
+      std::size_t _used;
+      std::vector<std::vector<void *>> _free;
+  };
+
+  /**
+   * \class pool_allocator pool.h
+   * \brief Standard allocator that takes its memory from a shared pool.
+   *
+   * Every copy of the allocator keeps the pool alive. It is meant for allocate_shared: the
+   * control block stores a copy of the allocator, so the pool outlives every weak_ptr that
+   * still points into it.
+   * */
+  template<class T>
+  class pool_allocator {
+    public:
+      typedef T value_type;
+
+      pool_allocator(const std::shared_ptr<pool> &source) : _pool(source) {}
+
+      template<class U>
+      pool_allocator(const pool_allocator<U> &other) : _pool(other.source()) {}
+
+      T* allocate(const std::size_t &n) {
+        return static_cast<T *>( _pool->allocate( n * sizeof(T) ) );
+      }
+
+      void deallocate(T *piece, const std::size_t &n) {
+        _pool->deallocate( piece, n * sizeof(T) );
+      }
+
+      const std::shared_ptr<pool>& source() const {
+        return _pool;
+      }
+
+    private:
+      std::shared_ptr<pool> _pool;
+  };
+
+  template<class T, class U>
+  bool operator==(const pool_allocator<T> &a, const pool_allocator<U> &b) {
+    return a.source() == b.source();
+  }
+
+  template<class T, class U>
+  bool operator!=(const pool_allocator<T> &a, const pool_allocator<U> &b) {
+    return a.source() != b.source();
+  }
+}
+#endif
@@ -0,0 +1,322 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "pruning.h"
+#include "evaluation.h"
+#include "schedule.h"
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+namespace mp {
+  /*
+   * It predicts the whole data set repeats times, in blocks of 32 samples, and returns the
+   * seconds taken and the accuracy of the predictions.
+   * */
+  template <class model>
+  static pair<double, double> measure(const model &m, const data &dat,
+                                      const unsigned int &repeats) {
+    vector<const vector<double> *> block;
+    vector<vector<double>> results;
+    unsigned int hits = 0;
+
+    auto start = chrono::steady_clock::now();
+    for(unsigned int k = 0; k < repeats; k++) {
+      for(unsigned int first = 0; first < dat.elements(); first += 32) {
+        unsigned int last = min( first + 32, dat.elements() );
+
+        block.clear();
+        for(unsigned int i = first; i < last; i++) block.push_back( dat.input( i ).lock().get() );
+
+        m.predict( block, results );
+
+        if( k > 0 ) continue;
+        for(unsigned int i = first; i < last; i++) {
+          auto expected = evaluator::classify( *(dat.output( i ).lock()) );
+          if( evaluator::classify( results[i - first] ) == expected ) hits++;
+        }
+      }
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    double accuracy = ( dat.elements() == 0 ) ? 0.0 : static_cast<double>( hits ) / dat.elements();
+    return { elapsed.count(), accuracy };
+  }
+
+  pruner::pruner() {
+    _iterations = 0;
+    _repeats = 5;
+  }
+
+  void pruner::fine_tuning(const unsigned int &iterations, const trainer &config) {
+    _iterations = iterations;
+    _trainer = config;
+  }
+
+  void pruner::repeats(const unsigned int &repeats) {
+    _repeats = max( repeats, 1U );
+  }
+
+  unsigned int pruner::iterations() const {
+    return _iterations;
+  }
+
+  unsigned int pruner::repeats() const {
+    return _repeats;
+  }
+
+  vector<unsigned char> pruner::mask(network &net, const double &sparsity) const {
+    if(( sparsity < 0.0 ) || ( sparsity > 1.0 )) {
+      throw invalid_argument("pruner::prune: the sparsity must be between 0 and 1");
+    }
+
+    auto weights = net.weights();
+    vector<unsigned char> pruned( weights.size(), 0 );
+    unsigned int position = 0;
+
+    for(unsigned int i = 0; i < net.layers(); i++) {
+      unsigned int factors = net.layer_size( i ) * net.layer_inputs( i );
+      unsigned int removed = static_cast<unsigned int>( floor( sparsity * factors + 0.5 ) );
+      vector<unsigned int> order( factors );
+      iota( order.begin(), order.end(), position );
+
+      nth_element( order.begin(), order.begin() + removed, order.end(),
+                   [&](const unsigned int &a, const unsigned int &b) {
+                     return fabs( weights[a] ) < fabs( weights[b] );
+                   });
+
+      for(unsigned int k = 0; k < removed; k++) {
+        pruned[order[k]] = 1;
+        weights[order[k]] = 0.0;
+      }
+
+      position += factors + net.layer_size( i );
+    }
+
+    net.weights( weights );
+    return pruned;
+  }
+
+  unsigned long long pruner::prune(network &net, const double &sparsity) const {
+    auto pruned = mask( net, sparsity );
+    return count( pruned.begin(), pruned.end(), 1 );
+  }
+
+  void pruner::tune(network &net, const data &training,
+                    const vector<unsigned char> *pruned) const {
+    trainer epoch = _trainer;
+    epoch.epochs( 1 );
+
+    for(unsigned int k = 0; k < _iterations; k++) {
+      if( _trainer.schedule() ) {
+        epoch.schedule( make_shared<mp::schedule::shifted>( k, _trainer.schedule() ) );
+      }
+
+      epoch.train( net, training );
+      if( not pruned ) continue;
+
+      auto weights = net.weights();
+      for(unsigned int i = 0; i < weights.size(); i++) if( (*pruned)[i] ) weights[i] = 0.0;
+      net.weights( weights );
+    }
+  }
+
+  unsigned long long pruner::prune(network &net, const double &sparsity,
+                                   const data &training) const {
+    auto pruned = mask( net, sparsity );
+    tune( net, training, &pruned );
+    return count( pruned.begin(), pruned.end(), 1 );
+  }
+
+  pruning_report pruner::sweep(const network &net, const vector<double> &levels,
+                               const data &validation) const {
+    return sweep( net, levels, nullptr, validation );
+  }
+
+  pruning_report pruner::sweep(const network &net, const vector<double> &levels,
+                               const data &training, const data &validation) const {
+    return sweep( net, levels, &training, validation );
+  }
+
+  pruning_report pruner::sweep(const network &net, const vector<double> &levels,
+                               const data *training, const data &validation) const {
+    pruning_report report;
+    network dense = net.replica();
+    if( not dense.compiled() ) dense.compile( dense.layer_inputs( 0 ) );
+
+    auto baseline = measure( dense, validation, _repeats );
+    report.accuracy = baseline.second;
+    report.factors = sparse_network( dense ).factors();
+
+    for( auto sparsity : levels ) {
+      network pruned = net.replica();
+      pruned.optimizer( net.optimizer()->clone() );
+
+      if( training ) prune( pruned, sparsity, *training );
+      else prune( pruned, sparsity );
+
+      sparse_network compressed( pruned );
+      auto sparse = measure( compressed, validation, _repeats );
+
+      pruning_level level;
+      level.sparsity = compressed.sparsity();
+      level.nonzeros = compressed.nonzeros();
+      level.accuracy = sparse.second;
+      level.accuracy_change = sparse.second - report.accuracy;
+      level.dense_seconds = baseline.first;
+      level.sparse_seconds = sparse.first;
+      level.speedup = ( sparse.first > 0.0 ) ? baseline.first / sparse.first : 0.0;
+      report.levels.push_back( level );
+    }
+
+    return report;
+  }
+
+  vector<vector<double>> pruner::contributions(const network &net, const data &dat) const {
+    unsigned int hidden = net.layers() - 1;
+    vector<vector<shared_ptr<const base>>> neurons( net.layers() );
+    vector<vector<double>> result( hidden );
+
+    // The factors are read from weights(), which stays valid while the network is compiled
+    auto weights = net.weights();
+    vector<unsigned int> offsets( net.layers(), 0 );
+
+    for(unsigned int i = 0; i < net.layers(); i++) {
+      for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+        neurons[i].push_back( net.neuron(i, j).lock() );
+      }
+
+      if( i < hidden ) result[i].assign( net.layer_size( i ), 0.0 );
+      if( i + 1 < net.layers() ) {
+        offsets[i + 1] = offsets[i] + net.layer_size( i ) * (net.layer_inputs( i ) + 1);
+      }
+    }
+
+    // Mean absolute output of each hidden neuron, evaluated neuron by neuron
+    vector<double> current, next;
+    for(unsigned int s = 0; s < dat.elements(); s++) {
+      current = *(dat.input( s ).lock());
+      if( current.size() != net.layer_inputs( 0 ) ) {
+        throw invalid_argument("pruner::contributions: the samples do not fit the network");
+      }
+
+      for(unsigned int i = 0; i < hidden; i++) {
+        unsigned int rows = neurons[i].size();
+        const double *factors = weights.data() + offsets[i];
+        next.resize( rows );
+
+        for(unsigned int j = 0; j < rows; j++) {
+          const double *row = factors + j * current.size();
+          double sum = factors[rows * current.size() + j];
+          for(unsigned int f = 0; f < current.size(); f++) sum += row[f] * current[f];
+
+          next[j] = neurons[i][j]->activation( sum );
+          result[i][j] += fabs( next[j] ) / dat.elements();
+        }
+
+        current.swap( next );
+      }
+    }
+
+    // Scaled by the norm of the factors that the next layer has for the neuron
+    for(unsigned int i = 0; i < hidden; i++) {
+      unsigned int columns = net.layer_inputs( i + 1 );
+      const double *factors = weights.data() + offsets[i + 1];
+
+      for(unsigned int j = 0; j < result[i].size(); j++) {
+        double norm = 0.0;
+        for(unsigned int r = 0; r < neurons[i + 1].size(); r++) {
+          norm += factors[r * columns + j] * factors[r * columns + j];
+        }
+
+        result[i][j] *= sqrt( norm );
+      }
+    }
+
+    return result;
+  }
+
+  unsigned int pruner::remove_neurons(network &net, const double &fraction,
+                                      const data &dat) const {
+    if(( fraction < 0.0 ) || ( fraction > 1.0 )) {
+      throw invalid_argument("pruner::remove_neurons: the fraction must be between 0 and 1");
+    }
+
+    auto scores = contributions( net, dat );
+    unsigned int removed = 0;
+
+    for(unsigned int i = 0; i < scores.size(); i++) {
+      unsigned int size = scores[i].size();
+      unsigned int amount = static_cast<unsigned int>( floor( fraction * size + 0.5 ) );
+      amount = min( amount, size - 1 );
+
+      vector<unsigned int> order( size );
+      iota( order.begin(), order.end(), 0 );
+      stable_sort( order.begin(), order.end(), [&](const unsigned int &a, const unsigned int &b) {
+        return scores[i][a] < scores[i][b];
+      });
+
+      // From the last index to the first, so the other indices stay valid
+      vector<unsigned int> doomed( order.begin(), order.begin() + amount );
+      sort( doomed.rbegin(), doomed.rend() );
+      for( auto j : doomed ) net.remove_neuron( i, j );
+
+      removed += amount;
+    }
+
+    tune( net, dat, nullptr );
+    return removed;
+  }
+
+  compaction_report pruner::compact(const network &net, const vector<double> &fractions,
+                                    const data &training, const data &validation) const {
+    compaction_report report;
+    network dense = net.replica();
+    if( not dense.compiled() ) dense.compile( dense.layer_inputs( 0 ) );
+
+    auto baseline = measure( dense, validation, _repeats );
+    report.accuracy = baseline.second;
+    report.seconds = baseline.first;
+    report.parameters = dense.weights().size();
+
+    for( auto fraction : fractions ) {
+      network compacted = net.replica();
+      compacted.optimizer( net.optimizer()->clone() );
+
+      remove_neurons( compacted, fraction, training );
+      if( not compacted.compiled() ) compacted.compile( compacted.layer_inputs( 0 ) );
+
+      auto result = measure( compacted, validation, _repeats );
+
+      compaction_level level;
+      level.fraction = fraction;
+      for(unsigned int i = 0; i < compacted.layers(); i++) {
+        level.sizes.push_back( compacted.layer_size( i ) );
+      }
+      level.parameters = compacted.weights().size();
+      level.accuracy = result.second;
+      level.accuracy_change = result.second - report.accuracy;
+      level.seconds = result.first;
+      level.speedup = ( result.first > 0.0 ) ? baseline.first / result.first : 0.0;
+      report.levels.push_back( level );
+    }
+
+    return report;
+  }
+}
@@ -0,0 +1,232 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___PRUNING___
+#define ___PRUNING___
+#include <vector>
+#include "network.h"
+#include "data.h"
+#include "trainer.h"
+#include "sparse_network.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Results of one sparsity level of a pruning sweep.
+   *
+   * The sparsity is the fraction of factors that ended up at zero, which can be more than the
+   * requested one if the network already had zeros. The times are the seconds taken to predict
+   * the whole validation set, with the dense network and with its sparse copy.
+   * */
+  struct pruning_level {
+    double sparsity;
+    unsigned long long nonzeros;
+    double accuracy;
+    double accuracy_change;
+    double dense_seconds;
+    double sparse_seconds;
+    double speedup;
+  };
+
+  /**
+   * \brief Results of a pruning sweep: the unpruned network, and each sparsity level.
+   * */
+  struct pruning_report {
+    double accuracy;
+    unsigned long long factors;
+    vector<pruning_level> levels;
+  };
+
+  /**
+   * \brief Results of one fraction of a compaction sweep.
+   *
+   * The sizes are the ones of every layer after removing the neurons, and the parameters
+   * count their factors and biases. The time is the seconds taken to predict the whole
+   * validation set, and the speedup is measured against the network before the compaction.
+   * */
+  struct compaction_level {
+    double fraction;
+    vector<unsigned int> sizes;
+    unsigned long long parameters;
+    double accuracy;
+    double accuracy_change;
+    double seconds;
+    double speedup;
+  };
+
+  /**
+   * \brief Results of a compaction sweep: the original network, and each fraction.
+   * */
+  struct compaction_report {
+    double accuracy;
+    unsigned long long parameters;
+    double seconds;
+    vector<compaction_level> levels;
+  };
+
+  /**
+   * \class pruner pruning.h
+   * \brief It removes the factors with the smallest magnitude from a trained network.
+   *
+   * Each layer loses the same fraction of its factors, the ones closest to zero. The biases
+   * are kept. The pruned factors are set to zero, so the network keeps working as before,
+   * and a sparse_network built from it only computes the factors that are left.
+   *
+   * The pruning can be followed by some epochs of fine tuning with a trainer. The pruned
+   * factors are set back to zero after each epoch, so the other ones learn to make up for them.
+   *
+   * Zeros scattered over the layers only pay off with the sparse kernels, so the pruner can
+   * also remove whole hidden neurons. A neuron contributes to the next layer its mean absolute
+   * output over a data set times the norm of the factors that the next layer has for it. The
+   * neurons with the smallest contribution are removed from each hidden layer, and the result
+   * is a smaller dense network that runs with the usual kernels.
+   * */
+  class pruner {
+    public:
+      /**
+       * It builds a pruner without fine tuning that times each level 5 times
+       * */
+      pruner();
+
+      /**
+       * It sets the fine tuning after the pruning
+       * \param iterations epochs of fine tuning, none if zero
+       * \param config     trainer used for each epoch; its epochs are ignored
+       * */
+      void fine_tuning(const unsigned int &iterations, const trainer &config);
+
+      /**
+       * It sets how many times the validation set is predicted to time each network
+       * \param repeats number of predictions (at least one)
+       * */
+      void repeats(const unsigned int &repeats);
+
+      /**
+       * It returns the epochs of fine tuning
+       * \return the epochs of fine tuning
+       * */
+      unsigned int iterations() const;
+
+      /**
+       * It returns how many times the validation set is predicted to time each network
+       * \return the number of predictions
+       * */
+      unsigned int repeats() const;
+
+      /**
+       * It sets to zero the given fraction of the factors of each layer, smallest first
+       * \param net      the network to prune
+       * \param sparsity fraction of the factors of each layer to remove
+       * \return the number of pruned factors
+       * \throw invalid_argument if sparsity is not between 0 and 1
+       * */
+      unsigned long long prune(network &net, const double &sparsity) const;
+
+      /**
+       * It prunes the network and fine tunes it over the training set
+       * \param net      the network to prune
+       * \param sparsity fraction of the factors of each layer to remove
+       * \param training samples used by the fine tuning
+       * \return the number of pruned factors
+       * \throw invalid_argument if sparsity is not between 0 and 1
+       * */
+      unsigned long long prune(network &net, const double &sparsity, const data &training) const;
+
+      /**
+       * It prunes copies of the network to each sparsity level, and measures the accuracy and
+       * the prediction time of their sparse copies against the dense network.
+       * \param net        the trained network, it is not modified
+       * \param levels     sparsity levels to try
+       * \param validation samples used to measure the accuracy and the times
+       * \return the accuracy of the network, and the results of each level
+       * \throw invalid_argument if a level is not between 0 and 1, or the network can not be
+       * copied
+       * */
+      pruning_report sweep(const network &net, const vector<double> &levels,
+                           const data &validation) const;
+
+      /**
+       * Same as sweep, fine tuning each copy over the training set after pruning it. Each
+       * copy gets a fresh optimizer of the same type and hyperparameters as the network's one.
+       * \param net        the trained network, it is not modified
+       * \param levels     sparsity levels to try
+       * \param training   samples used by the fine tuning
+       * \param validation samples used to measure the accuracy and the times
+       * \return the accuracy of the network, and the results of each level
+       * */
+      pruning_report sweep(const network &net, const vector<double> &levels,
+                           const data &training, const data &validation) const;
+
+      /**
+       * It measures the contribution of every hidden neuron to the next layer
+       * \param net the network, it is not modified
+       * \param dat samples whose outputs are averaged
+       * \return the contribution of each neuron of each hidden layer
+       * \throw invalid_argument if the samples do not fit the network
+       * */
+      vector<vector<double>> contributions(const network &net, const data &dat) const;
+
+      /**
+       * It removes the given fraction of the neurons of each hidden layer, the ones with the
+       * smallest contribution, and fine tunes the network over the same samples
+       * \param net      the network to compact
+       * \param fraction fraction of the neurons of each hidden layer to remove. One neuron is
+       * always kept.
+       * \param dat      samples used to measure the contributions and to fine tune
+       * \return the number of removed neurons
+       * \throw invalid_argument if fraction is not between 0 and 1
+       * */
+      unsigned int remove_neurons(network &net, const double &fraction, const data &dat) const;
+
+      /**
+       * It compacts copies of the network removing each fraction of hidden neurons, and
+       * measures their accuracy and prediction time against the network. Each copy is fine
+       * tuned with a fresh optimizer of the same type and hyperparameters as the network's one.
+       * \param net        the trained network, it is not modified
+       * \param fractions  fractions of hidden neurons to remove
+       * \param training   samples used to measure the contributions and to fine tune
+       * \param validation samples used to measure the accuracy and the times
+       * \return the accuracy and time of the network, and the results of each fraction
+       * \throw invalid_argument if a fraction is not between 0 and 1, or the network can not
+       * be copied
+       * */
+      compaction_report compact(const network &net, const vector<double> &fractions,
+                                const data &training, const data &validation) const;
+
+    private:
+      unsigned int _iterations;
+      unsigned int _repeats;
+      trainer _trainer;
+
+      /**
+       * It prunes the network and returns the pruned factors, marked with a one in the
+       * layout of network::weights()
+       * */
+      vector<unsigned char> mask(network &net, const double &sparsity) const;
+
+      /**
+       * It fine tunes the network, setting the factors marked in the mask (if any) back to zero
+       * after each epoch
+       * */
+      void tune(network &net, const data &training, const vector<unsigned char> *pruned) const;
+
+      pruning_report sweep(const network &net, const vector<double> &levels,
+                           const data *training, const data &validation) const;
+  };
+}
+#endif
@@ -0,0 +1,147 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "quantization.h"
+#include "evaluation.h"
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+namespace mp {
+  /*
+   * It evaluates the data set repeats times with one thread, and returns the seconds taken and
+   * the accuracy.
+   * */
+  static pair<double, double> measure(const network &net, const data &dat,
+                                      const unsigned int &repeats) {
+    evaluator single;
+    metrics result = metrics();
+
+    auto start = chrono::steady_clock::now();
+    for(unsigned int k = 0; k < repeats; k++) result = single.evaluate( net, dat );
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    return { elapsed.count(), result.accuracy };
+  }
+
+  /*
+   * Outputs of the network for every sample of the data set.
+   * */
+  static vector<vector<double>> outputs(const network &net, const data &dat) {
+    vector<shared_ptr<vector<double>>> samples;
+    vector<const vector<double> *> block;
+
+    for(unsigned int i = 0; i < dat.elements(); i++) {
+      samples.push_back( dat.input( i ).lock() );
+      block.push_back( samples.back().get() );
+    }
+
+    vector<vector<double>> results;
+    net.predict( block, results );
+    return results;
+  }
+
+  static unsigned long long factors(const network &net) {
+    unsigned long long result = 0;
+
+    for(unsigned int i = 0; i < net.layers(); i++) {
+      result += static_cast<unsigned long long>( net.layer_size( i ) ) * net.layer_inputs( i );
+    }
+
+    return result;
+  }
+
+  quantizer::quantizer() {
+    _repeats = 5;
+  }
+
+  void quantizer::repeats(const unsigned int &repeats) {
+    _repeats = max( repeats, 1U );
+  }
+
+  unsigned int quantizer::repeats() const {
+    return _repeats;
+  }
+
+  quantization_report quantizer::compare(const network &net, const vector<storage> &formats,
+                                         const data &validation) const {
+    return compare( net, formats, nullptr, nullptr, validation );
+  }
+
+  quantization_report quantizer::compare(const network &net, const vector<storage> &formats,
+                                         const trainer &config, const data &training,
+                                         const data &validation) const {
+    return compare( net, formats, &config, &training, validation );
+  }
+
+  quantization_report quantizer::compare(const network &net, const vector<storage> &formats,
+                                         const trainer *config, const data *training,
+                                         const data &validation) const {
+    auto prepare = [&](const storage &format) {
+      network copy = net.replica();
+      copy.weight_storage( format );
+
+      if( config ) {
+        copy.optimizer( net.optimizer()->clone() );
+        config->train( copy, *training, validation );
+      }
+
+      if( not copy.compiled() ) copy.compile( copy.layer_inputs( 0 ) );
+      return copy;
+    };
+
+    quantization_report report;
+    network reference = prepare( storage::float64 );
+
+    auto baseline = measure( reference, validation, _repeats );
+    auto expected = outputs( reference, validation );
+    report.accuracy = baseline.second;
+    report.seconds = baseline.first;
+    report.bytes = factors( reference ) * sizeof(double);
+
+    for( auto format : formats ) {
+      network reduced = prepare( format );
+      auto result = measure( reduced, validation, _repeats );
+      auto obtained = outputs( reduced, validation );
+
+      quantization_level level;
+      level.format = format;
+      level.bytes = factors( reduced ) * ( format == storage::float64 ? sizeof(double) :
+                                                                         sizeof(uint16_t) );
+      level.accuracy = result.second;
+      level.accuracy_change = result.second - report.accuracy;
+      level.max_error = 0.0;
+      level.mean_error = 0.0;
+      level.seconds = result.first;
+      level.speedup = ( result.first > 0.0 ) ? baseline.first / result.first : 0.0;
+
+      unsigned long long count = 0;
+      for(unsigned int s = 0; s < obtained.size(); s++) {
+        for(unsigned int k = 0; k < obtained[s].size(); k++, count++) {
+          double error = fabs( obtained[s][k] - expected[s][k] );
+          level.max_error = max( level.max_error, error );
+          level.mean_error += error;
+        }
+      }
+
+      if( count > 0 ) level.mean_error /= count;
+      report.levels.push_back( level );
+    }
+
+    return report;
+  }
+}
@@ -0,0 +1,121 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___QUANTIZATION___
+#define ___QUANTIZATION___
+#include <vector>
+#include "network.h"
+#include "data.h"
+#include "trainer.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Results of one weight storage in a quantization comparison.
+   *
+   * The bytes are the ones taken by the factors in that storage. The errors are the absolute
+   * differences between the outputs of the network and the ones of the double network over
+   * the validation set. The time is the seconds taken to evaluate the whole validation set.
+   * */
+  struct quantization_level {
+    storage format;
+    unsigned long long bytes;
+    double accuracy;
+    double accuracy_change;
+    double max_error;
+    double mean_error;
+    double seconds;
+    double speedup;
+  };
+
+  /**
+   * \brief Results of a quantization comparison: the double network, and each storage.
+   * */
+  struct quantization_report {
+    double accuracy;
+    unsigned long long bytes;
+    double seconds;
+    vector<quantization_level> levels;
+  };
+
+  /**
+   * \class quantizer quantization.h
+   * \brief It measures the accuracy and speed of a network with its factors in 16 bits.
+   *
+   * Each storage is tried on a copy of the network (see network::weight_storage), and
+   * compared with a copy that reads the factors in double. The copies can be trained first
+   * from the same weights, so the 16-bit forward pass takes part in the training too.
+   * */
+  class quantizer {
+    public:
+      /**
+       * It builds a quantizer that times each network evaluating the validation set 5 times
+       * */
+      quantizer();
+
+      /**
+       * It sets how many times the validation set is evaluated to time each network
+       * \param repeats number of evaluations (at least one)
+       * */
+      void repeats(const unsigned int &repeats);
+
+      /**
+       * It returns how many times the validation set is evaluated to time each network
+       * \return the number of evaluations
+       * */
+      unsigned int repeats() const;
+
+      /**
+       * It compares copies of the trained network with each storage against the network
+       * reading its factors in double
+       * \param net        the trained network, it is not modified
+       * \param formats    storages to try
+       * \param validation samples used to measure the accuracy, the errors and the times
+       * \return the accuracy, size and time of the double network, and the results of each
+       * storage
+       * \throw invalid_argument if the network can not be copied
+       * */
+      quantization_report compare(const network &net, const vector<storage> &formats,
+                                  const data &validation) const;
+
+      /**
+       * It trains copies of the network with each storage, and one in double, from the same
+       * weights, and compares them. Each copy is trained with a fresh optimizer of the same
+       * type and hyperparameters as the network's one.
+       * \param net        the network to copy, it is not modified
+       * \param formats    storages to try
+       * \param config     trainer of every copy
+       * \param training   samples used to train
+       * \param validation samples used to measure the accuracy, the errors and the times
+       * \return the accuracy, size and time of the double network, and the results of each
+       * storage
+       * \throw invalid_argument if the network can not be copied
+       * */
+      quantization_report compare(const network &net, const vector<storage> &formats,
+                                  const trainer &config, const data &training,
+                                  const data &validation) const;
+
+    private:
+      unsigned int _repeats;
+
+      quantization_report compare(const network &net, const vector<storage> &formats,
+                                  const trainer *config, const data *training,
+                                  const data &validation) const;
+  };
+}
+#endif
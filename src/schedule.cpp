@@ -0,0 +1,74 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "schedule.h"
+#include <cmath>
+
+namespace mp {
+  namespace schedule {
+    base::base() {
+    }
+
+    base::~base() {
+    }
+
+    constant::constant(const double &learning) : _learning(learning) {}
+
+    double constant::rate(const unsigned int &) const {
+      return _learning;
+    }
+
+    step::step(const double &learning, const double &drop, const unsigned int &every) :
+    _learning(learning), _drop(drop), _every(every > 0 ? every : 1) {}
+
+    double step::rate(const unsigned int &epoch) const {
+      return _learning * pow( _drop, static_cast<double>( epoch / _every ) );
+    }
+
+    exponential::exponential(const double &learning, const double &decay) :
+    _learning(learning), _decay(decay) {}
+
+    double exponential::rate(const unsigned int &epoch) const {
+      return _learning * pow( _decay, static_cast<double>( epoch ) );
+    }
+
+    cosine::cosine(const double &learning, const double &minimum, const unsigned int &epochs) :
+    _learning(learning), _minimum(minimum), _epochs(epochs > 0 ? epochs : 1) {}
+
+    double cosine::rate(const unsigned int &epoch) const {
+      if( epoch >= _epochs ) return _minimum;
+
+      double progress = static_cast<double>( epoch ) / _epochs;
+      return _minimum + 0.5 * (_learning - _minimum) * (1 + cos( M_PI * progress ));
+    }
+
+    warmup::warmup(const unsigned int &epochs, const shared_ptr<mp::schedule::base> &after) :
+    _epochs(epochs), _after(after) {}
+
+    double warmup::rate(const unsigned int &epoch) const {
+      if( epoch < _epochs ) return _after->rate( 0 ) * (epoch + 1) / (_epochs + 1);
+      else return _after->rate( epoch - _epochs );
+    }
+
+    shifted::shifted(const unsigned int &offset, const shared_ptr<mp::schedule::base> &inner) :
+    _offset(offset), _inner(inner) {}
+
+    double shifted::rate(const unsigned int &epoch) const {
+      return _inner->rate( epoch + _offset );
+    }
+  }
+}
@@ -0,0 +1,128 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___SCHEDULE___
+#define ___SCHEDULE___
+#include <memory>
+
+using namespace std;
+
+namespace mp {
+  namespace schedule { // Learning rate schedules
+    /**
+     * \class base schedule.h
+     * \brief This class represents how the learning rate changes along the training.
+     *
+     * \note This class can not be instanciated. Derived classes must implement rate.
+     * */
+    class base {
+      public:
+        base();
+        virtual ~base();
+
+        /**
+         * \brief It returns the learning rate for the given epoch
+         * \param epoch index of the epoch, starting at zero
+         * \return the learning rate to use during that epoch
+         * */
+        virtual double rate(const unsigned int &epoch) const =0;
+    };
+
+    /**
+     * \brief The same learning rate in every epoch
+     * */
+    class constant : public mp::schedule::base {
+      public:
+        constant(const double &learning);
+        double rate(const unsigned int &epoch) const override;
+
+      private:
+        double _learning;
+    };
+
+    /**
+     * \brief The learning rate is multiplied by drop every given number of epochs
+     * */
+    class step : public mp::schedule::base {
+      public:
+        step(const double &learning, const double &drop, const unsigned int &every);
+        double rate(const unsigned int &epoch) const override;
+
+      private:
+        double _learning;
+        double _drop;
+        unsigned int _every;
+    };
+
+    /**
+     * \brief The learning rate is multiplied by decay after each epoch
+     * */
+    class exponential : public mp::schedule::base {
+      public:
+        exponential(const double &learning, const double &decay);
+        double rate(const unsigned int &epoch) const override;
+
+      private:
+        double _learning;
+        double _decay;
+    };
+
+    /**
+     * \brief The learning rate follows half a cosine from learning to minimum along the
+     * given epochs, and stays at minimum afterwards
+     * */
+    class cosine : public mp::schedule::base {
+      public:
+        cosine(const double &learning, const double &minimum, const unsigned int &epochs);
+        double rate(const unsigned int &epoch) const override;
+
+      private:
+        double _learning;
+        double _minimum;
+        unsigned int _epochs;
+    };
+
+    /**
+     * \brief The learning rate grows linearly during the first epochs up to the first rate
+     * of the wrapped schedule, which is followed afterwards
+     * */
+    class warmup : public mp::schedule::base {
+      public:
+        warmup(const unsigned int &epochs, const shared_ptr<mp::schedule::base> &after);
+        double rate(const unsigned int &epoch) const override;
+
+      private:
+        unsigned int _epochs;
+        shared_ptr<mp::schedule::base> _after;
+    };
+
+    /**
+     * \brief The rates of the wrapped schedule from the given epoch on, so a training that is
+     * resumed after some epochs keeps following it
+     * */
+    class shifted : public mp::schedule::base {
+      public:
+        shifted(const unsigned int &offset, const shared_ptr<mp::schedule::base> &inner);
+        double rate(const unsigned int &epoch) const override;
+
+      private:
+        unsigned int _offset;
+        shared_ptr<mp::schedule::base> _inner;
+    };
+  }
+}
+#endif
@@ -0,0 +1,138 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "sparse_network.h"
+#include "kernels.h"
+#include <stdexcept>
+
+namespace mp {
+  sparse_network::sparse_network(const network &net) {
+    if( net.weight_storage() != storage::float64 ) {
+      throw invalid_argument("sparse_network: the weights must be stored as double");
+    }
+
+    auto weights = net.weights();
+    unsigned int position = 0;
+
+    _stage = net.output_stage();
+    _layers.resize( net.layers() );
+
+    for(unsigned int i = 0; i < net.layers(); i++) {
+      auto &l = _layers[i];
+      l.rows = net.layer_size( i );
+      l.columns = net.layer_inputs( i );
+      l.kind = net.activation( i );
+
+      if( l.kind == activation_kind::custom ) {
+        throw invalid_argument("sparse_network: every layer needs a single activation");
+      }
+
+      l.offsets.assign( 1, 0 );
+      for(unsigned int r = 0; r < l.rows; r++) {
+        for(unsigned int c = 0; c < l.columns; c++) {
+          double value = weights[position + r * l.columns + c];
+          if( value == 0.0 ) continue;
+
+          l.indices.push_back( c );
+          l.values.push_back( value );
+        }
+
+        l.offsets.push_back( l.values.size() );
+      }
+
+      position += l.rows * l.columns;
+      l.biases.assign( weights.begin() + position, weights.begin() + position + l.rows );
+      position += l.rows;
+    }
+  }
+
+  unsigned int sparse_network::layers() const {
+    return _layers.size();
+  }
+
+  unsigned int sparse_network::inputs() const {
+    return _layers.front().columns;
+  }
+
+  unsigned int sparse_network::outputs() const {
+    return _layers.back().rows;
+  }
+
+  const sparse_layer& sparse_network::layer(const unsigned int &index) const {
+    return _layers.at( index );
+  }
+
+  unsigned long long sparse_network::factors() const {
+    unsigned long long result = 0;
+    for( auto &l : _layers ) result += static_cast<unsigned long long>( l.rows ) * l.columns;
+    return result;
+  }
+
+  unsigned long long sparse_network::nonzeros() const {
+    unsigned long long result = 0;
+    for( auto &l : _layers ) result += l.values.size();
+    return result;
+  }
+
+  double sparse_network::sparsity() const {
+    return ( factors() == 0 ) ? 0.0 : 1.0 - static_cast<double>( nonzeros() ) / factors();
+  }
+
+  vector<double> sparse_network::output(const vector<double> &inputs) const {
+    vector<vector<double>> results;
+    predict( { &inputs }, results );
+    return results[0];
+  }
+
+  void sparse_network::predict(const vector<const vector<double> *> &inputs,
+                               vector<vector<double>> &outputs) const {
+    unsigned int batch = inputs.size();
+    vector<double> current( batch * this->inputs() );
+    vector<double> next;
+
+    for(unsigned int s = 0; s < batch; s++) {
+      if( inputs[s]->size() != this->inputs() ) {
+        throw invalid_argument("sparse_network::predict: the sample does not fit the network");
+      }
+
+      copy( inputs[s]->begin(), inputs[s]->end(), current.begin() + s * this->inputs() );
+    }
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      auto &l = _layers[i];
+
+      next.resize( batch * l.rows );
+      kernels::forward_sparse(l.offsets.data(), l.indices.data(), l.values.data(),
+                              l.biases.data(), current.data(), next.data(), l.rows, l.columns,
+                              batch);
+
+      if(( i == layers() - 1 ) && ( _stage == stage::softmax )) {
+        kernels::softmax(next.data(), l.rows, batch);
+      } else {
+        kernels::activate(l.kind, next.data(), batch * l.rows);
+      }
+
+      current.swap( next );
+    }
+
+    unsigned int size = this->outputs();
+    outputs.resize( batch );
+    for(unsigned int s = 0; s < batch; s++) {
+      outputs[s].assign( current.begin() + s * size, current.begin() + (s + 1) * size );
+    }
+  }
+}
@@ -0,0 +1,127 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___SPARSE_NETWORK___
+#define ___SPARSE_NETWORK___
+#include <vector>
+#include "network.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \brief Layer of a sparse network: its factors in compressed sparse rows, and its biases.
+   *
+   * The factors of row r are values[offsets[r]] to values[offsets[r + 1] - 1], and indices
+   * holds the column of each one.
+   * */
+  struct sparse_layer {
+    unsigned int rows;
+    unsigned int columns;
+    activation_kind kind;
+    vector<unsigned int> offsets;
+    vector<unsigned int> indices;
+    vector<double> values;
+    vector<double> biases;
+  };
+
+  /**
+   * \class sparse_network sparse_network.h
+   * \brief Read-only copy of a pruned network that only stores its non-zero factors.
+   *
+   * Each layer keeps the factors that are not zero in compressed sparse rows, and the forward
+   * pass only multiplies those, so its cost falls with the sparsity of the network. The zero
+   * factors add nothing to the weighted sums, which are therefore the same, bit by bit, as the
+   * ones of the network it was built from.
+   * */
+  class sparse_network {
+    public:
+      /**
+       * It builds the sparse copy of a network
+       * \param net the network to copy
+       * \throw invalid_argument if some layer does not have a single, known activation, or the
+       * network does not store its weights as double
+       * */
+      explicit sparse_network(const network &net);
+
+      /**
+       * It returns the number of layers
+       * \return the number of layers
+       * */
+      unsigned int layers() const;
+
+      /**
+       * It returns the number of inputs of the network
+       * \return the number of inputs
+       * */
+      unsigned int inputs() const;
+
+      /**
+       * It returns the number of outputs of the network
+       * \return the number of outputs
+       * */
+      unsigned int outputs() const;
+
+      /**
+       * It returns a layer of the network
+       * \param index index of the layer
+       * \return the layer
+       * */
+      const sparse_layer& layer(const unsigned int &index) const;
+
+      /**
+       * It returns the number of factors of the dense network, biases excluded
+       * \return the number of factors
+       * */
+      unsigned long long factors() const;
+
+      /**
+       * It returns the number of stored factors
+       * \return the number of non-zero factors
+       * */
+      unsigned long long nonzeros() const;
+
+      /**
+       * It returns the fraction of factors that are zero
+       * \return a value between 0 and 1
+       * */
+      double sparsity() const;
+
+      /**
+       * It computes the outputs of the network
+       * \param inputs the inputs of the network
+       * \return the outputs of the network
+       * \throw invalid_argument if the inputs do not fit the network
+       * */
+      vector<double> output(const vector<double> &inputs) const;
+
+      /**
+       * It computes the network outputs of a block of samples, as network::predict does. It
+       * does not change the network, so several threads can call it at the same time.
+       * \param inputs  pointers to the inputs of each sample
+       * \param outputs it receives the network outputs of each sample
+       * \throw invalid_argument if a sample does not fit the network
+       * */
+      void predict(const vector<const vector<double> *> &inputs,
+                   vector<vector<double>> &outputs) const;
+
+    private:
+      vector<sparse_layer> _layers;
+      stage _stage;
+  };
+}
+#endif
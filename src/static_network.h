@@ -0,0 +1,230 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___STATIC_NETWORK___
+#define ___STATIC_NETWORK___
+#include <array>
+#include <vector>
+#include <stdexcept>
+#include "network.h"
+#include "kernels.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * It computes the weighted sums of a layer of fixed shape for one sample, in the same order
+   * as kernels::forward, so the results are the same bit by bit. The bounds are known at
+   * compile time, so the loops can be fully unrolled.
+   * \param parameters Rows x Columns factors, followed by Rows biases
+   * \param inputs     Columns inputs
+   * \param outputs    Rows weighted sums
+   * */
+  template <unsigned int Rows, unsigned int Columns>
+  inline void static_forward(const double *parameters, const double *inputs, double *outputs) {
+    const double *bias = parameters + Rows * Columns;
+
+    for(unsigned int r = 0; r < Rows; r++) {
+      const double *w = parameters + r * Columns;
+      double sum = bias[r];
+
+      for(unsigned int c = 0; c < Columns; c++) {
+        sum = kernels::multiply_add( inputs[c], w[c], sum );
+      }
+
+      outputs[r] = sum;
+    }
+  }
+
+  /**
+   * \brief The layers of a static_network, from a layer with Columns inputs and Rows neurons
+   * to the output layer.
+   * */
+  template <unsigned int Columns, unsigned int Rows, unsigned int... Rest>
+  struct static_layers {
+    static constexpr unsigned int parameters() {
+      return Rows * (Columns + 1) + static_layers<Rows, Rest...>::parameters();
+    }
+
+    static void output(const double *parameters, const activation_kind *kinds, const stage &last,
+                       const double *inputs, double *outputs) {
+      double values[Rows];
+      static_forward<Rows, Columns>( parameters, inputs, values );
+      kernels::activate( kinds[0], values, Rows );
+
+      static_layers<Rows, Rest...>::output( parameters + Rows * (Columns + 1), kinds + 1, last,
+                                            values, outputs );
+    }
+  };
+
+  template <unsigned int Columns, unsigned int Rows>
+  struct static_layers<Columns, Rows> {
+    static constexpr unsigned int parameters() {
+      return Rows * (Columns + 1);
+    }
+
+    static void output(const double *parameters, const activation_kind *kinds, const stage &last,
+                       const double *inputs, double *outputs) {
+      static_forward<Rows, Columns>( parameters, inputs, outputs );
+
+      if( last == stage::softmax ) kernels::softmax( outputs, Rows, 1 );
+      else kernels::activate( kinds[0], outputs, Rows );
+    }
+  };
+
+  /**
+   * \class static_network static_network.h
+   * \brief A network whose topology is fixed at compile time, for fast inference.
+   *
+   * static_network<Inputs, Hidden..., Outputs> has Inputs inputs, one hidden layer per size in
+   * Hidden, and Outputs outputs. All the weights live in one std::array with the layout of
+   * network::weights(), every shape is a constant expression, and there are no virtual calls,
+   * no vectors and no bounds checks. It is built from a trained network, and it gives the
+   * same outputs as that network, bit by bit. Every layer must have a single activation.
+   * */
+  template <unsigned int Inputs, unsigned int... Layers>
+  class static_network {
+    static_assert( sizeof...(Layers) > 0, "A static_network needs an output layer" );
+
+    public:
+      /**
+       * It returns the number of inputs
+       * \return the number of inputs
+       * */
+      static constexpr unsigned int inputs() {
+        return Inputs;
+      }
+
+      /**
+       * It returns the number of layers, the output layer included
+       * \return the number of layers
+       * */
+      static constexpr unsigned int layers() {
+        return sizeof...(Layers);
+      }
+
+      /**
+       * It returns the number of neurons of a layer
+       * \param layer_index index of the layer
+       * \return the size of the layer
+       * */
+      static constexpr unsigned int layer_size(const unsigned int &layer_index) {
+        const unsigned int sizes[] = { Layers... };
+        return sizes[layer_index];
+      }
+
+      /**
+       * It returns the number of outputs
+       * \return the size of the output layer
+       * */
+      static constexpr unsigned int outputs() {
+        return layer_size( layers() - 1 );
+      }
+
+      /**
+       * It returns the number of factors and biases of the network
+       * \return the size of weights()
+       * */
+      static constexpr unsigned int parameters() {
+        return static_layers<Inputs, Layers...>::parameters();
+      }
+
+      /**
+       * It copies a network with the same topology
+       * \param net the network to copy
+       * \throw invalid_argument if the topology is not the same, a layer has mixed or custom
+       * neurons, or the network does not store its weights as double
+       * */
+      explicit static_network(const network &net) {
+        if( net.weight_storage() != storage::float64 ) {
+          throw invalid_argument("static_network: the weights must be stored as double");
+        }
+
+        if(( net.layers() != layers() ) || ( net.layer_inputs( 0 ) != Inputs )) {
+          throw invalid_argument("static_network: the network topology is not the same");
+        }
+
+        for(unsigned int i = 0; i < layers(); i++) {
+          if( net.layer_size( i ) != layer_size( i ) ) {
+            throw invalid_argument("static_network: the network topology is not the same");
+          }
+
+          _kinds[i] = net.activation( i );
+          if( _kinds[i] == activation_kind::custom ) {
+            throw invalid_argument("static_network: every layer needs a single activation");
+          }
+        }
+
+        _stage = net.output_stage();
+
+        auto values = net.weights();
+        copy( values.begin(), values.end(), _weights.begin() );
+      }
+
+      /**
+       * It computes the outputs of the network
+       * \param inputs the inputs of the network
+       * \return the outputs of the network
+       * */
+      array<double, outputs()> output(const array<double, Inputs> &inputs) const {
+        array<double, outputs()> result;
+        output( inputs.data(), result.data() );
+        return result;
+      }
+
+      /**
+       * It computes the outputs of the network
+       * \param inputs  Inputs values
+       * \param outputs buffer for outputs() values
+       * */
+      void output(const double *inputs, double *outputs) const {
+        static_layers<Inputs, Layers...>::output( _weights.data(), _kinds.data(), _stage, inputs,
+                                                  outputs );
+      }
+
+      /**
+       * It returns the weights of the network, with the layout of network::weights()
+       * \return the factors and biases of every layer
+       * */
+      const array<double, parameters()>& weights() const {
+        return _weights;
+      }
+
+      /**
+       * It returns the activation of a layer
+       * \param layer_index index of the layer
+       * \return the activation of the layer
+       * */
+      activation_kind activation(const unsigned int &layer_index) const {
+        return _kinds.at( layer_index );
+      }
+
+      /**
+       * It returns the output stage
+       * \return the output stage
+       * */
+      stage output_stage() const {
+        return _stage;
+      }
+
+    private:
+      alignas(64) array<double, parameters()> _weights;
+      array<activation_kind, layers()> _kinds;
+      stage _stage;
+  };
+}
+#endif
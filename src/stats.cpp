@@ -0,0 +1,106 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "stats.h"
+
+namespace mp {
+  const phase_stats empty_phase_stats = { 0, 0.0, 0, 0 };
+
+  stats::stats() {
+  }
+
+  stats::stats(const unsigned int &layers) {
+    resize( layers );
+  }
+
+  void stats::resize(const unsigned int &layers) {
+    array<phase_stats, phases_count> empty;
+    empty.fill( empty_phase_stats );
+    _layers.resize( layers, empty );
+  }
+
+  void stats::record(const unsigned int &layer, const phase &p, const double &seconds,
+                     const unsigned long long &flops, const unsigned long long &bytes) {
+    if( layer >= _layers.size() ) resize( layer + 1 );
+
+    auto &counters = _layers[layer][static_cast<unsigned int>( p )];
+    counters.calls++;
+    counters.seconds += seconds;
+    counters.flops += flops;
+    counters.bytes += bytes;
+  }
+
+  void stats::reset() {
+    for( auto &layer : _layers ) {
+      layer.fill( empty_phase_stats );
+    }
+  }
+
+  unsigned int stats::layers() const {
+    return _layers.size();
+  }
+
+  const phase_stats& stats::at(const unsigned int &layer, const phase &p) const {
+    return _layers.at( layer ).at( static_cast<unsigned int>( p ) );
+  }
+
+  phase_stats stats::total(const phase &p) const {
+    phase_stats result = empty_phase_stats;
+
+    for(unsigned int i = 0; i < layers(); i++) {
+      auto &counters = at(i, p);
+      result.calls += counters.calls;
+      result.seconds += counters.seconds;
+      result.flops += counters.flops;
+      result.bytes += counters.bytes;
+    }
+
+    return result;
+  }
+
+  phase_stats stats::total(const unsigned int &layer) const {
+    phase_stats result = empty_phase_stats;
+
+    for( auto &counters : _layers.at( layer ) ) {
+      result.calls += counters.calls;
+      result.seconds += counters.seconds;
+      result.flops += counters.flops;
+      result.bytes += counters.bytes;
+    }
+
+    return result;
+  }
+
+  bool stats::enabled() {
+#ifdef MP_NETWORK_STATS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  stats_timer::stats_timer(stats &recorder, const unsigned int &layer, const phase &p,
+                           const unsigned long long &flops, const unsigned long long &bytes) :
+  _recorder(recorder), _layer(layer), _phase(p), _flops(flops), _bytes(bytes) {
+    _start = chrono::steady_clock::now();
+  }
+
+  stats_timer::~stats_timer() {
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - _start;
+    _recorder.record(_layer, _phase, elapsed.count(), _flops, _bytes);
+  }
+}
@@ -0,0 +1,165 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___STATS___
+#define ___STATS___
+#include <vector>
+#include <array>
+#include <chrono>
+
+using namespace std;
+
+/*
+ * The instrumentation is only compiled when MP_NETWORK_STATS is defined (make STATS=1).
+ * Otherwise MP_STATS_SCOPE expands to nothing and the network hot path is left untouched.
+ * The timer is named after the line, so scopes can nest.
+ * */
+#define MP_STATS_CONCAT_(a, b) a##b
+#define MP_STATS_NAME_(line) MP_STATS_CONCAT_(mp_stats_timer_, line)
+
+#ifdef MP_NETWORK_STATS
+#define MP_STATS_SCOPE(recorder, layer, phase, flops, bytes) \
+  mp::stats_timer MP_STATS_NAME_(__LINE__)(recorder, layer, phase, flops, bytes)
+#else
+#define MP_STATS_SCOPE(recorder, layer, phase, flops, bytes)
+#endif
+
+namespace mp {
+  /**
+   * Phases of the network that are measured by the instrumentation layer.
+   * */
+  enum class phase : unsigned int {
+    forward = 0,
+    output_deltas,
+    hidden_deltas,
+    neuron_factors,
+    adjust_weights
+  };
+
+  const unsigned int phases_count = 5;
+
+  /**
+   * \brief Counters collected for one phase of one layer.
+   * */
+  struct phase_stats {
+    unsigned long calls;
+    double seconds;
+    unsigned long long flops;
+    unsigned long long bytes;
+  };
+
+  /**
+   * \class stats stats.h
+   * \brief It stores the per-layer and per-phase counters of a network.
+   *
+   * Each record adds the wall time, one call, and the estimated floating point operations
+   * and bytes moved by the phase. A stats object is a plain value, so a copy of it is a
+   * snapshot of the counters at that moment.
+   * */
+  class stats {
+    public:
+      /**
+       * It builds an empty stats object, without layers.
+       * */
+      stats();
+
+      /**
+       * It builds a stats object with all counters at zero for the given layers
+       * \param layers number of layers to track
+       * */
+      stats(const unsigned int &layers);
+
+      /**
+       * It changes the number of tracked layers. New layers start with zero counters.
+       * \param layers number of layers to track
+       * */
+      void resize(const unsigned int &layers);
+
+      /**
+       * It adds a call to the counters of the given layer and phase
+       * \param layer   index of the layer
+       * \param p       measured phase
+       * \param seconds wall time spent in the call
+       * \param flops   estimated floating point operations of the call
+       * \param bytes   estimated bytes moved by the call
+       * */
+      void record(const unsigned int &layer, const phase &p, const double &seconds,
+                  const unsigned long long &flops, const unsigned long long &bytes);
+
+      /**
+       * It sets all counters to zero, keeping the number of layers.
+       * */
+      void reset();
+
+      /**
+       * It returns the number of tracked layers
+       * \return the number of tracked layers
+       * */
+      unsigned int layers() const;
+
+      /**
+       * It returns the counters of the given layer and phase
+       * \param layer index of the layer
+       * \param p     phase to read
+       * \return the counters of the layer in that phase
+       * */
+      const phase_stats& at(const unsigned int &layer, const phase &p) const;
+
+      /**
+       * It returns the counters of one phase added over all layers
+       * \param p phase to read
+       * \return the counters of the phase in the whole network
+       * */
+      phase_stats total(const phase &p) const;
+
+      /**
+       * It returns the counters of one layer added over all phases
+       * \param layer index of the layer
+       * \return the counters of the layer in all phases
+       * */
+      phase_stats total(const unsigned int &layer) const;
+
+      /**
+       * It checks if the instrumentation was compiled in.
+       * \return true if MP_NETWORK_STATS was defined at build time, false otherwise
+       * */
+      static bool enabled();
+
+    private:
+      vector<array<phase_stats, phases_count>> _layers;
+  };
+
+  /**
+   * \class stats_timer stats.h
+   * \brief It measures the lifetime of a scope and records it in a stats object.
+   * */
+  class stats_timer {
+    public:
+      stats_timer(stats &recorder, const unsigned int &layer, const phase &p,
+                  const unsigned long long &flops, const unsigned long long &bytes);
+      ~stats_timer();
+
+    private:
+      stats &_recorder;
+      unsigned int _layer;
+      phase _phase;
+      unsigned long long _flops;
+      unsigned long long _bytes;
+      chrono::steady_clock::time_point _start;
+  };
+}
+#endif
@@ -0,0 +1,146 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "thread_pool.h"
+#include <algorithm>
+
+namespace mp {
+  thread_pool::thread_pool(const unsigned int &threads) {
+    _queued = 0;
+    _pending = 0;
+    _next = 0;
+    _idle = 0;
+    _steals = 0;
+    _stopping = false;
+
+    unsigned int count = max( threads, 1U );
+    for(unsigned int i = 0; i < count; i++) {
+      _queues.push_back( unique_ptr<queue>( new queue() ) );
+    }
+
+    for(unsigned int i = 0; i < count; i++) {
+      _workers.push_back( thread( &thread_pool::work, this, i ) );
+    }
+  }
+
+  thread_pool::~thread_pool() {
+    {
+      unique_lock<mutex> guard( _lock );
+      _done.wait( guard, [this] { return _pending == 0; } );
+      _stopping = true;
+    }
+
+    _ready.notify_all();
+    for( auto &worker : _workers ) worker.join();
+  }
+
+  void thread_pool::submit(const function<void()> &task) {
+    auto &target = *(_queues[_next++ % _queues.size()]);
+    _pending++;
+
+    {
+      lock_guard<mutex> guard( target.lock );
+      target.tasks.push_back( task );
+    }
+
+    // A worker counts itself idle before it checks the queued tasks, so either it sees this
+    // task or it is seen here and woken under the pool lock
+    _queued++;
+    if( _idle > 0 ) {
+      { lock_guard<mutex> guard( _lock ); }
+      _ready.notify_one();
+    }
+  }
+
+  void thread_pool::wait() {
+    unique_lock<mutex> guard( _lock );
+    _done.wait( guard, [this] { return _pending == 0; } );
+
+    if( _error ) {
+      auto error = _error;
+      _error = nullptr;
+      rethrow_exception( error );
+    }
+  }
+
+  unsigned int thread_pool::threads() const {
+    return _workers.size();
+  }
+
+  unsigned long thread_pool::steals() const {
+    return _steals;
+  }
+
+  bool thread_pool::take(const unsigned int &index, function<void()> &task) {
+    {
+      auto &own = *(_queues[index]);
+      lock_guard<mutex> guard( own.lock );
+
+      if( not own.tasks.empty() ) {
+        task = move( own.tasks.back() );
+        own.tasks.pop_back();
+        _queued--;
+        return true;
+      }
+    }
+
+    for(unsigned int k = 1; k < _queues.size(); k++) {
+      auto &other = *(_queues[(index + k) % _queues.size()]);
+      lock_guard<mutex> guard( other.lock );
+
+      if( not other.tasks.empty() ) {
+        task = move( other.tasks.front() );
+        other.tasks.pop_front();
+        _queued--;
+        _steals++;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void thread_pool::work(const unsigned int &index) {
+    function<void()> task;
+
+    while( true ) {
+      if( not take( index, task ) ) {
+        unique_lock<mutex> guard( _lock );
+        _idle++;
+        _ready.wait( guard, [this] { return _stopping || _queued > 0; } );
+        _idle--;
+
+        if(( _stopping ) && ( _queued == 0 )) return;
+        continue;
+      }
+
+      try {
+        task();
+      } catch( ... ) {
+        lock_guard<mutex> guard( _lock );
+        if( not _error ) _error = current_exception();
+      }
+
+      task = nullptr;
+
+      if( --_pending == 0 ) {
+        { lock_guard<mutex> guard( _lock ); }
+        _done.notify_all();
+      }
+    }
+  }
+}
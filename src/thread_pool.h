@@ -0,0 +1,106 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___THREAD_POOL___
+#define ___THREAD_POOL___
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+using namespace std;
+
+namespace mp {
+  /**
+   * \class thread_pool thread_pool.h
+   * \brief A fixed set of worker threads with one task queue each.
+   *
+   * Submitted tasks are dealt to the queues in turn. A worker takes the newest task of its
+   * own queue, and when it runs out of work it steals the oldest task of another queue, so
+   * long tasks do not leave the rest of the workers idle. Only the queue locks are taken to
+   * submit and run a task; a worker parks on the pool lock once every queue is empty.
+   * */
+  class thread_pool {
+    public:
+      /**
+       * It starts the workers
+       * \param threads number of worker threads (at least one)
+       * */
+      thread_pool(const unsigned int &threads);
+
+      thread_pool(const thread_pool &) = delete;
+      thread_pool& operator=(const thread_pool &) = delete;
+
+      /**
+       * It waits for the pending tasks and stops the workers
+       * */
+      ~thread_pool();
+
+      /**
+       * It queues a task
+       * \param task function to run in one of the workers
+       * */
+      void submit(const function<void()> &task);
+
+      /**
+       * It blocks until every submitted task has finished
+       * \throw the first exception thrown by a task since the last wait
+       * */
+      void wait();
+
+      /**
+       * It returns the number of worker threads
+       * \return the number of workers
+       * */
+      unsigned int threads() const;
+
+      /**
+       * It returns the number of tasks that were taken from another worker queue
+       * \return the number of stolen tasks
+       * */
+      unsigned long steals() const;
+
+    private:
+      struct queue {
+        mutex lock;
+        deque<function<void()>> tasks;
+      };
+
+      vector<unique_ptr<queue>> _queues;
+      vector<thread> _workers;
+
+      mutex _lock;
+      condition_variable _ready;
+      condition_variable _done;
+      atomic<unsigned long> _queued;
+      atomic<unsigned long> _pending;
+      atomic<unsigned long> _next;
+      atomic<unsigned int> _idle;
+      atomic<unsigned long> _steals;
+      bool _stopping;
+      exception_ptr _error;
+
+      void work(const unsigned int &index);
+      bool take(const unsigned int &index, function<void()> &task);
+  };
+}
+#endif
@@ -0,0 +1,238 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "trainer.h"
+#include <random>
+#include <algorithm>
+#include <numeric>
+
+namespace mp {
+  trainer::trainer() {
+    _epochs = 100;
+    _early_stopping = false;
+    _patience = 0;
+    _min_delta = 0.0;
+    _criterion = criterion::mse;
+    _restore_best = true;
+    _shuffle = false;
+    _seed = 0;
+    _batch = 1;
+  }
+
+  void trainer::epochs(const unsigned int &epochs) {
+    _epochs = epochs;
+  }
+
+  void trainer::schedule(const shared_ptr<mp::schedule::base> &s) {
+    _schedule = s;
+  }
+
+  void trainer::early_stopping(const unsigned int &patience, const double &min_delta,
+                               const criterion &watched) {
+    _early_stopping = true;
+    _patience = patience;
+    _min_delta = min_delta;
+    _criterion = watched;
+  }
+
+  void trainer::restore_best(const bool &restore) {
+    _restore_best = restore;
+  }
+
+  void trainer::shuffle(const unsigned int &seed) {
+    _shuffle = true;
+    _seed = seed;
+  }
+
+  void trainer::batch_size(const unsigned int &size) {
+    _batch = max( size, 1U );
+  }
+
+  void trainer::validation_evaluator(const evaluator &e) {
+    _evaluator = e;
+  }
+
+  unsigned int trainer::epochs() const {
+    return _epochs;
+  }
+
+  shared_ptr<mp::schedule::base> trainer::schedule() const {
+    return _schedule;
+  }
+
+  unsigned int trainer::batch_size() const {
+    return _batch;
+  }
+
+  evaluator trainer::validation_evaluator() const {
+    return _evaluator;
+  }
+
+  training_report trainer::train(network &net, const data &training, const data &validation) const {
+    vector<network *> models( 1, &net );
+    return train( models, training, validation ).front();
+  }
+
+  vector<training_report> trainer::train(const vector<network *> &models, const data &training,
+                                         const data &validation) const {
+    unsigned int count = models.size();
+    vector<training_report> reports( count );
+    vector<vector<double>> best_weights( count );
+    vector<unsigned int> waiting( count, 0 );
+    vector<epoch_report> current( count );
+
+    for( auto &report : reports ) {
+      report.epochs = 0;
+      report.best_epoch = 0;
+      report.best_score = 0.0;
+      report.stopped_early = false;
+      report.peak_memory = 0;
+    }
+
+    bool stacked = true;
+    for( auto model : models ) {
+      if( not models.front()->stackable( *model ) ) stacked = false;
+    }
+
+    vector<unsigned int> order( training.elements() );
+    iota( order.begin(), order.end(), 0 );
+    mt19937 generator( _seed );
+
+    // Indices of the networks that are still training
+    vector<unsigned int> active( count );
+    iota( active.begin(), active.end(), 0 );
+
+    vector<network *> running;
+    vector<const vector<double> *> batch_inputs;
+    vector<const vector<double> *> batch_expected;
+
+    for(unsigned int epoch = 0; ( epoch < _epochs ) && ( not active.empty() ); epoch++) {
+      running.clear();
+
+      for( auto m : active ) {
+        auto &net = *(models[m]);
+
+        current[m].epoch = epoch;
+        current[m].training_mse = 0.0;
+
+        if( _schedule ) net.optimizer()->learning_rate( _schedule->rate( epoch ) );
+        current[m].learning_rate = net.optimizer()->learning_rate();
+        running.push_back( &net );
+      }
+
+      if( _shuffle ) std::shuffle( order.begin(), order.end(), generator );
+
+      for(unsigned int start = 0; start < order.size(); start += _batch) {
+        unsigned int size = min( _batch, (unsigned int) order.size() - start );
+
+        // The data set owns the samples, so the pointers outlive the locks
+        batch_inputs.resize( size );
+        batch_expected.resize( size );
+        for(unsigned int s = 0; s < size; s++) {
+          batch_inputs[s] = training.input( order[start + s] ).lock().get();
+          batch_expected[s] = training.output( order[start + s] ).lock().get();
+        }
+
+        if(( stacked ) && ( running.size() > 1 )) {
+          network::backpropagate_stacked( running, batch_inputs, batch_expected );
+        } else {
+          for( auto net : running ) net->backpropagate( batch_inputs, batch_expected );
+        }
+
+        // The outputs of the forward pass are still available after the backpropagation
+        for( auto m : active ) {
+          auto outputs = models[m]->batch_outputs();
+          unsigned int width = outputs.size() / size;
+
+          for(unsigned int s = 0; s < size; s++) {
+            for(unsigned int k = 0; k < width; k++) {
+              double error = (*batch_expected[s])[k] - outputs[s * width + k];
+              current[m].training_mse += error * error;
+            }
+          }
+        }
+      }
+
+      vector<unsigned int> still_active;
+      for( auto m : active ) {
+        auto &net = *(models[m]);
+        auto &report = reports[m];
+
+        if( training.elements() > 0 ) {
+          current[m].training_mse /= static_cast<double>( training.elements() ) *
+                                     training.outputs_length();
+        }
+
+        current[m].validation = _evaluator.evaluate( net, validation );
+        report.history.push_back( current[m] );
+        report.epochs++;
+
+        double value = score( current[m].validation, _criterion );
+        if(( epoch == 0 ) || ( value < report.best_score - _min_delta )) {
+          report.best_score = value;
+          report.best_epoch = epoch;
+          waiting[m] = 0;
+          if( _restore_best ) best_weights[m] = net.weights();
+        }
+        else {
+          waiting[m]++;
+          if(( _early_stopping ) && ( waiting[m] > _patience )) {
+            report.stopped_early = true;
+            continue;
+          }
+        }
+
+        still_active.push_back( m );
+      }
+
+      active.swap( still_active );
+    }
+
+    for(unsigned int m = 0; m < count; m++) {
+      if(( _restore_best ) && ( not best_weights[m].empty() )) {
+        models[m]->weights( best_weights[m] );
+      }
+
+      reports[m].peak_memory = models[m]->activation_memory( min( _batch, training.elements() ) );
+    }
+
+    return reports;
+  }
+
+  training_report trainer::train(network &net, const data &training) const {
+    return train( net, training, training );
+  }
+
+  bool trainer::compatible(const trainer &other) const {
+    return ( _epochs == other._epochs ) && ( _schedule == other._schedule ) &&
+           ( _early_stopping == other._early_stopping ) && ( _patience == other._patience ) &&
+           ( _min_delta == other._min_delta ) && ( _criterion == other._criterion ) &&
+           ( _restore_best == other._restore_best ) && ( _shuffle == other._shuffle ) &&
+           ( _seed == other._seed ) && ( _batch == other._batch );
+  }
+
+  double trainer::score(const metrics &m, const criterion &watched) {
+    switch( watched ) {
+      case criterion::cross_entropy:
+        return m.cross_entropy;
+      case criterion::accuracy:
+        return -m.accuracy;
+      default:
+        return m.mse;
+    }
+  }
+}
@@ -0,0 +1,211 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___TRAINER___
+#define ___TRAINER___
+#include <vector>
+#include <memory>
+#include "network.h"
+#include "data.h"
+#include "evaluation.h"
+#include "schedule.h"
+
+using namespace std;
+
+namespace mp {
+  /**
+   * Validation metric watched by the early stopping.
+   * */
+  enum class criterion {
+    mse,
+    cross_entropy,
+    accuracy
+  };
+
+  /**
+   * \brief Summary of one training epoch.
+   * */
+  struct epoch_report {
+    unsigned int epoch;
+    double learning_rate;
+    double training_mse;
+    metrics validation;
+  };
+
+  /**
+   * \brief Summary of a whole training.
+   * */
+  struct training_report {
+    unsigned int epochs;
+    unsigned int best_epoch;
+    double best_score;
+    bool stopped_early;
+    size_t peak_memory; //!< Activation memory of the biggest mini-batch, see activation_memory
+    vector<epoch_report> history;
+  };
+
+  /**
+   * \class trainer trainer.h
+   * \brief It trains a network over a data set, epoch by epoch.
+   *
+   * Before each epoch, the learning rate of the network optimizer is taken from the schedule
+   * (if any). After each epoch the network is evaluated over the validation set. When the
+   * watched metric does not improve by at least min_delta during patience epochs the training
+   * stops, and the weights of the best epoch are restored.
+   * */
+  class trainer {
+    public:
+      /**
+       * It builds a trainer of 100 epochs, without schedule and without early stopping
+       * */
+      trainer();
+
+      /**
+       * It sets the maximum number of epochs
+       * \param epochs maximum number of epochs
+       * */
+      void epochs(const unsigned int &epochs);
+
+      /**
+       * It sets the learning rate schedule. A null schedule keeps the optimizer learning rate.
+       * \param s the learning rate schedule
+       * */
+      void schedule(const shared_ptr<mp::schedule::base> &s);
+
+      /**
+       * It enables the early stopping
+       * \param patience  epochs without improvement before stopping
+       * \param min_delta minimum change of the metric that counts as an improvement
+       * \param watched   validation metric to watch
+       * */
+      void early_stopping(const unsigned int &patience, const double &min_delta,
+                          const criterion &watched);
+
+      /**
+       * It sets if the weights of the best epoch are restored at the end (true by default)
+       * \param restore true to restore the best weights
+       * */
+      void restore_best(const bool &restore);
+
+      /**
+       * It sets the seed used to shuffle the samples every epoch. The samples are not
+       * shuffled by default.
+       * \param seed seed of the shuffle
+       * */
+      void shuffle(const unsigned int &seed);
+
+      /**
+       * It sets how many samples are trained together. Each mini-batch goes through
+       * network::backpropagate, so its gradients are averaged, it is trained in chunks of the
+       * compiled capacity, and the checkpoints of the network (see network::checkpoint) apply
+       * to it. The samples are trained one by one by default.
+       * \param size samples of each mini-batch, 0 is taken as 1
+       * */
+      void batch_size(const unsigned int &size);
+
+      /**
+       * It sets the evaluator used over the validation set
+       * \param e the evaluator
+       * */
+      void validation_evaluator(const evaluator &e);
+
+      /**
+       * It returns the maximum number of epochs
+       * \return the maximum number of epochs
+       * */
+      unsigned int epochs() const;
+
+      /**
+       * It returns the learning rate schedule
+       * \return the schedule, or null if the optimizer learning rate is kept
+       * */
+      shared_ptr<mp::schedule::base> schedule() const;
+
+      /**
+       * It returns how many samples are trained together
+       * \return samples of each mini-batch
+       * */
+      unsigned int batch_size() const;
+
+      /**
+       * It returns the evaluator used over the validation set
+       * \return the evaluator
+       * */
+      evaluator validation_evaluator() const;
+
+      /**
+       * It trains the network
+       * \param net        the network to train
+       * \param training   samples used to train
+       * \param validation samples used to decide when to stop
+       * \return the training summary
+       * */
+      training_report train(network &net, const data &training, const data &validation) const;
+
+      /**
+       * It trains the network using the training samples as validation set
+       * \param net      the network to train
+       * \param training samples used to train
+       * \return the training summary
+       * */
+      training_report train(network &net, const data &training) const;
+
+      /**
+       * It trains several networks in lockstep: every network sees the same samples in the
+       * same order, and each one is evaluated, stopped and restored on its own. When all of
+       * them are stackable (see network::stackable) each sample runs through all of them with
+       * network::backpropagate_stacked. The reports are the same as training each network
+       * alone with this trainer.
+       * \param models     the networks to train
+       * \param training   samples used to train
+       * \param validation samples used to decide when to stop
+       * \return the training summary of each network, in the same order
+       * */
+      vector<training_report> train(const vector<network *> &models, const data &training,
+                                    const data &validation) const;
+
+      /**
+       * It checks if another trainer has the same settings, so the networks of both can be
+       * trained in lockstep by any of them
+       * \param other trainer to compare with
+       * \return true if both trainers would train in the same way
+       * */
+      bool compatible(const trainer &other) const;
+
+      /**
+       * It returns the value of the watched metric
+       * \param m       the evaluation metrics
+       * \param watched the watched metric
+       * \return the value of the metric, negated for the accuracy, so lower is always better
+       * */
+      static double score(const metrics &m, const criterion &watched);
+
+    private:
+      unsigned int _epochs;
+      shared_ptr<mp::schedule::base> _schedule;
+      bool _early_stopping;
+      unsigned int _patience;
+      double _min_delta;
+      criterion _criterion;
+      bool _restore_best;
+      bool _shuffle;
+      unsigned int _seed;
+      unsigned int _batch;
+      evaluator _evaluator;
+  };
+}
+#endif
@@ -0,0 +1,192 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "transport.h"
+#include <stdexcept>
+#include <algorithm>
+#include <initializer_list>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+namespace mp {
+  namespace transport {
+    base::base(const unsigned int &rank, const unsigned int &size) :
+    _rank(rank), _size(size) {
+      if( rank >= size ) {
+        throw invalid_argument( "transport::base: the rank must be lower than the size" );
+      }
+    }
+
+    base::~base() {
+    }
+
+    unsigned int base::rank() const {
+      return _rank;
+    }
+
+    unsigned int base::size() const {
+      return _size;
+    }
+
+    static sockaddr_in address(const string &host, const unsigned int &port) {
+      sockaddr_in result;
+      memset( &result, 0, sizeof( result ) );
+      result.sin_family = AF_INET;
+      result.sin_port = htons( port );
+
+      if( inet_pton( AF_INET, host.c_str(), &result.sin_addr ) != 1 ) {
+        throw invalid_argument( "transport::tcp: invalid address " + host );
+      }
+
+      return result;
+    }
+
+    // It closes the given sockets and throws the error of the last call, read before closing
+    static void failure(const string &what, const initializer_list<int> &sockets = {}) {
+      string message = "transport::tcp: " + what + ": " + strerror( errno );
+      for( auto fd : sockets ) close( fd );
+      throw runtime_error( message );
+    }
+
+    tcp::tcp(const unsigned int &rank, const unsigned int &size, const unsigned short &port,
+             const string &host, const unsigned int &timeout) :
+    base(rank, size), _next(-1), _previous(-1), _timeout(1000 * timeout) {
+      if( size == 1 ) return;
+
+      int listener = socket( AF_INET, SOCK_STREAM, 0 );
+      if( listener < 0 ) failure( "socket" );
+
+      int yes = 1;
+      setsockopt( listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof( yes ) );
+
+      auto own = address( host, port + rank );
+      if(( bind( listener, reinterpret_cast<sockaddr *>( &own ), sizeof( own ) ) < 0 ) ||
+         ( listen( listener, 1 ) < 0 )) {
+        failure( "listen", { listener } );
+      }
+
+      // The connection is queued by the peer even before it accepts it, so every worker can
+      // connect first and accept afterwards
+      auto next = address( host, port + (rank + 1) % size );
+      auto deadline = chrono::steady_clock::now() + chrono::seconds( timeout );
+
+      while( true ) {
+        _next = socket( AF_INET, SOCK_STREAM, 0 );
+        if( _next < 0 ) failure( "socket", { listener } );
+
+        if( connect( _next, reinterpret_cast<sockaddr *>( &next ), sizeof( next ) ) == 0 ) break;
+
+        if( chrono::steady_clock::now() > deadline ) {
+          int last = _next;
+          _next = -1;
+          failure( "connect", { last, listener } );
+        }
+
+        close( _next );
+        _next = -1;
+
+        this_thread::sleep_for( chrono::milliseconds( 10 ) );
+      }
+
+      pollfd waiting = { listener, POLLIN, 0 };
+      int remaining = chrono::duration_cast<chrono::milliseconds>(
+                        deadline - chrono::steady_clock::now() ).count();
+
+      int ready = poll( &waiting, 1, remaining > 0 ? remaining : 0 );
+      if( ready == 0 ) errno = ETIMEDOUT;
+      if( ready <= 0 ) failure( "accept", { listener, _next } );
+
+      _previous = accept( listener, nullptr, nullptr );
+      if( _previous < 0 ) failure( "accept", { listener, _next } );
+      close( listener );
+
+      for( auto fd : { _next, _previous } ) {
+        setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof( yes ) );
+        fcntl( fd, F_SETFL, fcntl( fd, F_GETFL ) | O_NONBLOCK );
+      }
+    }
+
+    tcp::~tcp() {
+      if( _next >= 0 ) close( _next );
+      if( _previous >= 0 ) close( _previous );
+    }
+
+    void tcp::exchange(const double *sent, const unsigned int &sent_count,
+                       double *received, const unsigned int &received_count) {
+      if( size() == 1 ) {
+        memcpy( received, sent, sizeof( double ) * min( sent_count, received_count ) );
+        return;
+      }
+
+      const char *out = reinterpret_cast<const char *>( sent );
+      char *in = reinterpret_cast<char *>( received );
+      size_t to_send = sizeof( double ) * sent_count;
+      size_t to_receive = sizeof( double ) * received_count;
+
+      while(( to_send > 0 ) || ( to_receive > 0 )) {
+        pollfd links[2] = { { _next, static_cast<short>( to_send > 0 ? POLLOUT : 0 ), 0 },
+                            { _previous, static_cast<short>( to_receive > 0 ? POLLIN : 0 ), 0 } };
+
+        int ready = poll( links, 2, _timeout );
+        if( ready == 0 ) {
+          throw runtime_error( "transport::tcp: the neighbours did not answer in time" );
+        }
+
+        if( ready < 0 ) {
+          if( errno == EINTR ) continue;
+          failure( "poll" );
+        }
+
+        if(( to_send > 0 ) && ( links[0].revents & (POLLOUT | POLLERR | POLLHUP) )) {
+          ssize_t done = send( _next, out, to_send, MSG_NOSIGNAL );
+          if( done < 0 ) {
+            if(( errno != EAGAIN ) && ( errno != EWOULDBLOCK ) && ( errno != EINTR )) {
+              failure( "send" );
+            }
+          }
+          else {
+            out += done;
+            to_send -= done;
+          }
+        }
+
+        if(( to_receive > 0 ) && ( links[1].revents & (POLLIN | POLLERR | POLLHUP) )) {
+          ssize_t done = recv( _previous, in, to_receive, 0 );
+          if( done == 0 ) throw runtime_error( "transport::tcp: the previous worker left" );
+          if( done < 0 ) {
+            if(( errno != EAGAIN ) && ( errno != EWOULDBLOCK ) && ( errno != EINTR )) {
+              failure( "recv" );
+            }
+          }
+          else {
+            in += done;
+            to_receive -= done;
+          }
+        }
+      }
+    }
+  }
+}
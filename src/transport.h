@@ -0,0 +1,115 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___TRANSPORT___
+#define ___TRANSPORT___
+#include <string>
+
+using namespace std;
+
+namespace mp {
+  namespace transport { // Links between the workers of a distributed training
+    /**
+     * \class base transport.h
+     * \brief This class represents the link of one worker with its neighbours in a ring of
+     * workers.
+     *
+     * Each worker only talks to the next one (rank + 1) and the previous one (rank - 1), which
+     * is all a ring allreduce needs.
+     *
+     * \note This class can not be instanciated. Derived classes must implement exchange.
+     * */
+    class base {
+      public:
+        /**
+         * \brief It builds the link of the given worker
+         * \param rank index of the worker in the ring
+         * \param size number of workers in the ring
+         * \throw invalid_argument if the rank is not lower than the size
+         * */
+        base(const unsigned int &rank, const unsigned int &size);
+
+        virtual ~base();
+
+        /**
+         * \brief It returns the index of this worker in the ring
+         * \return the rank of the worker
+         * */
+        unsigned int rank() const;
+
+        /**
+         * \brief It returns the number of workers in the ring
+         * \return the number of workers
+         * */
+        unsigned int size() const;
+
+        /**
+         * \brief It sends values to the next worker while it receives values from the previous
+         * one. Both transfers progress at the same time, so a whole ring can exchange at once.
+         * \param sent           values sent to the next worker
+         * \param sent_count     number of values sent
+         * \param received       buffer for the values of the previous worker
+         * \param received_count number of values received
+         * \throw runtime_error if the link fails
+         * */
+        virtual void exchange(const double *sent, const unsigned int &sent_count,
+                              double *received, const unsigned int &received_count) =0;
+
+      private:
+        unsigned int _rank;
+        unsigned int _size;
+    };
+
+    /**
+     * \brief Workers linked by TCP sockets. The worker of rank r listens on port + r.
+     * */
+    class tcp : public mp::transport::base {
+      public:
+        /**
+         * \brief It connects the worker with its neighbours. It waits until they are up.
+         * \param rank    index of the worker in the ring
+         * \param size    number of workers in the ring
+         * \param port    port of the worker of rank 0
+         * \param host    address of the workers
+         * \param timeout seconds to wait for the neighbours, when connecting and on every
+         * exchange
+         * \throw runtime_error if the neighbours can not be reached in time
+         * */
+        tcp(const unsigned int &rank, const unsigned int &size, const unsigned short &port,
+            const string &host = "127.0.0.1", const unsigned int &timeout = 30);
+
+        tcp(const tcp &) = delete;
+        tcp& operator=(const tcp &) = delete;
+
+        ~tcp();
+
+        /**
+         * \brief Same as base::exchange, giving up when the neighbours do not make any progress
+         * for the timeout of the constructor
+         * \throw runtime_error if the link fails or the neighbours do not answer in time
+         * */
+        void exchange(const double *sent, const unsigned int &sent_count,
+                      double *received, const unsigned int &received_count) override;
+
+      private:
+        int _next;
+        int _previous;
+        int _timeout;
+    };
+  }
+}
+#endif
@@ -0,0 +1,57 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "arena_test.h"
+
+TEST_F(ArenaBlock, FootprintRoundsToCacheLines) {
+  EXPECT_EQ(0, arena::footprint( 0 ));
+  EXPECT_EQ(8, arena::footprint( 1 ));
+  EXPECT_EQ(8, arena::footprint( 8 ));
+  EXPECT_EQ(16, arena::footprint( 9 ));
+}
+
+TEST_F(ArenaBlock, PiecesAreAlignedAndZeroed) {
+  block.reserve( arena::footprint( 3 ) + arena::footprint( 5 ) );
+
+  double *first = block.allocate( 3 );
+  double *second = block.allocate( 5 );
+
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>( first ) % 64);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>( second ) % 64);
+  EXPECT_EQ(first + 8, second);
+  EXPECT_EQ(block.capacity(), block.used());
+
+  for(unsigned int i = 0; i < 5; i++) EXPECT_EQ(0, second[i]);
+}
+
+TEST_F(ArenaBlock, ExhaustedBlockThrows) {
+  block.reserve( arena::footprint( 4 ) );
+  block.allocate( 4 );
+
+  EXPECT_THROW(block.allocate( 1 ), length_error);
+}
+
+TEST_F(ArenaBlock, MoveKeepsThePieces) {
+  block.reserve( arena::footprint( 2 ) );
+  double *piece = block.allocate( 2 );
+  piece[1] = 3.5;
+
+  arena other( move( block ) );
+  EXPECT_EQ(0, block.capacity());
+  EXPECT_EQ(arena::footprint( 2 ), other.used());
+  EXPECT_EQ(3.5, piece[1]);
+}
@@ -0,0 +1,34 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___ARENA_TEST___
+#define ___ARENA_TEST___
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "arena.h"
+
+using namespace mp;
+using namespace std;
+
+class ArenaBlock : public ::testing::Test {
+  protected:
+    ArenaBlock() {}
+    ~ArenaBlock() {}
+
+    arena block;
+};
+#endif
@@ -0,0 +1,98 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "cross_validation_test.h"
+
+TEST_F(KFold, FoldsCoverEverySampleOnce) {
+  cross_validation cv( 4, 3 );
+  auto folds = cv.split( 10 );
+
+  ASSERT_EQ(4, folds.size());
+  vector<unsigned int> seen;
+  for( auto &fold : folds ) {
+    EXPECT_GE(fold.size(), 2);
+    EXPECT_LE(fold.size(), 3);
+    seen.insert( seen.end(), fold.begin(), fold.end() );
+  }
+
+  sort( seen.begin(), seen.end() );
+  for(unsigned int i = 0; i < seen.size(); i++) EXPECT_EQ(i, seen[i]);
+
+  EXPECT_EQ(folds, cross_validation( 4, 3 ).split( 10 ));
+  EXPECT_NE(folds, cross_validation( 4, 4 ).split( 10 ));
+}
+
+TEST_F(KFold, ResultDoesNotDependOnThreads) {
+  cross_validation single( 5, 1 );
+  cross_validation parallel( 5, 1 );
+  single.threads( 1 );
+  parallel.threads( 8 );
+
+  auto expected = single.run( pointers( first ), settings, dat );
+  auto report = parallel.run( pointers( second ), settings, dat );
+
+  for(unsigned int f = 0; f < 5; f++) {
+    EXPECT_EQ(expected.folds[f].held_out, report.folds[f].held_out);
+    EXPECT_EQ(expected.folds[f].validation.mse, report.folds[f].validation.mse);
+    EXPECT_EQ(first[f]->weights(), second[f]->weights());
+  }
+}
+
+TEST_F(KFold, FoldsAreTrainedWithoutTheHeldOutSamples) {
+  cross_validation cv( 5, 2 );
+  auto report = cv.run( pointers( first ), settings, dat );
+
+  // The third fold, trained again by hand over a copy of its samples
+  auto &held_out = report.folds[2].held_out;
+  vector<unsigned int> kept;
+  for(unsigned int i = 0; i < dat.elements(); i++) {
+    if( not binary_search( held_out.begin(), held_out.end(), i ) ) kept.push_back( i );
+  }
+
+  settings.train( *(second[2]), data( dat, kept ) );
+  auto expected = evaluator().evaluate( *(second[2]), data( dat, held_out ) );
+
+  EXPECT_EQ(120, kept.size());
+  EXPECT_EQ(first[2]->weights(), second[2]->weights());
+  EXPECT_DOUBLE_EQ(expected.mse, report.folds[2].validation.mse);
+}
+
+TEST_F(KFold, MetricsAreAggregated) {
+  cross_validation cv( 5, 2 );
+  auto report = cv.run( pointers( first ), settings, dat );
+
+  double mse = 0.0;
+  unsigned int counted = 0;
+  for( auto &fold : report.folds ) mse += fold.validation.mse / 5;
+  for( auto &row : report.mean.confusion ) {
+    for( auto cell : row ) counted += cell;
+  }
+
+  EXPECT_EQ(150, report.mean.elements);
+  EXPECT_EQ(150, counted);
+  EXPECT_DOUBLE_EQ(mse, report.mean.mse);
+  EXPECT_LE(0.0, report.deviation.mse);
+}
+
+TEST_F(KFold, InvalidSettingsAreRejected) {
+  cross_validation cv;
+
+  EXPECT_THROW(cv.folds( 1 ), invalid_argument);
+  EXPECT_THROW(cv.run( { first[0].get() }, settings, dat ), invalid_argument);
+  EXPECT_THROW(cross_validation( 5, 0 ).run( pointers( first ), settings, data( dat, { 0 } ) ),
+               invalid_argument);
+}
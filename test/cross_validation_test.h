@@ -0,0 +1,64 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___CROSS_VALIDATION_TEST___
+#define ___CROSS_VALIDATION_TEST___
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include "cross_validation.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class KFold : public ::testing::Test {
+  protected:
+    KFold() {
+      dat.reload( "db/test_blobs.dat" );
+      settings.epochs( 5 );
+      settings.shuffle( 9 );
+
+      for(unsigned int i = 0; i < 5; i++) {
+        first.emplace_back( new network(1, 4, 3) );
+        second.emplace_back( new network(1, 4, 3) );
+        prepare( *(first[i]) );
+        prepare( *(second[i]) );
+      }
+    }
+
+    ~KFold() {}
+
+    // It connects a network to the data set, always with the same weights
+    void prepare(network &target) {
+      connect( target, dat.inputs_length(), scheme::xavier, 17 );
+      target.optimizer()->learning_rate( 0.1 );
+    }
+
+    vector<network *> pointers(const vector<unique_ptr<network>> &models) {
+      vector<network *> result;
+      for( auto &model : models ) result.push_back( model.get() );
+      return result;
+    }
+
+    data dat;
+    trainer settings;
+    vector<unique_ptr<network>> first;
+    vector<unique_ptr<network>> second;
+};
+#endif
@@ -85,3 +85,26 @@ TEST_F(DataStructure, Outputs) {
   ASSERT_TRUE( output_contain(dat, input2, output2) ) << "[-1, 1] must have a [1] as output";
   ASSERT_TRUE( output_contain(dat, input3, output3) ) << "[1, 1] must have a [0] as output";
 }
+
+TEST_F(DataStructure, ViewsShareTheSamples) {
+  data view( dat, { 3, 1 } );
+
+  ASSERT_EQ(2, view.elements());
+  ASSERT_EQ(2, view.inputs_length());
+  ASSERT_EQ(1, view.outputs_length());
+  ASSERT_EQ(dat.input( 3 ).lock(), view.input( 0 ).lock());
+  ASSERT_EQ(dat.output( 1 ).lock(), view.output( 1 ).lock());
+  ASSERT_THROW(data( dat, { 4 } ), out_of_range);
+}
+
+TEST_F(DataStructure, OutputsCanBeReplaced) {
+  vector<vector<double>> outputs = { {0.1, 0.9}, {0.2, 0.8}, {0.3, 0.7}, {0.4, 0.6} };
+  data relabeled = dat.relabeled( outputs );
+
+  ASSERT_EQ(4, relabeled.elements());
+  ASSERT_EQ(2, relabeled.inputs_length());
+  ASSERT_EQ(2, relabeled.outputs_length());
+  ASSERT_EQ(dat.input( 2 ).lock(), relabeled.input( 2 ).lock());
+  ASSERT_EQ(outputs[2], *(relabeled.output( 2 ).lock()));
+  ASSERT_THROW(dat.relabeled( vector<vector<double>>( 3 ) ), invalid_argument);
+}
@@ -0,0 +1,117 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "distillation_test.h"
+
+TEST_F(Distillation, TargetsBlendHardAndSoftTargets) {
+  vector<vector<double>> predicted;
+  vector<const vector<double> *> inputs;
+  for(unsigned int i = 0; i < dat.elements(); i++) inputs.push_back( dat.input( i ).lock().get() );
+  teacher.predict( inputs, predicted );
+
+  auto soft = distiller( 0.0, 1.0 ).targets( teacher, dat );
+  auto hard = distiller( 1.0, 1.0 ).targets( teacher, dat );
+  ASSERT_EQ(dat.elements(), soft.elements());
+  EXPECT_EQ(3U, soft.outputs_length());
+
+  for(unsigned int i = 0; i < dat.elements(); i++) {
+    EXPECT_EQ(dat.input( i ).lock(), soft.input( i ).lock());
+    EXPECT_EQ(predicted[i], *(soft.output( i ).lock()));
+    EXPECT_EQ(*(dat.output( i ).lock()), *(hard.output( i ).lock()));
+  }
+
+  // Half and half, with the teacher probabilities softened by a temperature of 2
+  distiller blend( 0.5, 2.0 );
+  blend.threads( 4 );
+  blend.batch_size( 7 );
+  auto mixed = blend.targets( teacher, dat );
+
+  for(unsigned int i = 0; i < dat.elements(); i++) {
+    auto &p = predicted[i];
+    double sum = sqrt( p[0] ) + sqrt( p[1] ) + sqrt( p[2] );
+    auto &target = *(mixed.output( i ).lock());
+    auto &expected = *(dat.output( i ).lock());
+
+    for(unsigned int k = 0; k < 3; k++) {
+      EXPECT_NEAR(0.5 * expected[k] + 0.5 * sqrt( p[k] ) / sum, target[k], 1e-12);
+    }
+  }
+}
+
+TEST_F(Distillation, TemperatureSoftensTheTargets) {
+  trainer t;
+  t.epochs( 20 );
+  t.train( teacher, dat );
+
+  auto cold = distiller( 0.0, 1.0 ).targets( teacher, dat );
+  auto warm = distiller( 0.0, 4.0 ).targets( teacher, dat );
+
+  for(unsigned int i = 0; i < dat.elements(); i++) {
+    auto &c = *(cold.output( i ).lock());
+    auto &w = *(warm.output( i ).lock());
+
+    EXPECT_LE(*max_element( w.begin(), w.end() ), *max_element( c.begin(), c.end() ) + 1e-12);
+    EXPECT_EQ(max_element( c.begin(), c.end() ) - c.begin(),
+              max_element( w.begin(), w.end() ) - w.begin());
+  }
+}
+
+TEST_F(Distillation, StudentLearnsFromTheTeacher) {
+  trainer t;
+  t.epochs( 30 );
+  t.train( teacher, dat );
+  auto weights = teacher.weights();
+
+  network student(1, 4, 3);
+  prepare( student, 2 );
+
+  distiller d;
+  d.repeats( 2 );
+  auto report = d.distill( teacher, student, t, dat, dat );
+
+  EXPECT_EQ(weights, teacher.weights());
+  EXPECT_EQ(30U, report.training.epochs);
+  EXPECT_EQ(evaluator().evaluate( teacher, dat ).accuracy, report.teacher.accuracy);
+  EXPECT_EQ(evaluator().evaluate( student, dat ).accuracy, report.student.accuracy);
+  EXPECT_GT(report.student.accuracy, 0.85);
+
+  EXPECT_EQ(32U * 3 + 3 * 33, report.teacher_parameters);
+  EXPECT_EQ(4U * 3 + 3 * 5, report.student_parameters);
+  EXPECT_GT(report.teacher_latency, 0.0);
+  EXPECT_GT(report.student_latency, 0.0);
+  EXPECT_DOUBLE_EQ(report.teacher_latency / report.student_latency, report.speedup);
+}
+
+TEST_F(Distillation, WrongSettingsAreRejected) {
+  EXPECT_THROW(distiller( 1.5, 1.0 ), invalid_argument);
+  EXPECT_THROW(distiller( 0.5, 0.0 ), invalid_argument);
+  EXPECT_THROW(distiller().temperature( -1.0 ), invalid_argument);
+  EXPECT_DOUBLE_EQ(0.5, distiller().hard_weight());
+  EXPECT_DOUBLE_EQ(2.0, distiller().temperature());
+
+  network student(1, 4, 2);
+  prepare( student, 2 );
+  EXPECT_THROW(distiller().distill( teacher, student, trainer(), dat, dat ), invalid_argument);
+
+  data xor_data( "db/test_xor.dat" );
+  EXPECT_THROW(distiller().targets( teacher, xor_data ), invalid_argument);
+
+  // Only the softmax probabilities can be softened by the temperature
+  teacher.output_stage( stage::activation );
+  EXPECT_THROW(distiller( 0.5, 2.0 ).targets( teacher, dat ), invalid_argument);
+  EXPECT_EQ(dat.elements(), distiller( 0.5, 1.0 ).targets( teacher, dat ).elements());
+}
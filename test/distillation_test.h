@@ -0,0 +1,50 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___DISTILLATION_TEST___
+#define ___DISTILLATION_TEST___
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "distillation.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class Distillation : public ::testing::Test {
+  protected:
+    Distillation() {
+      dat.reload( "db/test_blobs.dat" );
+      prepare( teacher, 1 );
+    }
+
+    ~Distillation() {}
+
+    // It connects a softmax network to the data set, with ReLU hidden neurons
+    void prepare(network &target, const unsigned int &seed) {
+      connect( target, dat.inputs_length(), scheme::he, seed );
+      target.activation( 0, activation_kind::relu );
+      target.output_stage( stage::softmax );
+      target.optimizer( make_shared<mp::optimizer::sgd>( 0.05, 0.9 ) );
+    }
+
+    data dat;
+    network teacher = network(1, 32, 3);
+};
+#endif
@@ -0,0 +1,158 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "distributed_test.h"
+#include <sys/wait.h>
+
+unsigned int DataParallel::next_ports = 0;
+
+TEST_F(DataParallel, AllreduceAddsTheValuesOfEveryWorker) {
+  vector<vector<double>> values( 3 );
+
+  // Fewer values than workers leave some chunks empty
+  for( auto length : { 10U, 2U } ) {
+    workers( 3, [&](transport::base &link) {
+      auto &mine = values[link.rank()];
+      mine.clear();
+      for(unsigned int i = 0; i < length; i++) mine.push_back( 0.1 * (link.rank() + 1) + i );
+
+      data_parallel::allreduce( link, mine );
+    } );
+
+    for(unsigned int i = 0; i < length; i++) {
+      EXPECT_DOUBLE_EQ(0.6 + 3 * i, values[0][i]);
+    }
+
+    EXPECT_EQ(values[0], values[1]);
+    EXPECT_EQ(values[0], values[2]);
+    port += 3;
+  }
+}
+
+TEST_F(DataParallel, ShardsSplitTheData) {
+  vector<vector<unsigned int>> shards( 4 );
+  workers( 4, [&](transport::base &link) {
+    shards[link.rank()] = data_parallel( link ).shard( 10 );
+  } );
+
+  EXPECT_EQ(vector<unsigned int>({ 0, 1 }), shards[0]);
+  EXPECT_EQ(vector<unsigned int>({ 2, 3, 4 }), shards[1]);
+  EXPECT_EQ(vector<unsigned int>({ 5, 6 }), shards[2]);
+  EXPECT_EQ(vector<unsigned int>({ 7, 8, 9 }), shards[3]);
+}
+
+TEST_F(DataParallel, WorkersStayBitIdentical) {
+  vector<unique_ptr<network>> models;
+  for(unsigned int rank = 0; rank < 3; rank++) {
+    models.emplace_back( new network(1, 5, 3) );
+    // Only the weights of rank 0 matter, they are broadcast
+    prepare( *(models[rank]), rank + 1 );
+  }
+
+  network alone(1, 5, 3);
+  prepare( alone, 1 );
+
+  workers( 3, [&](transport::base &link) {
+    data_parallel trainer( link );
+    trainer.batch_size( 10 );
+    EXPECT_EQ(2 * 5, trainer.train( *(models[link.rank()]), dat, 2 ));
+  } );
+
+  EXPECT_EQ(models[0]->weights(), models[1]->weights());
+  EXPECT_EQ(models[0]->weights(), models[2]->weights());
+
+  // The same steps in one process: batches of 10 samples of every shard
+  vector<const vector<double> *> inputs, expected;
+  for(unsigned int epoch = 0; epoch < 2; epoch++) {
+    for(unsigned int start = 0; start < 50; start += 10) {
+      inputs.clear();
+      expected.clear();
+
+      for(unsigned int shard = 0; shard < 3; shard++) {
+        for(unsigned int i = start; i < start + 10; i++) {
+          inputs.push_back( dat.input( shard * 50 + i ).lock().get() );
+          expected.push_back( dat.output( shard * 50 + i ).lock().get() );
+        }
+      }
+
+      alone.backpropagate( inputs, expected );
+    }
+  }
+
+  auto distributed = models[0]->weights();
+  auto single = alone.weights();
+  ASSERT_EQ(single.size(), distributed.size());
+  for(unsigned int i = 0; i < single.size(); i++) EXPECT_NEAR(single[i], distributed[i], 1e-9);
+}
+
+TEST_F(DataParallel, SilentNeighboursTimeOut) {
+  atomic<bool> done( false );
+  vector<double> sent( 4, 1.0 ), received( 4, 0.0 );
+
+  // The second worker connects but never sends anything
+  thread silent( [&] {
+    transport::tcp link( 1, 2, port, "127.0.0.1", 1 );
+    while( not done ) this_thread::sleep_for( chrono::milliseconds( 10 ) );
+  } );
+
+  {
+    transport::tcp link( 0, 2, port, "127.0.0.1", 1 );
+    EXPECT_THROW(link.exchange( sent.data(), 4, received.data(), 4 ), runtime_error);
+  }
+
+  done = true;
+  silent.join();
+}
+
+TEST_F(DataParallel, WorkersCanBeProcesses) {
+  network net(1, 5, 3);
+  prepare( net, 4 );
+
+  int channel[2];
+  ASSERT_EQ(0, pipe( channel ));
+
+  pid_t child = fork();
+  ASSERT_LE(0, child);
+
+  if( child == 0 ) {
+    // The child sends its weights back to the parent through the pipe
+    close( channel[0] );
+    transport::tcp link( 1, 2, port );
+    data_parallel( link ).train( net, dat, 3 );
+
+    auto weights = net.weights();
+    ssize_t bytes = sizeof( double ) * weights.size();
+    bool sent = write( channel[1], weights.data(), bytes ) == bytes;
+    _exit( sent ? 0 : 1 );
+  }
+
+  close( channel[1] );
+  transport::tcp link( 0, 2, port );
+  data_parallel( link ).train( net, dat, 3 );
+
+  auto weights = net.weights();
+  vector<double> remote( weights.size() );
+  ssize_t bytes = sizeof( double ) * remote.size();
+  EXPECT_EQ(bytes, read( channel[0], remote.data(), bytes ));
+  close( channel[0] );
+
+  int status = 0;
+  waitpid( child, &status, 0 );
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+  EXPECT_EQ(weights, remote);
+}
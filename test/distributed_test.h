@@ -0,0 +1,69 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___DISTRIBUTED_TEST___
+#define ___DISTRIBUTED_TEST___
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <unistd.h>
+#include "distributed.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class DataParallel : public ::testing::Test {
+  protected:
+    DataParallel() {
+      dat.reload( "db/test_blobs.dat" );
+      // Every test takes its own ports, so runs of the suite at once do not collide
+      port = 20000 + (getpid() % 300) * 128 + (next_ports++ % 16) * 8;
+    }
+
+    ~DataParallel() {}
+
+    // It connects a network to the data set, with weights taken from the seed
+    void prepare(network &target, const unsigned int &seed) {
+      connect( target, dat.inputs_length(), scheme::xavier, seed );
+      target.optimizer()->learning_rate( 0.1 );
+    }
+
+    // It runs one worker per thread, each one with its own link, and waits for all of them
+    void workers(const unsigned int &size,
+                 const function<void(transport::base &)> &work) {
+      vector<thread> running;
+      for(unsigned int rank = 0; rank < size; rank++) {
+        running.emplace_back( [&, rank] {
+          transport::tcp link( rank, size, port );
+          work( link );
+        } );
+      }
+
+      for( auto &t : running ) t.join();
+    }
+
+    static unsigned int next_ports;
+
+    data dat;
+    unsigned short port;
+};
+#endif
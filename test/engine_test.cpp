@@ -0,0 +1,107 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "engine_test.h"
+
+TEST_F(TrainingEngine, StackedNetworksAreGroupedTogether) {
+  network a(1, 6, 3), b(1, 6, 3), c(1, 6, 3), d(2, 6, 3);
+  prepare( a, 1 );
+  prepare( b, 2 );
+  prepare( c, 3 );
+  prepare( d, 4 );
+
+  trainer other = settings;
+  other.epochs( 3 );
+
+  engine e( 2 );
+  e.stack( 2 );
+  e.add( a, settings );
+  e.add( b, settings );
+  e.add( c, settings );
+  e.add( d, settings );
+  e.add( a, other );
+
+  auto groups = e.groups();
+  ASSERT_EQ(4, groups.size());
+  EXPECT_EQ(vector<unsigned int>({ 0, 1 }), groups[0]);
+  EXPECT_EQ(vector<unsigned int>({ 2 }), groups[1]);
+  EXPECT_EQ(vector<unsigned int>({ 3 }), groups[2]);
+  EXPECT_EQ(vector<unsigned int>({ 4 }), groups[3]);
+}
+
+TEST_F(TrainingEngine, StackedBackpropagationMatchesEachNetwork) {
+  network a(1, 6, 3), b(1, 6, 3), alone_a(1, 6, 3), alone_b(1, 6, 3);
+  prepare( a, 11 );
+  prepare( b, 12 );
+  prepare( alone_a, 11 );
+  prepare( alone_b, 12 );
+
+  vector<const vector<double> *> inputs, expected;
+  for(unsigned int i = 0; i < 20; i++) {
+    inputs.push_back( dat.input( i ).lock().get() );
+    expected.push_back( dat.output( i ).lock().get() );
+  }
+
+  for(unsigned int step = 0; step < 5; step++) {
+    network::backpropagate_stacked( { &a, &b }, inputs, expected );
+    alone_a.backpropagate( inputs, expected );
+    alone_b.backpropagate( inputs, expected );
+  }
+
+  EXPECT_EQ(alone_a.weights(), a.weights());
+  EXPECT_EQ(alone_b.weights(), b.weights());
+}
+
+TEST_F(TrainingEngine, NotStackableNetworksAreRejected) {
+  network a(1, 6, 3), b(1, 5, 3);
+  prepare( a, 1 );
+  prepare( b, 2 );
+
+  vector<const vector<double> *> inputs = { dat.input( 0 ).lock().get() };
+  vector<const vector<double> *> expected = { dat.output( 0 ).lock().get() };
+
+  EXPECT_FALSE(a.stackable( b ));
+  EXPECT_THROW(network::backpropagate_stacked( { &a, &b }, inputs, expected ),
+               invalid_argument);
+}
+
+TEST_F(TrainingEngine, ResultsMatchIndividualTraining) {
+  vector<network> models, alone;
+  models.reserve( 6 );
+  alone.reserve( 6 );
+  for(unsigned int i = 0; i < 6; i++) {
+    models.emplace_back( 1, i < 4 ? 6 : 4, 3 );
+    alone.emplace_back( 1, i < 4 ? 6 : 4, 3 );
+  }
+
+  engine e( 3 );
+  for(unsigned int i = 0; i < models.size(); i++) {
+    prepare( models[i], 20 + i );
+    prepare( alone[i], 20 + i );
+    EXPECT_EQ(i, e.add( models[i], settings ));
+  }
+
+  auto reports = e.run( dat );
+  ASSERT_EQ(models.size(), reports.size());
+
+  for(unsigned int i = 0; i < models.size(); i++) {
+    auto expected = settings.train( alone[i], dat );
+    EXPECT_EQ(expected.epochs, reports[i].epochs);
+    EXPECT_EQ(expected.best_score, reports[i].best_score);
+    EXPECT_EQ(alone[i].weights(), models[i].weights());
+  }
+}
@@ -0,0 +1,46 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___ENGINE_TEST___
+#define ___ENGINE_TEST___
+#include <gtest/gtest.h>
+#include <vector>
+#include "engine.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class TrainingEngine : public ::testing::Test {
+  protected:
+    TrainingEngine() {
+      dat.reload( "db/test_blobs.dat" );
+      settings.epochs( 15 );
+      settings.shuffle( 5 );
+    }
+
+    ~TrainingEngine() {}
+
+    // It connects a network to the data set and takes its weights from the seed
+    void prepare(network &result, const unsigned int &seed) {
+      connect( result, dat.inputs_length(), scheme::xavier, seed );
+    }
+
+    data dat;
+    trainer settings;
+};
+#endif
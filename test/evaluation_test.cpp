@@ -0,0 +1,124 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "evaluation_test.h"
+
+TEST_F(DatasetEvaluation, PredictMatchesOutput) {
+  vector<const vector<double> *> block;
+  vector<vector<double>> results;
+
+  for(unsigned int i = 0; i < 10; i++) {
+    block.push_back( dat.input( i ).lock().get() );
+  }
+
+  net.predict( block, results );
+  ASSERT_EQ(10, results.size());
+
+  for(unsigned int i = 0; i < 10; i++) {
+    auto expected = net.output( *(dat.input( i ).lock()) );
+    ASSERT_EQ(expected, results[i]);
+  }
+}
+
+TEST_F(DatasetEvaluation, PredictRejectsWrongInputs) {
+  vector<double> wrong( 5, 1.0 );
+  vector<const vector<double> *> block( 1, &wrong );
+  vector<vector<double>> results;
+
+  EXPECT_THROW(net.predict( block, results ), invalid_argument);
+}
+
+TEST_F(DatasetEvaluation, EvaluateRejectsWrongInputs) {
+  data xor_data;
+  xor_data.reload( "db/test_xor.dat" );
+  network unfed(1, 3, 1);
+
+  // The error of the worker threads reaches the caller
+  EXPECT_THROW(evaluator( 4, 2 ).evaluate( unfed, xor_data ), invalid_argument);
+  EXPECT_THROW(evaluator( 1, 2 ).evaluate( unfed, xor_data ), invalid_argument);
+}
+
+TEST_F(DatasetEvaluation, MetricsMatchSequentialLoop) {
+  double mse = 0;
+  unsigned int hits = 0;
+
+  for(unsigned int i = 0; i < dat.elements(); i++) {
+    auto result = net.output( *(dat.input( i ).lock()) );
+    auto target = *(dat.output( i ).lock());
+
+    for(unsigned int k = 0; k < result.size(); k++) {
+      mse += pow( target[k] - result[k], 2 );
+    }
+
+    if( evaluator::classify( result ) == evaluator::classify( target ) ) hits++;
+  }
+
+  mse /= dat.elements() * dat.outputs_length();
+
+  auto m = evaluator().evaluate( net, dat );
+  EXPECT_EQ(dat.elements(), m.elements);
+  EXPECT_NEAR(mse, m.mse, 1e-12);
+  EXPECT_DOUBLE_EQ(static_cast<double>( hits ) / dat.elements(), m.accuracy);
+  EXPECT_GT(m.cross_entropy, 0);
+}
+
+TEST_F(DatasetEvaluation, ConfusionMatrixCountsEverySample) {
+  auto m = evaluator().evaluate( net, dat );
+  unsigned int total = 0;
+  unsigned int diagonal = 0;
+
+  ASSERT_EQ(3, m.confusion.size());
+  for(unsigned int i = 0; i < m.confusion.size(); i++) {
+    ASSERT_EQ(3, m.confusion[i].size());
+    for(unsigned int j = 0; j < m.confusion[i].size(); j++) {
+      total += m.confusion[i][j];
+      if( i == j ) diagonal += m.confusion[i][j];
+    }
+  }
+
+  EXPECT_EQ(dat.elements(), total);
+  EXPECT_DOUBLE_EQ(static_cast<double>( diagonal ) / total, m.accuracy);
+}
+
+TEST_F(DatasetEvaluation, ResultsDoNotDependOnThreads) {
+  auto reference = evaluator(1, 1).evaluate( net, dat );
+
+  for(unsigned int threads = 2; threads <= 8; threads++) {
+    auto m = evaluator(threads, threads + 3).evaluate( net, dat );
+
+    ASSERT_EQ(reference.mse, m.mse) << "with " << threads << " threads";
+    ASSERT_EQ(reference.cross_entropy, m.cross_entropy) << "with " << threads << " threads";
+    ASSERT_EQ(reference.accuracy, m.accuracy) << "with " << threads << " threads";
+    ASSERT_EQ(reference.confusion, m.confusion) << "with " << threads << " threads";
+  }
+}
+
+TEST(BinaryEvaluation, SingleOutputUsesTwoClasses) {
+  data dat( "db/test_xor.dat" );
+  network net(1, 2, 1);
+  vector<double> inputs( 2, 0.0 );
+  net.feed( inputs );
+
+  auto m = evaluator(2, 1).evaluate( net, dat );
+  ASSERT_EQ(2, m.confusion.size());
+  // Zero factors give 0.5 on every output, classified as 1
+  EXPECT_EQ(2, m.confusion[0][1]);
+  EXPECT_EQ(2, m.confusion[1][1]);
+  EXPECT_DOUBLE_EQ(0.5, m.accuracy);
+  EXPECT_DOUBLE_EQ(0.25, m.mse);
+  EXPECT_NEAR(log( 2.0 ), m.cross_entropy, 1e-12);
+}
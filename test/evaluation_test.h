@@ -0,0 +1,52 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include "evaluation.h"
+
+using namespace mp;
+using namespace std;
+
+class DatasetEvaluation : public ::testing::Test {
+  protected:
+    DatasetEvaluation() {
+      dat.reload( "db/test_blobs.dat" );
+
+      vector<double> inputs( dat.inputs_length(), 0.0 );
+      net.feed( inputs );
+
+      // Deterministic, non symmetric factors so every output is different
+      for(unsigned int i = 0; i < net.layers(); i++) {
+        for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+          auto n = net.neuron(i, j).lock();
+          n->enable_bias();
+          n->set_bias( 0.1 * j - 0.2 );
+
+          for(unsigned int f = 0; f < n->factors_size(); f++) {
+            n->set_factor(f, sin( 1.0 + i * 7 + j * 3 + f ));
+          }
+        }
+      }
+    }
+
+    ~DatasetEvaluation() {}
+
+    data dat;
+    network net = network(2, 5, 3);
+};
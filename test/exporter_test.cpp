@@ -0,0 +1,110 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "exporter_test.h"
+#include <sstream>
+#include "neuron/rbf.h"
+
+TEST_F(ExportedModel, HeaderHoldsTheTopologyAndWeights) {
+  network net(1, 4, 1);
+  configure( net, 2 );
+
+  ostringstream code;
+  exporter( "xor_model" ).write( net, code );
+
+  EXPECT_NE(string::npos, code.str().find( "namespace xor_model {" ));
+  EXPECT_NE(string::npos, code.str().find( "constexpr unsigned int inputs = 2;" ));
+  EXPECT_NE(string::npos, code.str().find( "constexpr unsigned int outputs = 1;" ));
+  EXPECT_NE(string::npos, code.str().find( "constexpr double layer0_factors[8]" ));
+  EXPECT_NE(string::npos, code.str().find( "constexpr double layer1_biases[1]" ));
+  EXPECT_NE(string::npos, code.str().find( "inline void predict(" ));
+}
+
+TEST_F(ExportedModel, CompiledSigmoidNetworkGivesTheSameOutputs) {
+  network net(1, 4, 1);
+  configure( net, 2 );
+
+  vector<vector<double>> samples = { {0, 0}, {0, 1}, {1, 0}, {1, 1}, {-0.3, 2.5} };
+  auto outputs = compiled( net, samples );
+
+  ASSERT_EQ(samples.size(), outputs.size());
+  for(unsigned int s = 0; s < samples.size(); s++) {
+    EXPECT_EQ(net.output( samples[s] ), outputs[s]);
+  }
+}
+
+TEST_F(ExportedModel, CompiledMixedSoftmaxNetworkGivesTheSameOutputs) {
+  network net(3, 6, 3);
+  configure( net, 5 );
+  net.activation( 0, activation_kind::relu );
+  net.activation( 1, activation_kind::hyperbolic_tangent );
+  net.activation( 2, activation_kind::leaky_relu );
+  net.neuron(1, 4, make_shared<mp::neuron::rbf>( 6, true ));
+  net.neuron(1, 2).lock()->disable_bias();
+  net.output_stage( stage::softmax );
+
+  vector<vector<double>> samples;
+  for(unsigned int s = 0; s < 12; s++) {
+    vector<double> inputs( 5 );
+    for(unsigned int i = 0; i < 5; i++) inputs[i] = cos( 0.7 * s + i );
+    samples.push_back( inputs );
+  }
+
+  auto outputs = compiled( net, samples );
+
+  ASSERT_EQ(samples.size(), outputs.size());
+  for(unsigned int s = 0; s < samples.size(); s++) {
+    EXPECT_EQ(net.output( samples[s] ), outputs[s]);
+  }
+}
+
+TEST_F(ExportedModel, CustomNeuronsAndBadNamesAreRejected) {
+  network net(1, 4, 1);
+  configure( net, 2 );
+
+  net.neuron(0, 1, make_shared<doubled>( 2 ));
+
+  ostringstream code;
+  EXPECT_THROW(exporter().write( net, code ), invalid_argument);
+  EXPECT_THROW(exporter( "2fast" ), invalid_argument);
+  EXPECT_THROW(exporter().name( "my-model" ), invalid_argument);
+  EXPECT_EQ("model", exporter().name());
+}
+
+TEST_F(ExportedModel, ReducedStorageIsRejected) {
+  network net(1, 4, 1);
+  configure( net, 2 );
+  net.weight_storage( storage::bfloat16 );
+
+  ostringstream code;
+  EXPECT_THROW(exporter().write( net, code ), invalid_argument);
+  EXPECT_TRUE(code.str().empty());
+}
+
+TEST_F(ExportedModel, UnfedNetworksAndWriteErrorsAreReported) {
+  network unfed(1, 4, 1);
+  ostringstream code;
+  EXPECT_THROW(exporter().write( unfed, code ), invalid_argument);
+
+  network net(1, 4, 1);
+  configure( net, 2 );
+
+  ostringstream broken;
+  broken.setstate( ios::badbit );
+  EXPECT_THROW(exporter().write( net, broken ), runtime_error);
+  EXPECT_THROW(exporter().save( net, "/nonexistent/model.h" ), runtime_error);
+}
@@ -0,0 +1,126 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___EXPORTER_TEST___
+#define ___EXPORTER_TEST___
+#include <gtest/gtest.h>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+#include "exporter.h"
+
+using namespace mp;
+using namespace std;
+
+// A neuron without a known activation, which can not be exported
+class doubled : public mp::neuron::base {
+  public:
+    doubled(const unsigned int &inputs_size) : mp::neuron::base(inputs_size, true) {}
+
+    double activation(const double &sum) const override {
+      return 2 * sum;
+    }
+
+    double derivative(const double &) const override {
+      return 2;
+    }
+
+  protected:
+    double calculate_output(const vector<double> &) override {
+      return 0.0;
+    }
+
+    double calculate_output(const vector<shared_ptr<mp::neuron::base>> &) override {
+      return 0.0;
+    }
+};
+
+class ExportedModel : public ::testing::Test {
+  protected:
+    ExportedModel() {
+      prefix = "/tmp/mp_exporter_" + to_string( getpid() ) + "_";
+    }
+
+    ~ExportedModel() {}
+
+    // It gives the network enabled biases and fixed weights
+    void configure(network &target, const unsigned int &inputs) {
+      target.feed( vector<double>( inputs, 0.0 ) );
+
+      for(unsigned int i = 0; i < target.layers(); i++) {
+        for(unsigned int j = 0; j < target.layer_size( i ); j++) {
+          auto n = target.neuron(i, j).lock();
+          n->enable_bias();
+          n->set_bias( 0.1 * j - 0.2 );
+
+          for(unsigned int f = 0; f < n->factors_size(); f++) {
+            n->set_factor(f, sin( 1.0 + i * 5 + j * 3 + f ));
+          }
+        }
+      }
+    }
+
+    // It exports the network, builds a program with the generated header, runs it over the
+    // samples and returns what it printed
+    vector<vector<double>> compiled(const network &net, const vector<vector<double>> &samples) {
+      string header = prefix + "model.h", driver = prefix + "driver.cpp";
+      string program = prefix + "driver", results = prefix + "results.txt";
+
+      exporter( "exported" ).save( net, header );
+
+      FILE *code = fopen( driver.c_str(), "w" );
+      fprintf( code, "#include <cstdio>\n#include \"%s\"\n\nint main() {\n", header.c_str() );
+      fprintf( code, "  double inputs[%zu][exported::inputs] = {\n", samples.size() );
+      for( auto &sample : samples ) {
+        fprintf( code, "    {" );
+        for( auto value : sample ) fprintf( code, " %.17g,", value );
+        fprintf( code, " },\n" );
+      }
+      fprintf( code, "  };\n  double outputs[exported::outputs];\n\n" );
+      fprintf( code, "  for(unsigned int s = 0; s < %zu; s++) {\n", samples.size() );
+      fprintf( code, "    exported::predict( inputs[s], outputs );\n" );
+      fprintf( code, "    for( auto value : outputs ) printf( \"%%a \", value );\n" );
+      fprintf( code, "    printf( \"\\n\" );\n  }\n  return 0;\n}\n" );
+      fclose( code );
+
+      const char *compiler = getenv( "CXX" );
+      string command = string( compiler ? compiler : "g++" ) + " -std=c++14 -O3 -fno-math-errno "
+                       "-march=native -Wall -Wextra -Wpedantic -Werror " + driver + " -o " +
+                       program + " && " + program + " > " + results;
+      EXPECT_EQ(0, system( command.c_str() ));
+
+      vector<vector<double>> outputs;
+      FILE *printed = fopen( results.c_str(), "r" );
+      for(unsigned int s = 0; printed && s < samples.size(); s++) {
+        vector<double> row( net.layer_size( net.layers() - 1 ) );
+        for( auto &value : row ) {
+          if( fscanf( printed, "%la", &value ) != 1 ) value = NAN;
+        }
+        outputs.push_back( row );
+      }
+      if( printed ) fclose( printed );
+
+      for( auto &path : { header, driver, program, results } ) remove( path.c_str() );
+      return outputs;
+    }
+
+    string prefix;
+};
+#endif
@@ -0,0 +1,141 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "factorization_test.h"
+
+TEST_F(LowRank, DecompositionRebuildsTheMatrix) {
+  for( auto shape : vector<pair<unsigned int, unsigned int>>{ {7, 5}, {4, 9}, {6, 6} } ) {
+    vector<double> matrix( shape.first * shape.second );
+    for(unsigned int i = 0; i < matrix.size(); i++) matrix[i] = sin( 1.0 + 3 * i ) + 0.1 * i;
+
+    auto parts = factorizer::decompose( matrix, shape.first, shape.second );
+    unsigned int rank = min( shape.first, shape.second );
+    ASSERT_EQ(rank, parts.singular.size());
+    ASSERT_EQ(shape.first * rank, parts.u.size());
+    ASSERT_EQ(shape.second * rank, parts.v.size());
+
+    auto rebuilt = rebuild( parts );
+    for(unsigned int i = 0; i < matrix.size(); i++) EXPECT_NEAR(matrix[i], rebuilt[i], 1e-10);
+
+    for(unsigned int k = 1; k < rank; k++) EXPECT_GE(parts.singular[k - 1], parts.singular[k]);
+
+    // The columns of u and v are orthonormal
+    for(unsigned int a = 0; a < rank; a++) {
+      for(unsigned int b = 0; b < rank; b++) {
+        double uu = 0.0, vv = 0.0;
+        for(unsigned int i = 0; i < shape.first; i++) {
+          uu += parts.u[i * rank + a] * parts.u[i * rank + b];
+        }
+        for(unsigned int i = 0; i < shape.second; i++) {
+          vv += parts.v[i * rank + a] * parts.v[i * rank + b];
+        }
+
+        EXPECT_NEAR(a == b ? 1.0 : 0.0, uu, 1e-10);
+        EXPECT_NEAR(a == b ? 1.0 : 0.0, vv, 1e-10);
+      }
+    }
+  }
+
+  EXPECT_THROW(factorizer::decompose( vector<double>( 5 ), 2, 3 ), invalid_argument);
+}
+
+TEST_F(LowRank, RankKeepsTheEnergy) {
+  // Energies 16, 4 and 1 out of 21
+  vector<double> singular = { 4.0, 2.0, 1.0 };
+
+  EXPECT_EQ(1U, factorizer( 0.7 ).rank( singular ));
+  EXPECT_EQ(2U, factorizer( 0.9 ).rank( singular ));
+  EXPECT_EQ(3U, factorizer( 1.0 ).rank( singular ));
+  EXPECT_EQ(1U, factorizer( 1.0 ).rank( { 0.0, 0.0 } ));
+
+  EXPECT_THROW(factorizer( 0.0 ), invalid_argument);
+  EXPECT_THROW(factorizer().energy( 1.5 ), invalid_argument);
+  EXPECT_DOUBLE_EQ(0.9, factorizer().energy());
+}
+
+TEST_F(LowRank, LowRankLayersAreSplit) {
+  network net(1, 12, 3);
+  prepare( net, 10 );
+
+  // The first layer gets a rank 2 matrix, the output layer is too small to gain anything
+  for(unsigned int j = 0; j < 12; j++) {
+    auto n = net.neuron(0, j).lock();
+    for(unsigned int f = 0; f < 10; f++) {
+      n->set_factor(f, sin( 1.0 + j ) * cos( 0.5 * f ) + 0.3 * cos( 2.0 * j ) * sin( f ));
+    }
+  }
+
+  vector<vector<double>> samples;
+  for(unsigned int s = 0; s < 10; s++) {
+    vector<double> inputs( 10 );
+    for(unsigned int i = 0; i < 10; i++) inputs[i] = cos( 0.7 * s + i );
+    samples.push_back( inputs );
+  }
+
+  vector<vector<double>> before;
+  for( auto &inputs : samples ) before.push_back( net.output( inputs ) );
+
+  auto ranks = factorizer( 0.999999 ).factorize( net );
+  EXPECT_EQ(vector<unsigned int>({ 2, 0 }), ranks);
+  ASSERT_EQ(3U, net.layers());
+  EXPECT_EQ(2U, net.layer_size( 0 ));
+  EXPECT_EQ(activation_kind::linear, net.activation( 0 ));
+  EXPECT_FALSE(net.neuron(0, 0).lock()->bias_enabled());
+  EXPECT_EQ(12U, net.layer_size( 1 ));
+  EXPECT_EQ(activation_kind::relu, net.activation( 1 ));
+  EXPECT_EQ(2U, net.layer_inputs( 1 ));
+
+  for(unsigned int s = 0; s < samples.size(); s++) {
+    auto result = net.output( samples[s] );
+    for(unsigned int k = 0; k < 3; k++) EXPECT_NEAR(before[s][k], result[k], 1e-9);
+  }
+}
+
+TEST_F(LowRank, ReportComparesEachThreshold) {
+  network net(2, 24, 3);
+  prepare( net, dat.inputs_length() );
+
+  trainer t;
+  t.epochs( 20 );
+  t.train( net, dat );
+  auto weights = net.weights();
+  auto steps = net.optimizer()->steps( 0 );
+
+  factorizer f;
+  f.repeats( 2 );
+  f.fine_tuning( 2, t );
+  EXPECT_EQ(2U, f.iterations());
+
+  auto report = f.compare( net, { 0.5, 1.0 }, dat, dat );
+  EXPECT_EQ(weights, net.weights());
+  EXPECT_EQ(steps, net.optimizer()->steps( 0 ));
+  EXPECT_EQ(24U * 3 + 24 * 25 + 3 * 25, report.parameters);
+  EXPECT_EQ(24U * 2 + 24 * 24 + 3 * 24, report.operations);
+  ASSERT_EQ(2U, report.levels.size());
+
+  // Keeping all of the energy never pays off, half of it does for the 24 x 24 layer
+  EXPECT_EQ(vector<unsigned int>({ 0, 0, 0 }), report.levels[1].ranks);
+  EXPECT_EQ(report.operations, report.levels[1].operations);
+  EXPECT_GT(report.levels[0].ranks[1], 0U);
+  EXPECT_LT(report.levels[0].operations, report.operations);
+
+  for( auto &level : report.levels ) {
+    EXPECT_GT(level.seconds, 0.0);
+    EXPECT_GT(level.speedup, 0.0);
+    EXPECT_EQ(level.accuracy - report.accuracy, level.accuracy_change);
+  }
+}
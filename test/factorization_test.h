@@ -0,0 +1,62 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___FACTORIZATION_TEST___
+#define ___FACTORIZATION_TEST___
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include "factorization.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class LowRank : public ::testing::Test {
+  protected:
+    LowRank() {
+      dat.reload( "db/test_blobs.dat" );
+    }
+
+    ~LowRank() {}
+
+    // It connects a network to the given inputs, with enabled biases and He weights
+    void prepare(network &target, const unsigned int &inputs) {
+      connect( target, inputs, scheme::he, 8 );
+      target.activation( 0, activation_kind::relu );
+    }
+
+    // It rebuilds u * s * v^T
+    vector<double> rebuild(const decomposition &parts) {
+      unsigned int rank = parts.singular.size();
+      vector<double> result( parts.rows * parts.columns, 0.0 );
+
+      for(unsigned int i = 0; i < parts.rows; i++) {
+        for(unsigned int j = 0; j < parts.columns; j++) {
+          for(unsigned int k = 0; k < rank; k++) {
+            result[i * parts.columns + j] += parts.u[i * rank + k] * parts.singular[k] *
+                                             parts.v[j * rank + k];
+          }
+        }
+      }
+
+      return result;
+    }
+
+    data dat;
+};
+#endif
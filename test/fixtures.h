@@ -0,0 +1,37 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___FIXTURES___
+#define ___FIXTURES___
+#include <vector>
+#include "network.h"
+#include "initializer.h"
+
+using namespace mp;
+using namespace std;
+
+// It connects a network to inputs of the given size, with every bias enabled and the factors
+// drawn with the given scheme and seed
+inline void connect(network &target, const unsigned int &inputs, const scheme &method,
+                    const unsigned long long &seed) {
+  target.feed( vector<double>( inputs, 0.0 ) );
+
+  initializer init( method, seed );
+  init.biases( true );
+  init.initialize( target );
+}
+#endif
@@ -0,0 +1,124 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "halving_test.h"
+
+TEST_F(SuccessiveHalving, RoundsShrinkAndReportTheSavedCompute) {
+  vector<network> models;
+  models.reserve( 9 );
+
+  successive_halving search;
+  search.budget( 1, 9 );
+  search.reduction( 3 );
+  search.threads( 3 );
+
+  for(unsigned int i = 0; i < 9; i++) {
+    models.emplace_back( 1, 4, 3 );
+    prepare( models[i], i + 1, 0.05 * i );
+    search.add( models[i], settings );
+  }
+
+  auto report = search.run( dat, dat );
+
+  ASSERT_EQ(3, report.rungs.size());
+  EXPECT_EQ(1, report.rungs[0].budget);
+  EXPECT_EQ(3, report.rungs[1].budget);
+  EXPECT_EQ(9, report.rungs[2].budget);
+  EXPECT_EQ(9, report.rungs[0].candidates.size());
+  EXPECT_EQ(3, report.rungs[1].candidates.size());
+  EXPECT_EQ(1, report.rungs[2].candidates.size());
+  EXPECT_EQ(report.rungs[1].candidates, report.rungs[0].survivors);
+  EXPECT_EQ(9, report.epochs[report.best]);
+
+  // 9 candidates for 1 epoch, 3 for 2 more and 1 for 6 more, against 9 for 9 epochs
+  unsigned long long epoch_cost = dat.elements() * models[0].weights().size();
+  EXPECT_EQ(21 * epoch_cost, report.compute);
+  EXPECT_EQ(81 * epoch_cost, report.exhaustive_compute);
+  EXPECT_DOUBLE_EQ(1.0 - 21.0 / 81.0, report.saved);
+}
+
+TEST_F(SuccessiveHalving, UntrainedCandidatesAreDropped) {
+  network frozen(1, 4, 3), slow(1, 4, 3), good(1, 4, 3);
+  prepare( frozen, 1, 0.0 );
+  prepare( slow, 1, 0.001 );
+  prepare( good, 1, 0.2 );
+
+  successive_halving search;
+  search.budget( 2, 8 );
+  search.reduction( 2 );
+  search.add( frozen, settings );
+  search.add( slow, settings );
+  search.add( good, settings );
+
+  auto report = search.run( dat, dat );
+
+  EXPECT_EQ(2, report.best);
+  EXPECT_EQ(vector<unsigned int>({ 2 }), report.rungs[0].survivors);
+  EXPECT_EQ(2, report.epochs[0]);
+  EXPECT_EQ(2, report.epochs[1]);
+  EXPECT_EQ(8, report.epochs[2]);
+  EXPECT_LT(report.scores[2], report.scores[0]);
+}
+
+TEST_F(SuccessiveHalving, ResumedCandidatesFollowTheirSchedule) {
+  network resumed(1, 4, 3), straight(1, 4, 3);
+  prepare( resumed, 7, 0.1 );
+  prepare( straight, 7, 0.1 );
+
+  settings.schedule( make_shared<schedule::step>(0.2, 0.5, 2) );
+
+  successive_halving search;
+  search.budget( 1, 5 );
+  search.add( resumed, settings );
+  auto report = search.run( dat, dat );
+
+  settings.epochs( 5 );
+  settings.train( straight, dat );
+
+  EXPECT_EQ(2, report.rungs.size());
+  EXPECT_EQ(straight.weights(), resumed.weights());
+  EXPECT_DOUBLE_EQ(0.05, resumed.optimizer()->learning_rate());
+}
+
+TEST_F(SuccessiveHalving, StoppedCandidatesResumeFromTheirOwnEpoch) {
+  network candidate(1, 4, 3);
+  prepare( candidate, 7, 0.1 );
+
+  // No epoch is good enough, so every round stops after three epochs
+  settings.early_stopping( 1, 1e9, criterion::mse );
+  settings.restore_best( false );
+  settings.schedule( make_shared<schedule::step>(0.2, 0.5, 1) );
+
+  successive_halving search;
+  search.budget( 4, 9 );
+  search.add( candidate, settings );
+  auto report = search.run( dat, dat );
+
+  // The second round starts at epoch 3, not at the budget of the first one
+  ASSERT_EQ(2, report.rungs.size());
+  EXPECT_EQ(6, report.epochs[0]);
+  EXPECT_DOUBLE_EQ(0.2 * pow( 0.5, 5 ), candidate.optimizer()->learning_rate());
+}
+
+TEST_F(SuccessiveHalving, InvalidSettingsAreRejected) {
+  successive_halving search;
+
+  EXPECT_THROW(search.budget( 0, 4 ), invalid_argument);
+  EXPECT_THROW(search.budget( 5, 4 ), invalid_argument);
+  EXPECT_THROW(search.reduction( 1 ), invalid_argument);
+  EXPECT_THROW(search.run( dat, dat ), invalid_argument);
+}
@@ -0,0 +1,48 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___HALVING_TEST___
+#define ___HALVING_TEST___
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <cmath>
+#include "halving.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class SuccessiveHalving : public ::testing::Test {
+  protected:
+    SuccessiveHalving() {
+      dat.reload( "db/test_blobs.dat" );
+      settings.restore_best( false );
+    }
+
+    ~SuccessiveHalving() {}
+
+    // It connects a network to the data set, with the given weights seed and learning rate
+    void prepare(network &target, const unsigned int &seed, const double &learning) {
+      connect( target, dat.inputs_length(), scheme::xavier, seed );
+      target.optimizer()->learning_rate( learning );
+    }
+
+    data dat;
+    trainer settings;
+};
+#endif
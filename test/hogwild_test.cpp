@@ -0,0 +1,80 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "hogwild_test.h"
+
+TEST_F(AsynchronousSgd, OneThreadIsPlainSgd) {
+  network other(1, 8, 3);
+  prepare( other );
+
+  hogwild trainer( 1, 0.05 );
+  trainer.sparse( false );
+  trainer.train( net, dat, 3, 11 );
+
+  // The same updates, one sample after another
+  auto weights = other.weights();
+  vector<unsigned int> order( dat.elements() );
+  iota( order.begin(), order.end(), 0 );
+
+  for(unsigned int epoch = 0; epoch < 3; epoch++) {
+    mt19937 generator( 11 + epoch );
+    shuffle( order.begin(), order.end(), generator );
+
+    for( auto index : order ) {
+      other.weights( weights );
+      auto gradient = other.gradients( *(dat.input( index ).lock()),
+                                       *(dat.output( index ).lock()) );
+      for(unsigned int i = 0; i < weights.size(); i++) weights[i] -= 0.05 * gradient[i];
+    }
+  }
+
+  other.weights( weights );
+  EXPECT_EQ(other.weights(), net.weights());
+}
+
+TEST_F(AsynchronousSgd, ThreadsLearnTogether) {
+  auto before = evaluator().evaluate( net, dat );
+
+  hogwild trainer( 4, 0.05 );
+  trainer.train( net, dat, 30, 3 );
+  auto after = evaluator().evaluate( net, dat );
+
+  EXPECT_LT(after.mse, before.mse);
+  EXPECT_GT(after.accuracy, 0.9);
+}
+
+TEST_F(AsynchronousSgd, SparseUpdatesSkipZeroGradients) {
+  network other(1, 8, 3);
+  prepare( other );
+
+  hogwild dense( 2, 0.05 );
+  dense.sparse( false );
+  hogwild sparse( 2, 0.05 );
+
+  unsigned long all = dense.train( net, dat, 2 );
+  unsigned long some = sparse.train( other, dat, 2 );
+
+  EXPECT_EQ(2UL * dat.elements() * net.weights().size(), all);
+  EXPECT_LT(some, all);
+}
+
+TEST_F(AsynchronousSgd, SamplesMustFitTheNetwork) {
+  network small(1, 8, 2);
+  small.feed( vector<double>( dat.inputs_length(), 0.0 ) );
+
+  EXPECT_THROW(hogwild().train( small, dat, 1 ), invalid_argument);
+}
@@ -0,0 +1,50 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___HOGWILD_TEST___
+#define ___HOGWILD_TEST___
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include "hogwild.h"
+#include "evaluation.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class AsynchronousSgd : public ::testing::Test {
+  protected:
+    AsynchronousSgd() {
+      dat.reload( "db/test_blobs.dat" );
+      prepare( net );
+    }
+
+    ~AsynchronousSgd() {}
+
+    // It connects a network to the data set, with ReLU hidden neurons
+    void prepare(network &target) {
+      connect( target, dat.inputs_length(), scheme::he, 8 );
+      target.activation( 0, activation_kind::relu );
+    }
+
+    data dat;
+    network net = network(1, 8, 3);
+};
+#endif
@@ -0,0 +1,134 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "initializer_test.h"
+
+TEST_F(WeightInitialization, ResultDoesNotDependOnThreads) {
+  initializer single( scheme::he, 42 );
+  initializer parallel( scheme::he, 42 );
+  parallel.threads( 7 );
+
+  single.initialize( net );
+  auto expected = net.weights();
+
+  parallel.initialize( net );
+  EXPECT_EQ(expected, net.weights());
+}
+
+TEST_F(WeightInitialization, SeedsGiveDifferentFactors) {
+  initializer first( scheme::xavier, 1 );
+  initializer second( scheme::xavier, 2 );
+
+  first.initialize( net );
+  auto weights = net.weights();
+  second.initialize( net );
+
+  EXPECT_NE(weights, net.weights());
+}
+
+TEST_F(WeightInitialization, XavierStaysInsideItsLimit) {
+  initializer xavier( scheme::xavier, 3 );
+  xavier.initialize( net );
+
+  auto weights = net.weights();
+  double limit = sqrt( 6.0 / (20 + 64) );
+  auto values = factors( weights, 0 );
+
+  double smallest = *min_element( values.begin(), values.end() );
+  double biggest = *max_element( values.begin(), values.end() );
+  EXPECT_GE(smallest, -limit);
+  EXPECT_LE(biggest, limit);
+  EXPECT_LT(smallest, -0.9 * limit);
+  EXPECT_GT(biggest, 0.9 * limit);
+}
+
+TEST_F(WeightInitialization, HeMatchesItsVariance) {
+  initializer he( scheme::he, 4 );
+  he.initialize( net );
+
+  auto values = factors( net.weights(), 1 );
+  double mean = 0;
+  double variance = 0;
+
+  for( auto v : values ) mean += v;
+  mean /= values.size();
+  for( auto v : values ) variance += (v - mean) * (v - mean);
+  variance /= values.size();
+
+  // 4096 samples of N(0, 2 / 64)
+  EXPECT_NEAR(0, mean, 0.02);
+  EXPECT_NEAR(2.0 / 64, variance, 0.004);
+}
+
+TEST_F(WeightInitialization, BiasesStartAtZeroAndNeuronsDiffer) {
+  initializer uniform( scheme::uniform, 5 );
+  uniform.range( 0.1 );
+  uniform.initialize( net );
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      EXPECT_EQ(0, net.neuron(i, j).lock()->bias());
+    }
+  }
+
+  auto first = net.neuron(1, 0).lock()->factors();
+  auto second = net.neuron(1, 1).lock()->factors();
+  EXPECT_NE(first, second);
+  for( auto v : first ) EXPECT_LE(fabs( v ), 0.1);
+}
+
+TEST_F(WeightInitialization, BiasesCanBeEnabled) {
+  network fresh(1, 3, 2);
+  fresh.feed( vector<double>( 4, 0.0 ) );
+
+  initializer init( scheme::he, 3 );
+  EXPECT_FALSE(init.biases());
+  init.initialize( fresh );
+  EXPECT_FALSE(fresh.neuron(0, 0).lock()->bias_enabled());
+
+  init.biases( true );
+  EXPECT_TRUE(init.biases());
+  init.initialize( fresh );
+
+  for(unsigned int i = 0; i < fresh.layers(); i++) {
+    for(unsigned int j = 0; j < fresh.layer_size( i ); j++) {
+      EXPECT_TRUE(fresh.neuron(i, j).lock()->bias_enabled());
+      EXPECT_EQ(0, fresh.neuron(i, j).lock()->bias());
+    }
+  }
+}
+
+TEST_F(WeightInitialization, UnfedNetworksAreRejected) {
+  network unfed(1, 3, 1);
+  EXPECT_THROW(initializer().initialize( unfed ), invalid_argument);
+
+  unfed.feed( vector<double>( 2, 0.0 ) );
+  EXPECT_NO_THROW(initializer().initialize( unfed ));
+}
+
+TEST_F(WeightInitialization, StreamsAreUniform) {
+  double sum = 0;
+  for(unsigned int i = 0; i < 10000; i++) {
+    double u = initializer::uniform( 9, i );
+    ASSERT_GE(u, 0.0);
+    ASSERT_LT(u, 1.0);
+    sum += u;
+  }
+
+  EXPECT_NEAR(0.5, sum / 10000, 0.01);
+  EXPECT_EQ(initializer::uniform( 9, 17 ), initializer::uniform( 9, 17 ));
+}
@@ -0,0 +1,59 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___INITIALIZER_TEST___
+#define ___INITIALIZER_TEST___
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "initializer.h"
+
+using namespace mp;
+using namespace std;
+
+class WeightInitialization : public ::testing::Test {
+  protected:
+    WeightInitialization() {
+      net.feed( vector<double>( 20, 0.0 ) );
+
+      // Every bias enabled and away from zero, to see that they are reset
+      for(unsigned int i = 0; i < net.layers(); i++) {
+        for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+          auto n = net.neuron(i, j).lock();
+          n->enable_bias();
+          n->set_bias( 1.0 );
+        }
+      }
+    }
+
+    ~WeightInitialization() {}
+
+    // The factors of one layer, taken from the weights() layout
+    vector<double> factors(const vector<double> &weights, const unsigned int &layer) {
+      unsigned int begin = 0;
+      for(unsigned int i = 0; i < layer; i++) {
+        begin += net.layer_size( i ) * (net.layer_inputs( i ) + 1);
+      }
+
+      unsigned int size = net.layer_size( layer ) * net.layer_inputs( layer );
+      return vector<double>( weights.begin() + begin, weights.begin() + begin + size );
+    }
+
+    network net = network(2, 64, 10);
+};
+#endif
@@ -187,6 +187,30 @@ TEST_F(GeneralNetwork, ApplySoftmaxMakesOutputSumsOne) {
   ASSERT_NEAR(1, sum, 1e-15);
 }
 
+TEST_F(GeneralNetwork, ApplySoftmaxExponentiates) {
+  network net(1, 2, 3);
+  net.feed( vector<double>( 2, 1.0 ) );
+  net.activation( 1, activation_kind::linear );
+  net.neuron(1, 1).lock()->enable_bias();
+  net.neuron(1, 2).lock()->enable_bias();
+
+  // Only the biases of the outputs are set: 0, 1000 and 999
+  auto weights = net.weights();
+  fill( weights.begin(), weights.end(), 0.0 );
+  weights[4 + 2 + 6 + 1] = 1000.0;
+  weights[4 + 2 + 6 + 2] = 999.0;
+  net.weights( weights );
+
+  net.spread_out();
+  net.apply_softmax();
+
+  auto probabilities = net.output();
+  double e = exp( -1.0 );
+  EXPECT_NEAR(0.0, probabilities[0], 1e-15);
+  EXPECT_NEAR(1 / (1 + e), probabilities[1], 1e-15);
+  EXPECT_NEAR(e / (1 + e), probabilities[2], 1e-15);
+}
+
 TEST_F(GeneralNetwork, BackpropagateSingleValue) {
   network net(3, 3, 1);
   vector<double> inputs;
@@ -289,3 +313,762 @@ TEST_F(ParametizerNetworkConstructor, HiddenLayersHaveTheSpecifiedLength) {
 TEST_F(ParametizerNetworkConstructor, OutputLayerHaveTheSpecifiedLength) {
   EXPECT_EQ(10, net.layer_size( net.layers() - 1 ));
 }
+
+TEST_F(GeneralNetwork, GradientsMatchFiniteDifferences) {
+  network net(2, 3, 2);
+  vector<double> inputs;
+  vector<double> expected;
+
+  inputs.push_back(0.3);
+  inputs.push_back(-0.7);
+  expected.push_back(0.2);
+  expected.push_back(0.9);
+
+  net.feed(inputs);
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.1 * j - 0.15 );
+
+      for(unsigned int f = 0; f < n->factors_size(); f++) {
+        n->set_factor(f, sin( 2.0 + i * 5 + j * 3 + f ));
+      }
+    }
+  }
+
+  auto error = [&](const vector<double> &weights) {
+    net.weights( weights );
+    auto result = net.output( inputs );
+    double sum = 0;
+
+    for(unsigned int k = 0; k < result.size(); k++) {
+      sum += 0.5 * pow( expected[k] - result[k], 2 );
+    }
+
+    return sum;
+  };
+
+  auto weights = net.weights();
+  auto analytic = net.gradients( inputs, expected );
+  ASSERT_EQ(weights.size(), analytic.size());
+  ASSERT_EQ(weights, net.weights()) << "gradients must not change the weights";
+
+  const double h = 1e-6;
+  for(unsigned int w = 0; w < weights.size(); w++) {
+    auto plus = weights;
+    auto minus = weights;
+    plus[w] += h;
+    minus[w] -= h;
+
+    double numeric = (error( plus ) - error( minus )) / (2 * h);
+    ASSERT_NEAR(numeric, analytic[w], 1e-8 + 1e-5 * fabs( numeric )) << "weight " << w;
+  }
+}
+
+TEST_F(GeneralNetwork, DisabledBiasesHaveNoGradient) {
+  network net(1, 2, 1);
+  vector<double> inputs( 2, 1.0 );
+  vector<double> expected( 1, 1.0 );
+
+  auto values = net.gradients( inputs, expected );
+  // factors (2x2), biases (2), factors (1x2), bias (1)
+  ASSERT_EQ(9, values.size());
+  EXPECT_EQ(0, values[4]);
+  EXPECT_EQ(0, values[5]);
+  EXPECT_EQ(0, values[8]);
+}
+
+TEST_F(GeneralNetwork, BatchBackpropagateAveragesGradients) {
+  network net(1, 3, 1);
+  network reference(1, 3, 1);
+  vector<double> inputs0( 2, 0.5 );
+  vector<double> inputs1( 2, -1.0 );
+  vector<double> expected0( 1, 0.0 );
+  vector<double> expected1( 1, 1.0 );
+
+  net.feed( inputs0 );
+  reference.feed( inputs0 );
+
+  for( auto n : { &net, &reference } ) {
+    auto weights = n->weights();
+    for(unsigned int w = 0; w < weights.size(); w++) weights[w] = cos( 1.0 + w );
+    n->weights( weights );
+    n->optimizer( make_shared<mp::optimizer::sgd>(0.5, 0.0) );
+  }
+
+  auto start = reference.weights();
+  auto gradients0 = reference.gradients( inputs0, expected0 );
+  auto gradients1 = reference.gradients( inputs1, expected1 );
+
+  vector<const vector<double> *> batch_inputs = { &inputs0, &inputs1 };
+  vector<const vector<double> *> batch_expected = { &expected0, &expected1 };
+  net.backpropagate( batch_inputs, batch_expected );
+
+  auto result = net.weights();
+  for(unsigned int w = 0; w < result.size(); w++) {
+    ASSERT_NEAR(start[w] - 0.5 * 0.5 * (gradients0[w] + gradients1[w]), result[w], 1e-15);
+  }
+}
+
+TEST_F(GeneralNetwork, CompileKeepsTheWeights) {
+  network net(2, 4, 3);
+  net.feed( vector<double>( 3, 0.5 ) );
+  auto before = net.output( vector<double>( 3, 0.5 ) );
+  auto weights = net.weights();
+
+  net.compile( 3, 8 );
+  EXPECT_TRUE(net.compiled());
+  EXPECT_EQ(weights, net.weights());
+  EXPECT_EQ(before, net.output( vector<double>( 3, 0.5 ) ));
+}
+
+TEST_F(GeneralNetwork, CompiledNetworkRejectsOtherInputs) {
+  network net(1, 2, 1);
+  net.compile( 2 );
+
+  EXPECT_THROW(net.feed( vector<double>( 3, 1.0 ) ), invalid_argument);
+  EXPECT_THROW(net.output( vector<double>( 1, 1.0 ) ), invalid_argument);
+  EXPECT_TRUE(net.compiled());
+}
+
+TEST_F(GeneralNetwork, NeuronAccessReleasesTheCompiledState) {
+  network net(1, 2, 1);
+  vector<double> inputs( 2, 1.0 );
+  vector<double> expected( 1, 0.0 );
+
+  net.backpropagate( inputs, expected );
+  ASSERT_TRUE(net.compiled());
+  auto weights = net.weights();
+
+  auto n = net.neuron(1, 0).lock();
+  EXPECT_FALSE(net.compiled());
+  EXPECT_EQ(weights, net.weights());
+
+  n->set_factor(0, 2.0);
+  net.compile( 2 );
+  EXPECT_EQ(2.0, net.weights()[6]);
+
+  // The editable state accepts a new input size again
+  net.neuron(0, 0);
+  net.feed( vector<double>( 5, 1.0 ) );
+  EXPECT_EQ(5, net.neuron(0, 0).lock()->factors_size());
+}
+
+TEST_F(GeneralNetwork, BatchesLargerThanTheCapacityAreSplit) {
+  network net(1, 3, 2);
+  network reference(1, 3, 2);
+  vector<vector<double>> samples;
+  vector<vector<double>> targets;
+
+  for(unsigned int s = 0; s < 7; s++) {
+    samples.push_back( { sin( s + 1.0 ), cos( s + 1.0 ) } );
+    targets.push_back( { s % 2 ? 1.0 : 0.0, s % 3 ? 0.0 : 1.0 } );
+  }
+
+  vector<const vector<double> *> batch_inputs;
+  vector<const vector<double> *> batch_expected;
+  for(unsigned int s = 0; s < 7; s++) {
+    batch_inputs.push_back( &samples[s] );
+    batch_expected.push_back( &targets[s] );
+  }
+
+  net.compile( 2, 3 );
+  reference.compile( 2, 16 );
+  net.backpropagate( batch_inputs, batch_expected );
+  reference.backpropagate( batch_inputs, batch_expected );
+
+  auto result = net.weights();
+  auto expected = reference.weights();
+  for(unsigned int w = 0; w < result.size(); w++) {
+    ASSERT_NEAR(expected[w], result[w], 1e-15);
+  }
+}
+
+TEST_F(GeneralNetwork, NeuronsOutliveWeakPointersSafely) {
+  weak_ptr<mp::neuron::base> last;
+
+  {
+    network net(200, 50, 3);
+    last = net.neuron(199, 49);
+    ASSERT_FALSE(last.expired());
+  }
+
+  // The pointer is still readable once the network and its pool are gone
+  EXPECT_TRUE(last.expired());
+  EXPECT_EQ(nullptr, last.lock());
+}
+
+TEST_F(MixedLayers, OutputMatchesNeuronByNeuron) {
+  auto result = net.output( inputs );
+  auto values = reference();
+
+  ASSERT_EQ(values.size(), result.size());
+  for(unsigned int k = 0; k < result.size(); k++) {
+    EXPECT_NEAR(values[k], result[k], 1e-15);
+  }
+}
+
+TEST_F(MixedLayers, GradientsMatchFiniteDifferences) {
+  auto error = [&](const vector<double> &weights) {
+    net.weights( weights );
+    auto result = net.output( inputs );
+    double sum = 0;
+
+    for(unsigned int k = 0; k < result.size(); k++) {
+      sum += 0.5 * pow( expected[k] - result[k], 2 );
+    }
+
+    return sum;
+  };
+
+  auto weights = net.weights();
+  auto analytic = net.gradients( inputs, expected );
+
+  // The sigmoid without bias has no bias gradient
+  EXPECT_EQ(0, analytic[4 * 3 + 1]);
+
+  const double h = 1e-6;
+  for(unsigned int w = 0; w < weights.size(); w++) {
+    if( w == 4 * 3 + 1 ) continue;
+
+    auto plus = weights;
+    auto minus = weights;
+    plus[w] += h;
+    minus[w] -= h;
+
+    double numeric = (error( plus ) - error( minus )) / (2 * h);
+    ASSERT_NEAR(numeric, analytic[w], 1e-8 + 1e-5 * fabs( numeric )) << "weight " << w;
+  }
+}
+
+TEST_F(MixedLayers, AppliedBatchGradientsMatchBackpropagation) {
+  vector<double> second = { -0.2, 0.6, 0.1 };
+  vector<double> second_expected = { 0.9, 0.1 };
+  vector<const vector<double> *> batch = { &inputs, &second };
+  vector<const vector<double> *> batch_expected = { &expected, &second_expected };
+
+  auto weights = net.weights();
+  auto values = net.gradients( batch, batch_expected );
+  EXPECT_EQ(weights, net.weights());
+
+  // The gradient of the disabled bias is ignored
+  values[4 * 3 + 1] = 5.0;
+  net.apply_gradients( values );
+  auto applied = net.weights();
+
+  net.optimizer()->reset();
+  net.weights( weights );
+  net.backpropagate( batch, batch_expected );
+
+  EXPECT_EQ(net.weights(), applied);
+  EXPECT_THROW(net.apply_gradients( vector<double>( 3, 0.0 ) ), invalid_argument);
+}
+
+TEST_F(MixedLayers, CustomNeuronsCanNotBeReplicated) {
+  EXPECT_THROW(net.replica(), invalid_argument);
+}
+
+TEST_F(GeneralNetwork, ReplicasHaveTheirOwnNeurons) {
+  network net(1, 3, 2);
+  vector<double> inputs = { 0.5, -0.25 };
+  net.feed( inputs );
+  net.activation( 0, activation_kind::relu );
+  net.output_stage( stage::softmax );
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.1 * j );
+      for(unsigned int f = 0; f < n->factors_size(); f++) n->set_factor(f, sin( 1.0 + i + j + f ));
+    }
+  }
+
+  net.compile( 2 );
+  auto copy = net.replica();
+
+  EXPECT_TRUE(copy.compiled());
+  EXPECT_TRUE(net.stackable( copy ));
+  EXPECT_EQ(net.weights(), copy.weights());
+  EXPECT_EQ(net.output( inputs ), copy.output( inputs ));
+
+  copy.backpropagate( inputs, { 1.0, 0.0 } );
+  EXPECT_NE(net.weights(), copy.weights());
+  EXPECT_NE(net.neuron(1, 0).lock(), copy.neuron(1, 0).lock());
+}
+
+TEST_F(GeneralNetwork, ConstAccessorsKeepTheNetworkCompiled) {
+  network net(1, 3, 2);
+  vector<double> inputs = { 0.5, -0.25 };
+  net.feed( inputs );
+  net.compile( 2 );
+  net.backpropagate( inputs, { 1.0, 0.0 } );
+
+  // The trained factors only live in the arena, and reading the network must not move them
+  const network &view = net;
+  EXPECT_EQ(activation_kind::sigmoid, view.neuron(0, 1).lock()->kind());
+  auto copy = view.replica();
+
+  EXPECT_TRUE(net.compiled());
+  EXPECT_EQ(net.weights(), copy.weights());
+  EXPECT_EQ(net.output( inputs ), copy.output( inputs ));
+}
+
+TEST_F(GeneralNetwork, CopiesAreDeep) {
+  network net(1, 3, 2);
+  vector<double> inputs = { 0.5, -0.25 };
+  net.feed( inputs );
+  net.optimizer( make_shared<mp::optimizer::sgd>( 0.5, 0.05 ) );
+  net.compile( 2 );
+  net.backpropagate( inputs, { 1.0, 0.0 } );
+
+  network copy( net );
+  EXPECT_TRUE(copy.compiled());
+  EXPECT_EQ(net.weights(), copy.weights());
+  EXPECT_NE(net.optimizer(), copy.optimizer());
+  EXPECT_EQ(net.optimizer()->learning_rate(), copy.optimizer()->learning_rate());
+
+  network assigned(2, 4, 1);
+  assigned = net;
+  EXPECT_EQ(net.layers(), assigned.layers());
+  EXPECT_EQ(net.weights(), assigned.weights());
+
+  copy.backpropagate( inputs, { 0.0, 1.0 } );
+  EXPECT_NE(net.weights(), copy.weights());
+  EXPECT_EQ(net.weights(), assigned.weights());
+}
+
+TEST_F(GeneralNetwork, LayersCanSwitchTheirActivation) {
+  network net(2, 3, 2);
+  net.feed( vector<double>( 2, 0.5 ) );
+  net.neuron(0, 1).lock()->enable_bias();
+  net.neuron(0, 1).lock()->set_bias( 0.75 );
+  auto weights = net.weights();
+
+  net.activation( 0, activation_kind::relu );
+  net.activation( 2, activation_kind::linear );
+
+  EXPECT_EQ(activation_kind::relu, net.activation( 0 ));
+  EXPECT_EQ(activation_kind::sigmoid, net.activation( 1 ));
+  EXPECT_EQ(activation_kind::linear, net.activation( 2 ));
+  EXPECT_EQ(weights, net.weights());
+  EXPECT_TRUE(net.neuron(0, 1).lock()->bias_enabled());
+  EXPECT_THROW(net.activation( 1, activation_kind::custom ), invalid_argument);
+
+  net.neuron(1, 0, make_shared<mp::neuron::rbf>( 3, false ));
+  EXPECT_EQ(activation_kind::custom, net.activation( 1 ));
+}
+
+TEST_F(GeneralNetwork, ActivationFamilyGradientsMatchFiniteDifferences) {
+  network net(4, 4, 2);
+  vector<double> inputs = { 0.35, -0.8, 0.6 };
+  vector<double> expected = { 0.1, -0.4 };
+
+  net.feed( inputs );
+  net.activation( 0, activation_kind::hyperbolic_tangent );
+  net.activation( 1, activation_kind::leaky_relu );
+  net.activation( 2, activation_kind::relu );
+  net.activation( 3, activation_kind::rbf );
+  net.activation( 4, activation_kind::linear );
+
+  // A scattered rbf run inside a tanh layer
+  net.neuron(0, 1, make_shared<mp::neuron::rbf>( 3, true ));
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.15 * j - 0.1 );
+
+      for(unsigned int f = 0; f < n->factors_size(); f++) {
+        n->set_factor(f, 0.8 * sin( 1.5 + i * 5 + j * 3 + f ));
+      }
+    }
+  }
+
+  auto error = [&](const vector<double> &weights) {
+    net.weights( weights );
+    auto result = net.output( inputs );
+    double sum = 0;
+
+    for(unsigned int k = 0; k < result.size(); k++) {
+      sum += 0.5 * pow( expected[k] - result[k], 2 );
+    }
+
+    return sum;
+  };
+
+  auto weights = net.weights();
+  auto analytic = net.gradients( inputs, expected );
+
+  const double h = 1e-6;
+  for(unsigned int w = 0; w < weights.size(); w++) {
+    auto plus = weights;
+    auto minus = weights;
+    plus[w] += h;
+    minus[w] -= h;
+
+    double numeric = (error( plus ) - error( minus )) / (2 * h);
+    ASSERT_NEAR(numeric, analytic[w], 1e-8 + 1e-5 * fabs( numeric )) << "weight " << w;
+  }
+}
+
+TEST_F(GeneralNetwork, SoftmaxStageIsStable) {
+  network net(1, 3, 4);
+  net.feed( vector<double>( 2, 1.0 ) );
+  net.output_stage( stage::softmax );
+  EXPECT_EQ(stage::softmax, net.output_stage());
+
+  auto weights = net.weights();
+  for(unsigned int w = 0; w < weights.size(); w++) weights[w] = 300 * sin( 1.0 + w );
+  net.weights( weights );
+
+  auto probabilities = net.output( vector<double>( 2, 1.0 ) );
+  double sum = 0;
+  for( auto p : probabilities ) {
+    ASSERT_FALSE(std::isnan( p ));
+    sum += p;
+  }
+
+  EXPECT_NEAR(1, sum, 1e-15);
+
+  vector<const vector<double> *> block;
+  vector<vector<double>> results;
+  vector<double> inputs( 2, 1.0 );
+  block.push_back( &inputs );
+  net.predict( block, results );
+  EXPECT_EQ(probabilities, results[0]);
+}
+
+TEST_F(GeneralNetwork, SoftmaxGradientsMatchCrossEntropy) {
+  network net(2, 3, 3);
+  vector<double> inputs = { 0.5, -0.25 };
+  vector<double> expected = { 0.0, 1.0, 0.0 };
+
+  net.feed( inputs );
+  net.output_stage( stage::softmax );
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.1 * j - 0.2 );
+
+      for(unsigned int f = 0; f < n->factors_size(); f++) {
+        n->set_factor(f, sin( 0.5 + i * 4 + j * 3 + f ));
+      }
+    }
+  }
+
+  auto error = [&](const vector<double> &weights) {
+    net.weights( weights );
+    auto result = net.output( inputs );
+    double sum = 0;
+
+    for(unsigned int k = 0; k < result.size(); k++) {
+      sum -= expected[k] * log( result[k] );
+    }
+
+    return sum;
+  };
+
+  auto weights = net.weights();
+  auto analytic = net.gradients( inputs, expected );
+
+  const double h = 1e-6;
+  for(unsigned int w = 0; w < weights.size(); w++) {
+    auto plus = weights;
+    auto minus = weights;
+    plus[w] += h;
+    minus[w] -= h;
+
+    double numeric = (error( plus ) - error( minus )) / (2 * h);
+    ASSERT_NEAR(numeric, analytic[w], 1e-8 + 1e-5 * fabs( numeric )) << "weight " << w;
+  }
+}
+
+TEST_F(GeneralNetwork, RemovedNeuronsTakeTheirColumnWithThem) {
+  network net(2, 4, 2);
+  net.feed( { 0.3, -0.6, 0.9 } );
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.1 * j - 0.2 );
+
+      for(unsigned int f = 0; f < n->factors_size(); f++) {
+        n->set_factor(f, sin( 0.5 + i * 4 + j * 3 + f ));
+      }
+    }
+  }
+
+  // A neuron that the next layer ignores can be removed without changing the outputs
+  for(unsigned int j = 0; j < net.layer_size( 2 ); j++) net.neuron(2, j).lock()->set_factor(1, 0.0);
+  auto before = net.output( { 0.3, -0.6, 0.9 } );
+  auto kept = net.neuron(1, 2).lock();
+
+  net.remove_neuron( 1, 1 );
+  EXPECT_EQ(3U, net.layer_size( 1 ));
+  EXPECT_EQ(3U, net.layer_inputs( 2 ));
+  EXPECT_EQ(kept, net.neuron(1, 1).lock());
+  EXPECT_EQ(3U, net.neuron(2, 0).lock()->factors_size());
+  EXPECT_EQ(sin( 0.5 + 8 + 2 ), net.neuron(2, 0).lock()->factor( 1 ));
+  EXPECT_EQ(before, net.output( { 0.3, -0.6, 0.9 } ));
+
+  // The layers can now have different sizes
+  net.remove_neuron( 0, 3 );
+  EXPECT_EQ(3U, net.layer_size( 0 ));
+  EXPECT_EQ(3U, net.neuron(1, 0).lock()->factors_size());
+  EXPECT_EQ(2U, net.output( { 0.3, -0.6, 0.9 } ).size());
+
+  EXPECT_THROW(net.remove_neuron( 2, 0 ), invalid_argument);
+  EXPECT_THROW(net.remove_neuron( 1, 3 ), invalid_argument);
+  net.remove_neuron( 1, 0 );
+  net.remove_neuron( 1, 0 );
+  EXPECT_THROW(net.remove_neuron( 1, 0 ), invalid_argument);
+}
+
+TEST_F(GeneralNetwork, InsertedLayersResizeTheNextOne) {
+  network net(1, 4, 2);
+  net.feed( { 0.3, -0.6, 0.9 } );
+
+  net.insert_layer( 1, 6 );
+  ASSERT_EQ(3U, net.layers());
+  EXPECT_EQ(4U, net.layer_size( 0 ));
+  EXPECT_EQ(6U, net.layer_size( 1 ));
+  EXPECT_EQ(4U, net.neuron(1, 5).lock()->factors_size());
+  EXPECT_FALSE(net.neuron(1, 5).lock()->bias_enabled());
+  EXPECT_EQ(6U, net.neuron(2, 0).lock()->factors_size());
+  EXPECT_EQ(2U, net.output( { 0.3, -0.6, 0.9 } ).size());
+
+  net.insert_layer( 0, 2 );
+  EXPECT_EQ(4U, net.layers());
+  EXPECT_EQ(3U, net.layer_inputs( 0 ));
+  EXPECT_EQ(2U, net.layer_inputs( 1 ));
+
+  EXPECT_THROW(net.insert_layer( 5, 2 ), invalid_argument);
+  EXPECT_THROW(net.insert_layer( 1, 0 ), invalid_argument);
+}
+
+TEST_F(GeneralNetwork, CheckpointsKeepTheGradients) {
+  network net(7, 5, 3);
+  net.feed( vector<double>( 4, 0.0 ) );
+  net.activation( 1, activation_kind::relu );
+  net.activation( 2, activation_kind::rbf );
+  net.activation( 4, activation_kind::hyperbolic_tangent );
+  net.activation( 5, activation_kind::rbf );
+  net.output_stage( stage::softmax );
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.1 * j - 0.2 );
+
+      for(unsigned int f = 0; f < n->factors_size(); f++) {
+        n->set_factor(f, 0.7 * sin( 0.5 + i * 5 + j * 3 + f ));
+      }
+    }
+  }
+
+  vector<vector<double>> samples;
+  vector<vector<double>> targets;
+  for(unsigned int s = 0; s < 37; s++) {
+    samples.push_back( { sin( s * 1.0 ), cos( s * 0.5 ), 0.1 * s - 1.5, sin( s * 0.3 ) } );
+    targets.push_back( vector<double>( 3, 0.0 ) );
+    targets.back()[s % 3] = 1.0;
+  }
+
+  vector<const vector<double> *> inputs;
+  vector<const vector<double> *> expected;
+  for(unsigned int s = 0; s < samples.size(); s++) {
+    inputs.push_back( &samples[s] );
+    expected.push_back( &targets[s] );
+  }
+
+  auto weights = net.weights();
+  net.compile( 4, 16 );
+  auto reference = net.gradients( inputs, expected );
+
+  for( unsigned int every : { 0, 2, 3, 4, 7, 8, 20 } ) {
+    network other = net.replica();
+    other.checkpoint( every );
+    other.compile( 4, 16 );
+
+    EXPECT_EQ(max( every, 1U ), other.checkpoint());
+    EXPECT_EQ(reference, other.gradients( inputs, expected )) << "checkpoint " << every;
+    EXPECT_EQ(net.output( samples[5] ), other.output( samples[5] )) << "checkpoint " << every;
+  }
+
+  network trained = net.replica();
+  trained.checkpoint( 3 );
+  net.backpropagate( inputs, expected );
+  trained.backpropagate( inputs, expected );
+  EXPECT_NE(weights, net.weights());
+  EXPECT_EQ(net.weights(), trained.weights());
+}
+
+TEST_F(GeneralNetwork, CheckpointsShrinkTheArena) {
+  network net(8, 16, 16);
+  net.feed( vector<double>( 3, 0.0 ) );
+  EXPECT_EQ(1, net.checkpoint());
+  EXPECT_EQ(0, net.memory());
+
+  net.compile( 3, 64 );
+  size_t full = net.memory();
+  EXPECT_GT(full, 0);
+
+  // Every layer keeps its outputs and its deltas: 18 buffers of 64 x 16 values
+  net.checkpoint( 3 );
+  EXPECT_FALSE(net.compiled());
+  net.compile( 3, 64 );
+  size_t checkpointed = net.memory();
+
+  // Kept layers 2, 5 and 8, two shared buffers inside a segment and two for the deltas
+  EXPECT_EQ(full - 11 * 64 * 16 * sizeof(double), checkpointed);
+}
+
+TEST_F(GeneralNetwork, ActivationMemoryFollowsTheBatch) {
+  network net(8, 16, 16);
+  net.feed( vector<double>( 3, 0.0 ) );
+
+  // The inputs, and the outputs and deltas of the 9 layers for 10 samples
+  EXPECT_EQ((30 + 9 * 2 * 10 * 16) * sizeof(double), net.activation_memory( 10 ));
+
+  // Kept layers 2, 5 and 8, two shared buffers inside a segment and two for the deltas
+  net.checkpoint( 3 );
+  EXPECT_EQ((30 + 3 * 160 + 2 * 160 + 2 * 160) * sizeof(double), net.activation_memory( 10 ));
+
+  // Bigger batches are trained in chunks of the capacity
+  net.compile( 3, 4 );
+  EXPECT_EQ(net.activation_memory( 4 ), net.activation_memory( 10 ));
+  EXPECT_EQ((12 + 7 * 4 * 16) * sizeof(double), net.activation_memory( 4 ));
+  EXPECT_TRUE(net.compiled());
+}
+
+TEST_F(GeneralNetwork, PipelineStagesSplitTheWeights) {
+  network net(5, 8, 2);
+  net.feed( vector<double>( 8, 0.0 ) );
+  net.insert_layer( 2, 64 );
+
+  EXPECT_EQ(vector<unsigned int>({ 0, 7 }), net.pipeline_stages( 0 ));
+  EXPECT_EQ(vector<unsigned int>({ 0, 3, 7 }), net.pipeline_stages( 2 ));
+  EXPECT_EQ(vector<unsigned int>({ 0, 1, 2, 3, 4, 5, 6, 7 }), net.pipeline_stages( 20 ));
+}
+
+TEST_F(GeneralNetwork, PipelinedTrainingMatchesBackpropagation) {
+  network net(6, 6, 3);
+  net.feed( vector<double>( 4, 0.0 ) );
+  net.activation( 1, activation_kind::relu );
+  net.activation( 3, activation_kind::rbf );
+  net.activation( 4, activation_kind::hyperbolic_tangent );
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.1 * j - 0.2 );
+
+      for(unsigned int f = 0; f < n->factors_size(); f++) {
+        n->set_factor(f, 0.7 * sin( 0.5 + i * 5 + j * 3 + f ));
+      }
+    }
+  }
+
+  // A scattered rbf run inside a sigmoid layer
+  net.neuron(2, 1, make_shared<mp::neuron::rbf>( 6, true ));
+
+  vector<vector<double>> samples;
+  vector<vector<double>> targets;
+  for(unsigned int s = 0; s < 45; s++) {
+    samples.push_back( { sin( s * 1.0 ), cos( s * 0.5 ), 0.1 * s - 1.5, sin( s * 0.3 ) } );
+    targets.push_back( { 0.5 + 0.4 * sin( s * 0.7 ), 0.2, 0.5 - 0.4 * cos( s * 1.1 ) } );
+  }
+
+  vector<const vector<double> *> inputs;
+  vector<const vector<double> *> expected;
+  for(unsigned int s = 0; s < samples.size(); s++) {
+    inputs.push_back( &samples[s] );
+    expected.push_back( &targets[s] );
+  }
+
+  network reference = net.replica();
+  reference.compile( 4, 16 );
+  for(unsigned int step = 0; step < 3; step++) reference.backpropagate( inputs, expected );
+
+  for( unsigned int stages : { 1, 2, 3, 7 } ) {
+    network pipelined = net.replica();
+    pipelined.compile( 4, 16 );
+
+    for(unsigned int step = 0; step < 3; step++) {
+      pipelined.backpropagate_pipelined( inputs, expected, stages, 5 );
+    }
+
+    EXPECT_EQ(reference.weights(), pipelined.weights()) << stages << " stages";
+    EXPECT_EQ(reference.output(), pipelined.output()) << stages << " stages";
+  }
+
+  network checkpointed = net.replica();
+  checkpointed.checkpoint( 2 );
+  EXPECT_THROW(checkpointed.backpropagate_pipelined( inputs, expected, 2, 4 ), invalid_argument);
+  EXPECT_THROW(net.backpropagate_pipelined( inputs, expected, 2, 0 ), invalid_argument);
+
+  vector<double> wrong( 2, 0.0 );
+  expected[7] = &wrong;
+  EXPECT_THROW(net.backpropagate_pipelined( inputs, expected, 2, 4 ), invalid_argument);
+}
+
+TEST_F(GeneralNetwork, ReducedStorageRoundsTheForwardFactors) {
+  network net(2, 9, 2);
+  vector<double> inputs = { 0.35, -0.8, 0.6 };
+  vector<double> expected = { 0.1, 0.7 };
+  net.feed( inputs );
+
+  for(unsigned int i = 0; i < net.layers(); i++) {
+    for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+      auto n = net.neuron(i, j).lock();
+      n->enable_bias();
+      n->set_bias( 0.15 * j - 0.1 );
+
+      for(unsigned int f = 0; f < n->factors_size(); f++) {
+        n->set_factor(f, 0.8 * sin( 1.5 + i * 5 + j * 3 + f ));
+      }
+    }
+  }
+
+  auto weights = net.weights();
+  auto exact = net.output( inputs );
+  EXPECT_EQ(storage::float64, net.weight_storage());
+
+  for( auto format : { storage::bfloat16, storage::half } ) {
+    network reduced = net.replica();
+    reduced.weight_storage( format );
+    EXPECT_EQ(format, reduced.weight_storage());
+
+    auto outputs = reduced.output( inputs );
+    EXPECT_NE(exact, outputs);
+    for(unsigned int k = 0; k < exact.size(); k++) EXPECT_NEAR(exact[k], outputs[k], 1e-2);
+
+    // Every forward path reads the same rounded factors, compiled or not
+    vector<vector<double>> predicted;
+    reduced.predict( { &inputs }, predicted );
+    EXPECT_EQ(outputs, predicted[0]);
+    reduced.neuron(0, 0);
+    reduced.predict( { &inputs }, predicted );
+    EXPECT_EQ(outputs, predicted[0]);
+
+    // The optimizer updates the double factors, and the rounded ones follow them
+    EXPECT_EQ(weights, reduced.weights());
+    EXPECT_FALSE(reduced.stackable( net ));
+    reduced.backpropagate( inputs, expected );
+    EXPECT_NE(weights, reduced.weights());
+    EXPECT_NE(outputs, reduced.output( inputs ));
+
+    reduced.weight_storage( storage::float64 );
+    network trained = net.replica();
+    trained.weights( reduced.weights() );
+    EXPECT_EQ(trained.output( inputs ), reduced.output( inputs ));
+  }
+}
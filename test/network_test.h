@@ -50,3 +50,77 @@ class ParametizerNetworkConstructor : public ::testing::Test {
 
     network net;
 };
+
+// Neuron without a batched kernel, so the network has to evaluate it through its methods
+class halved : public mp::neuron::base {
+  public:
+    halved(const unsigned int &inputs_size) : mp::neuron::base(inputs_size, true) {}
+
+    double activation(const double &sum) const override {
+      return 0.5 * sum;
+    }
+
+    double derivative(const double &) const override {
+      return 0.5;
+    }
+
+  protected:
+    double calculate_output(const vector<double> &) override {
+      return 0.0;
+    }
+
+    double calculate_output(const vector<shared_ptr<mp::neuron::base>> &) override {
+      return 0.0;
+    }
+};
+
+class MixedLayers : public ::testing::Test {
+  protected:
+    MixedLayers() {
+      inputs = { 0.4, -0.9, 0.25 };
+      expected = { 0.3, 0.8 };
+      net.feed( inputs );
+
+      // sigmoid with bias, sigmoid without bias, halved, sigmoid with bias
+      net.neuron(0, 2, make_shared<halved>( 3 ));
+      net.neuron(0, 1).lock()->disable_bias();
+
+      for(unsigned int i = 0; i < net.layers(); i++) {
+        for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+          auto n = net.neuron(i, j).lock();
+          if( j != 1 || i != 0 ) n->enable_bias();
+          n->set_bias( 0.2 * j - 0.3 );
+
+          for(unsigned int f = 0; f < n->factors_size(); f++) {
+            n->set_factor(f, cos( 0.5 + i * 3 + j * 2 + f ));
+          }
+        }
+      }
+    }
+
+    ~MixedLayers() {}
+
+    // Output computed neuron by neuron with the virtual activation of each one
+    vector<double> reference() {
+      vector<double> current = inputs;
+
+      for(unsigned int i = 0; i < net.layers(); i++) {
+        vector<double> next;
+
+        for(unsigned int j = 0; j < net.layer_size( i ); j++) {
+          auto n = net.neuron(i, j).lock();
+          double sum = n->bias();
+          for(unsigned int f = 0; f < n->factors_size(); f++) sum += current[f] * n->factor( f );
+          next.push_back( n->activation( sum ) );
+        }
+
+        current = next;
+      }
+
+      return current;
+    }
+
+    network net = network(1, 4, 2);
+    vector<double> inputs;
+    vector<double> expected;
+};
@@ -0,0 +1,72 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "activations_test.h"
+
+TEST_F(ActivationFamily, CalculatesTheOutput) {
+  double expected[] = { 0.5, 0.46211715726, 0.5, 0.5, 0.77880078307 };
+
+  for(unsigned int i = 0; i < neurons.size(); i++) {
+    neurons[i]->refresh(input);
+    EXPECT_NEAR(expected[i], neurons[i]->output(), 1e-10) << "neuron " << i;
+  }
+}
+
+TEST_F(ActivationFamily, NegativeSums) {
+  neurons[0]->set_factor(0, -2);
+  neurons[1]->set_factor(0, -2);
+  neurons[2]->set_factor(0, -2);
+  neurons[3]->set_factor(0, -2);
+  neurons[4]->set_factor(0, -2);
+  // weighted sum = -2.5
+  double expected[] = { -2.5, -0.98661429815, 0.0, -0.025, 0.00193045413 };
+
+  for(unsigned int i = 0; i < neurons.size(); i++) {
+    neurons[i]->refresh(input);
+    EXPECT_NEAR(expected[i], neurons[i]->output(), 1e-10) << "neuron " << i;
+  }
+}
+
+TEST_F(ActivationFamily, DerivativesMatchTheActivation) {
+  for(unsigned int i = 0; i < neurons.size(); i++) {
+    check_derivative(*neurons[i], 0.7);
+    check_derivative(*neurons[i], 1.3);
+    check_derivative(*neurons[i], -0.4);
+  }
+
+  // The rbf output is the same for opposite sums, so only the slope gives its derivative
+  EXPECT_THROW(neurons[4]->derivative(0.5), std::logic_error);
+}
+
+TEST_F(ActivationFamily, ReportTheirKind) {
+  EXPECT_EQ(mp::neuron::activation_kind::linear, neurons[0]->kind());
+  EXPECT_EQ(mp::neuron::activation_kind::hyperbolic_tangent, neurons[1]->kind());
+  EXPECT_EQ(mp::neuron::activation_kind::relu, neurons[2]->kind());
+  EXPECT_EQ(mp::neuron::activation_kind::leaky_relu, neurons[3]->kind());
+  EXPECT_EQ(mp::neuron::activation_kind::rbf, neurons[4]->kind());
+}
+
+TEST_F(ActivationFamily, CopiesKeepFactorsAndBias) {
+  mp::neuron::sigmoid source(3, true);
+  source.set_factor(1, 0.25);
+  source.set_bias(-0.5);
+
+  mp::neuron::relu copy(source);
+  EXPECT_EQ(0.25, copy.factor(1));
+  EXPECT_EQ(-0.5, copy.bias());
+  EXPECT_TRUE(copy.bias_enabled());
+}
@@ -0,0 +1,61 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+#include <cmath>
+#include "neuron/linear.h"
+#include "neuron/hyperbolic_tangent.h"
+#include "neuron/relu.h"
+#include "neuron/leaky_relu.h"
+#include "neuron/rbf.h"
+#include "neuron/sigmoid.h"
+
+class ActivationFamily : public ::testing::Test {
+  protected:
+    ActivationFamily() {
+      input.push_back(1);
+      input.push_back(-2);
+      input.push_back(1.5);
+
+      neurons.push_back(std::make_shared<mp::neuron::linear>(input.size(), false));
+      neurons.push_back(std::make_shared<mp::neuron::hyperbolic_tangent>(input.size(), false));
+      neurons.push_back(std::make_shared<mp::neuron::relu>(input.size(), false));
+      neurons.push_back(std::make_shared<mp::neuron::leaky_relu>(input.size(), false));
+      neurons.push_back(std::make_shared<mp::neuron::rbf>(input.size(), false));
+
+      for(auto neuron : neurons) {
+        for(unsigned int i = 0; i < neuron->factors_size(); i++) {
+          neuron->set_factor(i, 1);
+        }
+      }
+      // weighted sum = 0.5
+    }
+
+    ~ActivationFamily() {}
+
+    // It checks the derivative of a neuron against a central difference of its activation
+    void check_derivative(const mp::neuron::base &neuron, const double &sum) {
+      const double h = 1e-6;
+      double numeric = (neuron.activation(sum + h) - neuron.activation(sum - h)) / (2 * h);
+      EXPECT_NEAR(numeric, neuron.slope(sum), 1e-8) << "sum " << sum;
+    }
+
+    std::vector<double> input;
+    std::vector<std::shared_ptr<mp::neuron::base>> neurons;
+};
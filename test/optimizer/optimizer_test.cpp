@@ -0,0 +1,156 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "optimizer_test.h"
+#include <cmath>
+#include "neuron/sigmoid.h"
+#include "network.h"
+
+TEST_F(OptimizerStep, SgdFollowsApplyChanges) {
+  mp::neuron::sigmoid neuron(parameters.size(), false);
+  mp::optimizer::sgd opt(0.9, 0.1);
+  neuron.set_factors(parameters);
+  neuron.reset_changes();
+
+  // Drop the last change left by set_factors
+  for(unsigned int i = 0; i < parameters.size(); i++) {
+    neuron.add_factor_change(i, 0);
+  }
+  neuron.set_factors(neuron.factors());
+
+  for(unsigned int s = 0; s < 3; s++) {
+    for(unsigned int i = 0; i < gradients.size(); i++) {
+      neuron.add_factor_change(i, gradients[i] / (s + 1));
+    }
+    neuron.apply_changes(0.9, 0.1);
+
+    std::vector<double> step_gradients;
+    for( double g : gradients ) step_gradients.push_back( g / (s + 1) );
+    opt.step(0, parameters.data(), step_gradients.data(), parameters.size());
+
+    for(unsigned int i = 0; i < parameters.size(); i++) {
+      ASSERT_DOUBLE_EQ(neuron.factor(i), parameters[i]) << "step " << s << ", factor " << i;
+    }
+  }
+}
+
+TEST_F(OptimizerStep, NesterovLooksAhead) {
+  mp::optimizer::nesterov opt(0.1, 0.5);
+  auto start = parameters;
+
+  opt.step(0, parameters.data(), gradients.data(), parameters.size());
+  for(unsigned int i = 0; i < parameters.size(); i++) {
+    // velocity = -0.1 g, factor += 1.5 * velocity
+    ASSERT_DOUBLE_EQ(start[i] - 1.5 * 0.1 * gradients[i], parameters[i]);
+  }
+
+  auto middle = parameters;
+  opt.step(0, parameters.data(), gradients.data(), parameters.size());
+  for(unsigned int i = 0; i < parameters.size(); i++) {
+    double previous = -0.1 * gradients[i];
+    double current = 0.5 * previous - 0.1 * gradients[i];
+    ASSERT_NEAR(middle[i] + 1.5 * current - 0.5 * previous, parameters[i], 1e-15);
+  }
+}
+
+TEST_F(OptimizerStep, RmspropScalesByAverage) {
+  mp::optimizer::rmsprop opt(0.01, 0.9, 0.0);
+  auto start = parameters;
+
+  opt.step(0, parameters.data(), gradients.data(), parameters.size());
+  for(unsigned int i = 0; i < parameters.size(); i++) {
+    double expected = start[i] - 0.01 * gradients[i] / (sqrt(0.1) * fabs( gradients[i] ));
+    ASSERT_NEAR(expected, parameters[i], 1e-15);
+  }
+}
+
+TEST_F(OptimizerStep, AdamFirstStepIsLearningRateSized) {
+  mp::optimizer::adam opt(0.001);
+  auto start = parameters;
+
+  opt.step(0, parameters.data(), gradients.data(), parameters.size());
+  for(unsigned int i = 0; i < parameters.size(); i++) {
+    double sign = (gradients[i] > 0) ? 1 : -1;
+    ASSERT_NEAR(start[i] - 0.001 * sign, parameters[i], 1e-7);
+  }
+}
+
+TEST_F(OptimizerStep, StateIsContiguousPerLayer) {
+  mp::optimizer::adam opt(0.001);
+  std::vector<double> small(2, 1.0);
+  std::vector<double> small_gradients(2, 1.0);
+
+  opt.step(0, parameters.data(), gradients.data(), parameters.size());
+  opt.step(1, small.data(), small_gradients.data(), small.size());
+  opt.step(1, small.data(), small_gradients.data(), small.size());
+
+  EXPECT_EQ(2 * parameters.size(), opt.state(0).size());
+  EXPECT_EQ(2 * small.size(), opt.state(1).size());
+  EXPECT_EQ(1, opt.steps(0));
+  EXPECT_EQ(2, opt.steps(1));
+
+  // first moment, then second moment
+  EXPECT_DOUBLE_EQ(0.1 * gradients[2], opt.state(0)[2]);
+  EXPECT_DOUBLE_EQ(0.001 * gradients[2] * gradients[2], opt.state(0)[parameters.size() + 2]);
+
+  // A layer that changes its size starts again
+  opt.step(1, parameters.data(), gradients.data(), parameters.size());
+  EXPECT_EQ(1, opt.steps(1));
+
+  opt.reset();
+  EXPECT_THROW(opt.state(0), std::out_of_range);
+}
+
+TEST_F(OptimizerStep, ClonesStartWithoutState) {
+  mp::optimizer::adam opt(0.002, 0.8, 0.99, 1e-6);
+  auto copy = parameters;
+  opt.step(0, parameters.data(), gradients.data(), parameters.size());
+
+  auto clone = opt.clone();
+  EXPECT_NE(&opt, clone.get());
+  EXPECT_EQ(0.002, clone->learning_rate());
+  EXPECT_THROW(clone->state(0), std::out_of_range);
+
+  // The same hyperparameters give the same first step
+  clone->step(0, copy.data(), gradients.data(), copy.size());
+  EXPECT_EQ(parameters, copy);
+  EXPECT_EQ(1, opt.steps(0));
+
+  mp::optimizer::rmsprop rms(0.01, 0.5, 0.1);
+  auto other = rms.clone();
+  ASSERT_NE(nullptr, std::dynamic_pointer_cast<mp::optimizer::rmsprop>( other ));
+  EXPECT_EQ(0.5, std::dynamic_pointer_cast<mp::optimizer::rmsprop>( other )->decay());
+}
+
+TEST_F(OptimizerStep, NetworkUsesTheGivenOptimizer) {
+  mp::network net(2, 4, 1);
+  std::vector<double> inputs(2, 1.0);
+  std::vector<double> expected(1, 0.2);
+  auto opt = std::make_shared<mp::optimizer::adam>(0.05);
+
+  net.optimizer( opt );
+  ASSERT_EQ(opt, net.optimizer());
+
+  double start_error = fabs( 0.2 - net.output( inputs )[0] );
+  for(unsigned int i = 0; i < 200; i++) {
+    net.backpropagate( inputs, expected );
+  }
+  double end_error = fabs( 0.2 - net.output( inputs )[0] );
+
+  EXPECT_LT(end_error, start_error);
+  EXPECT_EQ(200, opt->steps( net.layers() - 1 ));
+}
@@ -0,0 +1,44 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <memory>
+#include "optimizer/sgd.h"
+#include "optimizer/nesterov.h"
+#include "optimizer/rmsprop.h"
+#include "optimizer/adam.h"
+
+class OptimizerStep : public ::testing::Test {
+  protected:
+    OptimizerStep() {
+      parameters.push_back(0.5);
+      parameters.push_back(-1.0);
+      parameters.push_back(2.0);
+      parameters.push_back(0.0);
+
+      gradients.push_back(0.25);
+      gradients.push_back(-0.5);
+      gradients.push_back(1.5);
+      gradients.push_back(-2.0);
+    }
+
+    ~OptimizerStep() {}
+
+    std::vector<double> parameters;
+    std::vector<double> gradients;
+};
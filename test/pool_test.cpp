@@ -0,0 +1,64 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "pool_test.h"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+TEST_F(ObjectPool, PiecesAreAlignedAndShareChunks) {
+  void *first = storage->allocate( 24 );
+  void *second = storage->allocate( 24 );
+
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>( first ) % alignof(max_align_t));
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>( second ) % alignof(max_align_t));
+  EXPECT_EQ(1, storage->chunks());
+}
+
+TEST_F(ObjectPool, ReleasedPiecesAreReused) {
+  void *first = storage->allocate( 40 );
+  storage->deallocate( first, 40 );
+
+  EXPECT_EQ(0, storage->used());
+  EXPECT_EQ(first, storage->allocate( 40 ));
+}
+
+TEST_F(ObjectPool, LargePiecesTakeTheirOwnChunk) {
+  storage->allocate( 16 );
+  storage->allocate( 1024 );
+
+  EXPECT_EQ(2, storage->chunks());
+}
+
+TEST_F(ObjectPool, AllocatorKeepsThePoolAlive) {
+  weak_ptr<pool> observer( storage );
+  weak_ptr<vector<double>> value;
+
+  {
+    auto shared = allocate_shared<vector<double>>( pool_allocator<vector<double>>( storage ), 3 );
+    value = shared;
+    storage.reset();
+
+    EXPECT_FALSE(observer.expired());
+    EXPECT_EQ(3, shared->size());
+  }
+
+  EXPECT_TRUE(value.expired());
+  EXPECT_FALSE(observer.expired());
+  value.reset();
+  EXPECT_TRUE(observer.expired());
+}
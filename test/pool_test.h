@@ -0,0 +1,37 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___POOL_TEST___
+#define ___POOL_TEST___
+#include <gtest/gtest.h>
+#include <memory>
+#include "pool.h"
+
+using namespace mp;
+using namespace std;
+
+class ObjectPool : public ::testing::Test {
+  protected:
+    ObjectPool() {
+      storage = make_shared<pool>( 256 );
+    }
+
+    ~ObjectPool() {}
+
+    shared_ptr<pool> storage;
+};
+#endif
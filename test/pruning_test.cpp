@@ -0,0 +1,242 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "pruning_test.h"
+
+TEST_F(MagnitudePruning, SmallestFactorsOfEachLayerAreRemoved) {
+  network net(1, 4, 2);
+  prepare( net, 3 );
+  auto before = net.weights();
+
+  EXPECT_EQ(6U + 4U, pruner().prune( net, 0.5 ));
+  auto after = net.weights();
+
+  // Layer 0 has 12 factors and 4 biases, layer 1 has 8 factors and 2 biases
+  vector<pair<unsigned int, unsigned int>> layers = { {0, 12}, {16, 8} };
+  for( auto &l : layers ) {
+    double smallest_kept = INFINITY, biggest_removed = 0.0;
+    for(unsigned int i = l.first; i < l.first + l.second; i++) {
+      if( after[i] == 0.0 ) biggest_removed = max( biggest_removed, fabs( before[i] ) );
+      else smallest_kept = min( smallest_kept, fabs( after[i] ) );
+    }
+
+    EXPECT_LE(biggest_removed, smallest_kept);
+  }
+
+  // The biases are kept
+  for( auto i : { 12U, 13U, 14U, 15U, 24U, 25U } ) EXPECT_EQ(before[i], after[i]);
+  EXPECT_EQ(10U, zeros( net ));
+}
+
+TEST_F(MagnitudePruning, SparseCopyGivesTheSameOutputs) {
+  network net(2, 6, 3);
+  prepare( net, 5 );
+  net.activation( 1, activation_kind::hyperbolic_tangent );
+  net.output_stage( stage::softmax );
+  net.neuron(1, 2).lock()->disable_bias();
+  pruner().prune( net, 0.7 );
+  net.compile( 5 );
+
+  // Copying the factors leaves the network compiled
+  sparse_network sparse( net );
+  EXPECT_TRUE(net.compiled());
+  EXPECT_EQ(3U, sparse.layers());
+  EXPECT_EQ(5U, sparse.inputs());
+  EXPECT_EQ(3U, sparse.outputs());
+  EXPECT_EQ(30U + 36U + 18U, sparse.factors());
+  EXPECT_EQ(sparse.factors() - zeros( net ), sparse.nonzeros());
+  EXPECT_EQ(sparse.layer( 0 ).offsets.back(), sparse.layer( 0 ).values.size());
+
+  for(unsigned int s = 0; s < 20; s++) {
+    vector<double> inputs( 5 );
+    for(unsigned int i = 0; i < 5; i++) inputs[i] = cos( 0.7 * s + i );
+
+    EXPECT_EQ(net.output( inputs ), sparse.output( inputs ));
+  }
+
+  EXPECT_THROW(sparse.output( vector<double>( 4, 0.0 ) ), invalid_argument);
+}
+
+TEST_F(MagnitudePruning, WrongSettingsAreRejected) {
+  network net(1, 4, 1);
+  prepare( net, 2 );
+
+  EXPECT_THROW(pruner().prune( net, 1.5 ), invalid_argument);
+  EXPECT_THROW(pruner().prune( net, -0.1 ), invalid_argument);
+
+  net.weight_storage( storage::half );
+  EXPECT_THROW(sparse_network sparse( net ), invalid_argument);
+  net.weight_storage( storage::float64 );
+
+  net.neuron(0, 1, make_shared<mp::neuron::rbf>( 2, true ));
+  EXPECT_THROW(sparse_network sparse( net ), invalid_argument);
+}
+
+TEST_F(MagnitudePruning, FineTuningKeepsThePrunedFactors) {
+  network net(1, 8, 3);
+  prepare( net, dat.inputs_length() );
+
+  trainer t;
+  t.epochs( 20 );
+  t.train( net, dat );
+  double trained = evaluator().evaluate( net, dat ).accuracy;
+
+  pruner p;
+  p.fine_tuning( 5, t );
+  EXPECT_EQ(5U, p.iterations());
+
+  auto pruned = p.prune( net, 0.5, dat );
+  EXPECT_EQ(pruned, zeros( net ));
+  EXPECT_GE(evaluator().evaluate( net, dat ).accuracy, trained - 0.1);
+}
+
+TEST_F(MagnitudePruning, SweepReportsEachLevel) {
+  network net(1, 16, 3);
+  prepare( net, dat.inputs_length() );
+
+  trainer t;
+  t.epochs( 20 );
+  t.train( net, dat );
+  auto weights = net.weights();
+
+  pruner p;
+  p.repeats( 2 );
+  auto report = p.sweep( net, { 0.0, 0.5, 0.9 }, dat );
+
+  EXPECT_EQ(weights, net.weights());
+  EXPECT_EQ(evaluator().evaluate( net, dat ).accuracy, report.accuracy);
+  EXPECT_EQ(16U * 2 + 3 * 16, report.factors);
+  ASSERT_EQ(3U, report.levels.size());
+
+  EXPECT_EQ(0.0, report.levels[0].accuracy_change);
+  EXPECT_EQ(report.factors, report.levels[0].nonzeros);
+  EXPECT_EQ(16U + 24U, report.levels[1].nonzeros);
+  EXPECT_NEAR(0.9, report.levels[2].sparsity, 0.01);
+
+  for( auto &level : report.levels ) {
+    EXPECT_GT(level.dense_seconds, 0.0);
+    EXPECT_GT(level.speedup, 0.0);
+    EXPECT_EQ(level.accuracy - report.accuracy, level.accuracy_change);
+  }
+}
+
+TEST_F(MagnitudePruning, SweepKeepsTheOptimizerOfTheNetwork) {
+  network net(1, 8, 3);
+  prepare( net, dat.inputs_length() );
+  auto opt = make_shared<mp::optimizer::sgd>( 0.3, 0.5 );
+  net.optimizer( opt );
+
+  trainer t;
+  t.epochs( 2 );
+  pruner p;
+  p.repeats( 1 );
+  p.fine_tuning( 3, t );
+  auto first = p.sweep( net, { 0.5 }, dat, dat );
+  auto second = p.sweep( net, { 0.5 }, dat, dat );
+
+  // Each copy is tuned by its own optimizer, so the levels do not depend on each other
+  EXPECT_EQ(opt, net.optimizer());
+  EXPECT_THROW(opt->steps( 0 ), out_of_range);
+  EXPECT_EQ(0.3, opt->learning_rate());
+  EXPECT_EQ(first.levels[0].accuracy, second.levels[0].accuracy);
+}
+
+TEST_F(MagnitudePruning, IgnoredNeuronsAreRemovedFirst) {
+  network net(1, 6, 3);
+  prepare( net, dat.inputs_length() );
+
+  // The output layer ignores the neuron 4
+  for(unsigned int j = 0; j < 3; j++) net.neuron(1, j).lock()->set_factor(4, 0.0);
+
+  pruner p;
+  auto scores = p.contributions( net, dat );
+  ASSERT_EQ(1U, scores.size());
+  ASSERT_EQ(6U, scores[0].size());
+  EXPECT_EQ(0.0, scores[0][4]);
+  for(unsigned int j = 0; j < 6; j++) {
+    if( j == 4 ) continue;
+    EXPECT_GT(scores[0][j], 0.0);
+  }
+
+  vector<vector<double>> before;
+  for(unsigned int s = 0; s < dat.elements(); s++) {
+    before.push_back( net.output( *(dat.input( s ).lock()) ) );
+  }
+
+  EXPECT_EQ(0U, p.remove_neurons( net, 0.0, dat ));
+  EXPECT_EQ(1U, p.remove_neurons( net, 1.0 / 6, dat ));
+  EXPECT_EQ(5U, net.layer_size( 0 ));
+  EXPECT_EQ(5U, net.layer_inputs( 1 ));
+
+  for(unsigned int s = 0; s < dat.elements(); s++) {
+    EXPECT_EQ(before[s], net.output( *(dat.input( s ).lock()) ));
+  }
+
+  EXPECT_THROW(p.remove_neurons( net, 1.5, dat ), invalid_argument);
+  EXPECT_EQ(4U, p.remove_neurons( net, 1.0, dat ));
+  EXPECT_EQ(1U, net.layer_size( 0 ));
+}
+
+TEST_F(MagnitudePruning, ContributionsKeepTheNetworkCompiled) {
+  network net(1, 6, 3);
+  prepare( net, dat.inputs_length() );
+  net.compile( dat.inputs_length() );
+  net.backpropagate( *(dat.input( 0 ).lock()), *(dat.output( 0 ).lock()) );
+
+  pruner p;
+  auto scores = p.contributions( net, dat );
+  EXPECT_TRUE(net.compiled());
+
+  // The same scores once the trained factors are back in the neurons
+  network editable( net );
+  editable.neuron(0, 0);
+  EXPECT_FALSE(editable.compiled());
+  EXPECT_EQ(scores, p.contributions( editable, dat ));
+}
+
+TEST_F(MagnitudePruning, CompactionReportsEachFraction) {
+  network net(1, 32, 3);
+  prepare( net, dat.inputs_length() );
+
+  trainer t;
+  t.epochs( 20 );
+  t.train( net, dat );
+  auto weights = net.weights();
+  auto steps = net.optimizer()->steps( 0 );
+
+  pruner p;
+  p.repeats( 2 );
+  p.fine_tuning( 3, t );
+  auto report = p.compact( net, { 0.0, 0.5, 0.75 }, dat, dat );
+
+  EXPECT_EQ(weights, net.weights());
+  EXPECT_EQ(steps, net.optimizer()->steps( 0 ));
+  EXPECT_EQ(32U * 3 + 3 * 33, report.parameters);
+  ASSERT_EQ(3U, report.levels.size());
+
+  EXPECT_EQ(vector<unsigned int>({ 32, 3 }), report.levels[0].sizes);
+  EXPECT_EQ(vector<unsigned int>({ 16, 3 }), report.levels[1].sizes);
+  EXPECT_EQ(vector<unsigned int>({ 8, 3 }), report.levels[2].sizes);
+  EXPECT_EQ(8U * 3 + 3 * 9, report.levels[2].parameters);
+
+  for( auto &level : report.levels ) {
+    EXPECT_GT(level.seconds, 0.0);
+    EXPECT_GT(level.speedup, 0.0);
+    EXPECT_EQ(level.accuracy - report.accuracy, level.accuracy_change);
+    EXPECT_GT(level.accuracy, 0.8);
+  }
+}
@@ -0,0 +1,61 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___PRUNING_TEST___
+#define ___PRUNING_TEST___
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "pruning.h"
+#include "evaluation.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class MagnitudePruning : public ::testing::Test {
+  protected:
+    MagnitudePruning() {
+      dat.reload( "db/test_blobs.dat" );
+    }
+
+    ~MagnitudePruning() {}
+
+    // It connects a network to the given inputs, with enabled biases and He weights
+    void prepare(network &target, const unsigned int &inputs) {
+      connect( target, inputs, scheme::he, 8 );
+      target.activation( 0, activation_kind::relu );
+    }
+
+    // It counts the factors that are zero, biases excluded
+    unsigned int zeros(const network &net) {
+      auto weights = net.weights();
+      unsigned int result = 0, position = 0;
+
+      for(unsigned int i = 0; i < net.layers(); i++) {
+        unsigned int factors = net.layer_size( i ) * net.layer_inputs( i );
+        result += count( weights.begin() + position, weights.begin() + position + factors, 0.0 );
+        position += factors + net.layer_size( i );
+      }
+
+      return result;
+    }
+
+    data dat;
+};
+#endif
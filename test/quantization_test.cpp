@@ -0,0 +1,153 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "quantization_test.h"
+
+TEST_F(ReducedPrecision, ConversionsRoundToNearestEven) {
+  EXPECT_EQ(0x3f80, kernels::to_bfloat16( 1.0 ));
+  EXPECT_EQ(0xc020, kernels::to_bfloat16( -2.5 ));
+  // Halfway between two bfloat16, to the even one
+  EXPECT_EQ(0x3f80, kernels::to_bfloat16( 1.0 + ldexp( 1.0, -8 ) ));
+  EXPECT_EQ(0x3f82, kernels::to_bfloat16( 1.0 + 3 * ldexp( 1.0, -8 ) ));
+  EXPECT_EQ(0x7f80, kernels::to_bfloat16( numeric_limits<double>::infinity() ));
+  EXPECT_TRUE(isnan( kernels::from_bfloat16( kernels::to_bfloat16( nan( "" ) ) ) ));
+
+  EXPECT_EQ(0x3c00, kernels::to_half( 1.0 ));
+  EXPECT_EQ(0x8000, kernels::to_half( -0.0 ));
+  EXPECT_EQ(0x3c00, kernels::to_half( 1.0 + ldexp( 1.0, -11 ) ));
+  EXPECT_EQ(0x3c02, kernels::to_half( 1.0 + 3 * ldexp( 1.0, -11 ) ));
+  EXPECT_EQ(0x7bff, kernels::to_half( 65519.0 ));
+  EXPECT_EQ(0x7c00, kernels::to_half( 65520.0 ));
+  EXPECT_EQ(0xfc00, kernels::to_half( -1e10 ));
+  EXPECT_EQ(0x0001, kernels::to_half( ldexp( 1.0, -24 ) ));
+  EXPECT_EQ(0x0000, kernels::to_half( ldexp( 1.0, -25 ) ));
+  EXPECT_EQ(0x0002, kernels::to_half( 3 * ldexp( 1.0, -25 ) ));
+  EXPECT_EQ(0x0400, kernels::to_half( ldexp( 1.0, -14 ) ));
+  EXPECT_FLOAT_EQ(65504.0f, kernels::from_half( 0x7bff ));
+  EXPECT_TRUE(isnan( kernels::from_half( kernels::to_half( nan( "" ) ) ) ));
+
+  // Every value of both formats goes back to the same bits
+  for(unsigned int bits = 0; bits < 0x10000; bits++) {
+    uint16_t value = bits;
+
+    if( not isnan( kernels::from_half( value ) ) ) {
+      EXPECT_EQ(value, kernels::to_half( kernels::from_half( value ) )) << hex << bits;
+    }
+
+    if( not isnan( kernels::from_bfloat16( value ) ) ) {
+      EXPECT_EQ(value, kernels::to_bfloat16( kernels::from_bfloat16( value ) )) << hex << bits;
+    }
+  }
+}
+
+TEST_F(ReducedPrecision, ReducedKernelWidensTheFactors) {
+  // 19 columns: two blocks of eight and a tail
+  const unsigned int rows = 5, columns = 19, batch = 3;
+  vector<double> weights( rows * columns ), bias( rows ), inputs( batch * columns );
+  for(unsigned int i = 0; i < weights.size(); i++) weights[i] = sin( 1.0 + 3 * i );
+  for(unsigned int i = 0; i < bias.size(); i++) bias[i] = 0.1 * i - 0.2;
+  for(unsigned int i = 0; i < inputs.size(); i++) inputs[i] = cos( 0.5 * i );
+
+  for( auto format : { storage::bfloat16, storage::half } ) {
+    vector<uint16_t> reduced( weights.size() );
+    vector<double> outputs( batch * rows );
+    vector<float> widened( columns );
+    kernels::reduce(weights.data(), reduced.data(), weights.size(), format);
+    kernels::forward_reduced(reduced.data(), format, bias.data(), inputs.data(), outputs.data(),
+                             rows, columns, batch, widened.data());
+
+    for(unsigned int s = 0; s < batch; s++) {
+      for(unsigned int r = 0; r < rows; r++) {
+        double expected = bias[r];
+        double exact = bias[r];
+
+        for(unsigned int c = 0; c < columns; c++) {
+          uint16_t bits = reduced[r * columns + c];
+          double factor = ( format == storage::bfloat16 ) ? kernels::from_bfloat16( bits ) :
+                                                            kernels::from_half( bits );
+          expected += factor * static_cast<float>( inputs[s * columns + c] );
+          exact += weights[r * columns + c] * inputs[s * columns + c];
+        }
+
+        // Float sums of the rounded factors, not far from the double ones
+        EXPECT_NEAR(expected, outputs[s * rows + r], 1e-5);
+        EXPECT_NEAR(exact, outputs[s * rows + r], format == storage::half ? 1e-2 : 1e-1);
+      }
+    }
+  }
+}
+
+TEST_F(ReducedPrecision, ReportComparesEachStorage) {
+  network net(1, 24, 3);
+  prepare( net, dat.inputs_length() );
+
+  trainer t;
+  t.epochs( 20 );
+  t.train( net, dat );
+  auto weights = net.weights();
+
+  quantizer q;
+  q.repeats( 2 );
+  EXPECT_EQ(2U, q.repeats());
+
+  auto report = q.compare( net, { storage::float64, storage::bfloat16, storage::half }, dat );
+  EXPECT_EQ(weights, net.weights());
+  EXPECT_EQ(storage::float64, net.weight_storage());
+  EXPECT_EQ(8U * (24 * 2 + 3 * 24), report.bytes);
+  EXPECT_GT(report.accuracy, 0.9);
+  ASSERT_EQ(3U, report.levels.size());
+
+  EXPECT_EQ(report.bytes, report.levels[0].bytes);
+  EXPECT_EQ(0.0, report.levels[0].max_error);
+  EXPECT_EQ(report.bytes / 4, report.levels[1].bytes);
+  EXPECT_EQ(report.bytes / 4, report.levels[2].bytes);
+
+  // bfloat16 keeps 8 bits of mantissa and half 11, so it is the one further from double
+  EXPECT_GT(report.levels[1].max_error, report.levels[2].max_error);
+  EXPECT_GT(report.levels[2].max_error, 0.0);
+  EXPECT_LE(report.levels[2].mean_error, report.levels[2].max_error);
+
+  for( auto &level : report.levels ) {
+    EXPECT_GT(level.seconds, 0.0);
+    EXPECT_GT(level.speedup, 0.0);
+    EXPECT_EQ(level.accuracy - report.accuracy, level.accuracy_change);
+    EXPECT_GT(level.accuracy_change, -0.05);
+  }
+}
+
+TEST_F(ReducedPrecision, TrainingRunsTheReducedForwardPass) {
+  network net(1, 24, 3);
+  prepare( net, dat.inputs_length() );
+
+  trainer t;
+  t.epochs( 10 );
+
+  quantizer q;
+  q.repeats( 1 );
+  auto report = q.compare( net, { storage::bfloat16, storage::half }, t, dat, dat );
+  EXPECT_GT(report.accuracy, 0.9);
+  ASSERT_EQ(2U, report.levels.size());
+
+  for( auto &level : report.levels ) {
+    EXPECT_GT(level.max_error, 0.0);
+    EXPECT_GT(level.accuracy_change, -0.05);
+  }
+
+  // Every copy was trained by its own optimizer
+  EXPECT_EQ(0.9, net.optimizer()->learning_rate());
+  EXPECT_THROW(net.optimizer()->steps( 0 ), out_of_range);
+}
@@ -0,0 +1,46 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef ___QUANTIZATION_TEST___
+#define ___QUANTIZATION_TEST___
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include "quantization.h"
+#include "fixtures.h"
+
+using namespace mp;
+using namespace std;
+
+class ReducedPrecision : public ::testing::Test {
+  protected:
+    ReducedPrecision() {
+      dat.reload( "db/test_blobs.dat" );
+    }
+
+    ~ReducedPrecision() {}
+
+    // It connects a network to the given inputs, with enabled biases and He weights
+    void prepare(network &target, const unsigned int &inputs) {
+      connect( target, inputs, scheme::he, 8 );
+      target.activation( 0, activation_kind::relu );
+    }
+
+    data dat;
+};
+#endif
@@ -0,0 +1,68 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "schedule_test.h"
+#include <cmath>
+
+TEST_F(LearningSchedule, Constant) {
+  schedule::constant s(0.3);
+  EXPECT_EQ(0.3, s.rate(0));
+  EXPECT_EQ(0.3, s.rate(1000));
+}
+
+TEST_F(LearningSchedule, StepDropsEveryGivenEpochs) {
+  schedule::step s(1.0, 0.5, 10);
+  EXPECT_EQ(1.0, s.rate(0));
+  EXPECT_EQ(1.0, s.rate(9));
+  EXPECT_EQ(0.5, s.rate(10));
+  EXPECT_EQ(0.25, s.rate(25));
+}
+
+TEST_F(LearningSchedule, ExponentialDecays) {
+  schedule::exponential s(2.0, 0.9);
+  EXPECT_DOUBLE_EQ(2.0, s.rate(0));
+  EXPECT_DOUBLE_EQ(2.0 * pow(0.9, 7), s.rate(7));
+}
+
+TEST_F(LearningSchedule, CosineGoesFromLearningToMinimum) {
+  schedule::cosine s(1.0, 0.1, 10);
+  EXPECT_DOUBLE_EQ(1.0, s.rate(0));
+  EXPECT_DOUBLE_EQ(0.55, s.rate(5));
+  EXPECT_DOUBLE_EQ(0.1, s.rate(10));
+  EXPECT_DOUBLE_EQ(0.1, s.rate(50));
+
+  for(unsigned int i = 1; i <= 10; i++) {
+    ASSERT_LT(s.rate(i), s.rate(i - 1));
+  }
+}
+
+TEST_F(LearningSchedule, WarmupRampsUpToTheWrappedSchedule) {
+  schedule::warmup s(3, make_shared<schedule::step>(0.8, 0.5, 2));
+  EXPECT_DOUBLE_EQ(0.2, s.rate(0));
+  EXPECT_DOUBLE_EQ(0.4, s.rate(1));
+  EXPECT_DOUBLE_EQ(0.6, s.rate(2));
+  EXPECT_DOUBLE_EQ(0.8, s.rate(3));
+  EXPECT_DOUBLE_EQ(0.8, s.rate(4));
+  EXPECT_DOUBLE_EQ(0.4, s.rate(5));
+}
+
+TEST_F(LearningSchedule, ShiftedStartsAtTheOffset) {
+  schedule::shifted s(4, make_shared<schedule::step>(0.8, 0.5, 2));
+  EXPECT_DOUBLE_EQ(0.2, s.rate(0));
+  EXPECT_DOUBLE_EQ(0.2, s.rate(1));
+  EXPECT_DOUBLE_EQ(0.1, s.rate(2));
+}
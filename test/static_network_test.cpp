@@ -0,0 +1,93 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "static_network_test.h"
+
+TEST_F(FixedTopology, ShapesAreConstantExpressions) {
+  using shape = static_network<8, 16, 12, 3>;
+
+  static_assert( shape::inputs() == 8, "inputs" );
+  static_assert( shape::layers() == 3, "layers" );
+  static_assert( shape::layer_size( 1 ) == 12, "layer size" );
+  static_assert( shape::outputs() == 3, "outputs" );
+  static_assert( shape::parameters() == 16 * 9 + 12 * 17 + 3 * 13, "parameters" );
+
+  SUCCEED();
+}
+
+TEST_F(FixedTopology, TrainedXorGivesTheSameOutputs) {
+  network net(1, 4, 1);
+  configure( net, 2 );
+
+  trainer t;
+  t.epochs( 50 );
+  t.train( net, dat );
+
+  static_network<2, 4, 1> fixed( net );
+  EXPECT_EQ(net.weights(), vector<double>( fixed.weights().begin(), fixed.weights().end() ));
+
+  for(unsigned int i = 0; i < dat.elements(); i++) {
+    auto inputs = *(dat.input( i ).lock());
+    auto result = fixed.output( { inputs[0], inputs[1] } );
+    EXPECT_EQ(net.output( inputs )[0], result[0]);
+  }
+}
+
+TEST_F(FixedTopology, ActivationsAndSoftmaxGiveTheSameOutputs) {
+  network net(2, 6, 3);
+  configure( net, 5 );
+  net.activation( 0, activation_kind::relu );
+  net.activation( 1, activation_kind::hyperbolic_tangent );
+  net.output_stage( stage::softmax );
+  net.neuron(1, 2).lock()->disable_bias();
+  net.compile( 5 );
+
+  // Copying the factors leaves the network compiled
+  static_network<5, 6, 6, 3> fixed( net );
+  EXPECT_TRUE(net.compiled());
+  EXPECT_EQ(activation_kind::relu, fixed.activation( 0 ));
+  EXPECT_EQ(stage::softmax, fixed.output_stage());
+
+  for(unsigned int s = 0; s < 20; s++) {
+    array<double, 5> inputs;
+    for(unsigned int i = 0; i < 5; i++) inputs[i] = cos( 0.7 * s + i );
+
+    auto expected = net.output( vector<double>( inputs.begin(), inputs.end() ) );
+    auto result = fixed.output( inputs );
+    EXPECT_EQ(expected, vector<double>( result.begin(), result.end() ));
+  }
+}
+
+TEST_F(FixedTopology, OtherTopologiesAreRejected) {
+  network net(1, 4, 1);
+  configure( net, 2 );
+
+  EXPECT_THROW(( static_network<2, 5, 1>( net ) ), invalid_argument);
+  EXPECT_THROW(( static_network<3, 4, 1>( net ) ), invalid_argument);
+  EXPECT_THROW(( static_network<2, 4, 4, 1>( net ) ), invalid_argument);
+}
+
+TEST_F(FixedTopology, ReducedStorageIsRejected) {
+  network net(1, 4, 1);
+  configure( net, 2 );
+
+  net.weight_storage( storage::half );
+  EXPECT_THROW(( static_network<2, 4, 1>( net ) ), invalid_argument);
+
+  net.weight_storage( storage::float64 );
+  EXPECT_NO_THROW(( static_network<2, 4, 1>( net ) ));
+}
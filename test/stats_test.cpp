@@ -0,0 +1,106 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "stats_test.h"
+
+TEST_F(StatsCounters, StartAtZero) {
+  ASSERT_EQ(3, counters.layers());
+
+  for(unsigned int i = 0; i < counters.layers(); i++) {
+    for(unsigned int p = 0; p < phases_count; p++) {
+      auto c = counters.at(i, static_cast<phase>( p ));
+      ASSERT_EQ(0, c.calls);
+      ASSERT_EQ(0, c.seconds);
+      ASSERT_EQ(0, c.flops);
+      ASSERT_EQ(0, c.bytes);
+    }
+  }
+}
+
+TEST_F(StatsCounters, RecordAccumulates) {
+  counters.record(1, phase::forward, 0.5, 10, 80);
+  counters.record(1, phase::forward, 0.25, 10, 80);
+  counters.record(2, phase::forward, 1, 1, 8);
+  counters.record(1, phase::adjust_weights, 2, 3, 4);
+
+  auto c = counters.at(1, phase::forward);
+  EXPECT_EQ(2, c.calls);
+  EXPECT_EQ(0.75, c.seconds);
+  EXPECT_EQ(20, c.flops);
+  EXPECT_EQ(160, c.bytes);
+
+  auto forward = counters.total(phase::forward);
+  EXPECT_EQ(3, forward.calls);
+  EXPECT_EQ(21, forward.flops);
+
+  auto layer = counters.total(1);
+  EXPECT_EQ(3, layer.calls);
+  EXPECT_EQ(23, layer.flops);
+}
+
+TEST_F(StatsCounters, SnapshotIsIndependent) {
+  counters.record(0, phase::hidden_deltas, 1, 1, 1);
+  stats snapshot = counters;
+  counters.record(0, phase::hidden_deltas, 1, 1, 1);
+
+  EXPECT_EQ(1, snapshot.at(0, phase::hidden_deltas).calls);
+  EXPECT_EQ(2, counters.at(0, phase::hidden_deltas).calls);
+}
+
+TEST_F(StatsCounters, ResetKeepsLayers) {
+  counters.record(2, phase::neuron_factors, 1, 1, 1);
+  counters.reset();
+
+  EXPECT_EQ(3, counters.layers());
+  EXPECT_EQ(0, counters.at(2, phase::neuron_factors).calls);
+}
+
+TEST_F(StatsCounters, ScopesCanNest) {
+  {
+    MP_STATS_SCOPE(counters, 0, phase::forward, 1, 8);
+    MP_STATS_SCOPE(counters, 1, phase::forward, 2, 16);
+  }
+
+  EXPECT_EQ(stats::enabled() ? 1U : 0U, counters.at(0, phase::forward).calls);
+  EXPECT_EQ(stats::enabled() ? 1U : 0U, counters.at(1, phase::forward).calls);
+}
+
+TEST_F(NetworkStats, BackpropagateRecordsEveryPhase) {
+  net.backpropagate(inputs, expected);
+  auto s = net.statistics();
+
+  ASSERT_EQ(net.layers(), s.layers());
+  ASSERT_EQ(stats::enabled(), s.total(phase::forward).calls == net.layers());
+  ASSERT_EQ(stats::enabled(), s.total(phase::output_deltas).calls == 1);
+  ASSERT_EQ(stats::enabled(), s.total(phase::hidden_deltas).calls == net.layers() - 1);
+  ASSERT_EQ(stats::enabled(), s.total(phase::neuron_factors).calls == net.layers());
+  ASSERT_EQ(stats::enabled(), s.total(phase::adjust_weights).calls == net.layers());
+
+  if( stats::enabled() ) {
+    EXPECT_EQ(2 * 3 * 2 + 4 * 3, s.at(0, phase::forward).flops);
+  }
+}
+
+TEST_F(NetworkStats, ResetStatistics) {
+  net.backpropagate(inputs, expected);
+  net.reset_statistics();
+  auto s = net.statistics();
+
+  for(unsigned int p = 0; p < phases_count; p++) {
+    ASSERT_EQ(0, s.total(static_cast<phase>( p )).calls);
+  }
+}
@@ -0,0 +1,85 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "thread_pool_test.h"
+
+TEST_F(WorkStealing, EveryTaskRuns) {
+  thread_pool workers( 4 );
+  atomic<unsigned int> done( 0 );
+
+  for(unsigned int i = 0; i < 1000; i++) {
+    workers.submit( [&done] { done++; } );
+  }
+
+  workers.wait();
+  EXPECT_EQ(4, workers.threads());
+  EXPECT_EQ(1000, done.load());
+}
+
+TEST_F(WorkStealing, IdleWorkersStealTasks) {
+  thread_pool workers( 2 );
+  atomic<unsigned int> done( 0 );
+
+  // The tasks dealt to the first worker are slow, so the second one takes some of them
+  for(unsigned int i = 0; i < 40; i++) {
+    workers.submit( [&done, i] {
+      if( i % 2 == 0 ) this_thread::sleep_for( chrono::milliseconds( 2 ) );
+      done++;
+    } );
+  }
+
+  workers.wait();
+  EXPECT_EQ(40, done.load());
+  EXPECT_LT(0, workers.steals());
+}
+
+TEST_F(WorkStealing, WaitRethrowsTheFirstError) {
+  thread_pool workers( 3 );
+  atomic<unsigned int> done( 0 );
+
+  workers.submit( [] { throw invalid_argument( "failed task" ); } );
+  for(unsigned int i = 0; i < 10; i++) {
+    workers.submit( [&done] { done++; } );
+  }
+
+  EXPECT_THROW(workers.wait(), invalid_argument);
+  EXPECT_EQ(10, done.load());
+
+  // The error is reported once, and the pool can still be used
+  workers.submit( [&done] { done++; } );
+  EXPECT_NO_THROW(workers.wait());
+  EXPECT_EQ(11, done.load());
+}
+
+TEST_F(WorkStealing, TasksCanSubmitTasks) {
+  thread_pool workers( 3 );
+  atomic<unsigned int> done( 0 );
+
+  // The workers park between the rounds, so every nested task has to wake one of them
+  for(unsigned int round = 0; round < 20; round++) {
+    for(unsigned int i = 0; i < 5; i++) {
+      workers.submit( [&workers, &done] {
+        workers.submit( [&done] { done++; } );
+        done++;
+      } );
+    }
+
+    workers.wait();
+  }
+
+  EXPECT_EQ(200, done.load());
+}
@@ -0,0 +1,135 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "trainer_test.h"
+
+TEST_F(TrainingLoop, RunsTheGivenEpochs) {
+  trainer t;
+  t.epochs( 20 );
+
+  auto report = t.train( net, dat );
+  EXPECT_EQ(20, report.epochs);
+  EXPECT_EQ(20, report.history.size());
+  EXPECT_FALSE(report.stopped_early);
+}
+
+TEST_F(TrainingLoop, ScheduleDrivesTheOptimizer) {
+  trainer t;
+  t.epochs( 6 );
+  t.schedule( make_shared<schedule::step>(0.5, 0.5, 2) );
+
+  auto report = t.train( net, dat );
+  EXPECT_DOUBLE_EQ(0.5, report.history[1].learning_rate);
+  EXPECT_DOUBLE_EQ(0.25, report.history[2].learning_rate);
+  EXPECT_DOUBLE_EQ(0.125, report.history[5].learning_rate);
+  EXPECT_DOUBLE_EQ(0.125, net.optimizer()->learning_rate());
+}
+
+TEST_F(TrainingLoop, EarlyStoppingWaitsPatienceEpochs) {
+  trainer t;
+  t.epochs( 1000 );
+  // Nothing can improve by more than 10, so it stops after the patience
+  t.early_stopping( 4, 10, criterion::mse );
+
+  auto report = t.train( net, dat );
+  EXPECT_TRUE(report.stopped_early);
+  EXPECT_EQ(6, report.epochs);
+  EXPECT_EQ(0, report.best_epoch);
+}
+
+TEST_F(TrainingLoop, BestWeightsAreRestored) {
+  net.optimizer( make_shared<optimizer::adam>(0.05) );
+
+  trainer t;
+  t.epochs( 300 );
+  t.shuffle( 3 );
+  t.early_stopping( 10, 0.0, criterion::mse );
+
+  auto report = t.train( net, dat );
+  auto restored = evaluator().evaluate( net, dat );
+
+  ASSERT_LT(report.best_epoch, report.epochs);
+  EXPECT_DOUBLE_EQ(report.history[report.best_epoch].validation.mse, restored.mse);
+  EXPECT_DOUBLE_EQ(report.best_score, restored.mse);
+  EXPECT_LT(restored.mse, report.history[0].validation.mse);
+}
+
+TEST_F(TrainingLoop, ShuffleIsReproducible) {
+  network other = network(1, 4, 1);
+  configure( other );
+
+  trainer t;
+  t.epochs( 10 );
+  t.shuffle( 42 );
+
+  t.train( net, dat );
+  t.train( other, dat );
+  EXPECT_EQ(net.weights(), other.weights());
+}
+
+TEST_F(TrainingLoop, MiniBatchesGoThroughBackpropagate) {
+  network deep(4, 4, 1);
+  configure( deep );
+  deep.feed( *(dat.input( 0 ).lock()) );
+  network manual( deep );
+
+  trainer t;
+  t.epochs( 3 );
+  t.batch_size( 3 );
+  t.restore_best( false );
+  t.train( deep, dat );
+  EXPECT_EQ(3, t.batch_size());
+
+  // The four samples go in a mini-batch of three and another one of one
+  for(unsigned int epoch = 0; epoch < 3; epoch++) {
+    for(unsigned int start = 0; start < dat.elements(); start += 3) {
+      vector<const vector<double> *> inputs, expected;
+      for(unsigned int s = start; ( s < start + 3 ) && ( s < dat.elements() ); s++) {
+        inputs.push_back( dat.input( s ).lock().get() );
+        expected.push_back( dat.output( s ).lock().get() );
+      }
+
+      manual.backpropagate( inputs, expected );
+    }
+  }
+
+  EXPECT_EQ(manual.weights(), deep.weights());
+}
+
+TEST_F(TrainingLoop, PeakMemoryIsReported) {
+  trainer t;
+  t.epochs( 3 );
+
+  auto report = t.train( net, dat );
+  EXPECT_GT(report.peak_memory, 0);
+  EXPECT_EQ(net.activation_memory( 1 ), report.peak_memory);
+
+  // The mini-batch is trained through the checkpoints, which keep fewer activations
+  network deep(6, 4, 1);
+  configure( deep );
+  deep.feed( *(dat.input( 0 ).lock()) );
+  network checkpointed( deep );
+  checkpointed.checkpoint( 3 );
+
+  t.batch_size( 4 );
+  auto full = t.train( deep, dat );
+  auto reduced = t.train( checkpointed, dat );
+  EXPECT_EQ(deep.activation_memory( 4 ), full.peak_memory);
+  EXPECT_EQ(checkpointed.activation_memory( 4 ), reduced.peak_memory);
+  EXPECT_LT(reduced.peak_memory, full.peak_memory);
+  EXPECT_LT(deep.activation_memory( 1 ), full.peak_memory);
+}
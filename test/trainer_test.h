@@ -0,0 +1,52 @@
+//
+//    NeuronNetwork-CPP
+//    Copyright (C) 2015  Pedro José Piquero Plaza <gowikel@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation, either version 3 of the License, or
+//    any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "trainer.h"
+#include "optimizer/adam.h"
+
+using namespace mp;
+using namespace std;
+
+class TrainingLoop : public ::testing::Test {
+  protected:
+    TrainingLoop() {
+      dat.reload( "db/test_xor.dat" );
+      configure( net );
+    }
+
+    ~TrainingLoop() {}
+
+    void configure(network &target) {
+      for(unsigned int i = 0; i < target.layers(); i++) {
+        for(unsigned int j = 0; j < target.layer_size( i ); j++) {
+          auto n = target.neuron(i, j).lock();
+          n->enable_bias();
+          n->resize( i == 0 ? dat.inputs_length() : target.layer_size( i - 1 ) );
+
+          for(unsigned int f = 0; f < n->factors_size(); f++) {
+            n->set_factor(f, sin( 1.0 + i * 5 + j * 3 + f ));
+          }
+        }
+      }
+    }
+
+    data dat;
+    network net = network(1, 4, 1);
+};